@@ -0,0 +1,281 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <stdlib.h>
+#include "ExampleFactorGraphReader.h"
+#include "FactorDense.h"
+#include "FactorSequence.h"
+#include "FactorTree.h"
+#include "FactorHeadAutomaton.h"
+#include "FactorGrandparentHeadAutomaton.h"
+#include "FactorSequenceCompressor.h"
+#include "FactorSequenceBudget.h"
+#include "FactorCompressionBudget.h"
+#include "FactorGeneralTree.h"
+#include "FactorGeneralTreeCounts.h"
+#include "FactorBinaryTree.h"
+#include "FactorBinaryTreeCounts.h"
+
+namespace AD3 {
+
+// Create the factors defined in the examples, from the fields of their line.
+Factor *ExampleFactorGraphReader::ReadCustomFactor(
+    const vector<string> &fields,
+    const vector<BinaryVariable*> &binary_variables,
+    const vector<bool> &negated,
+    FactorGraph *factor_graph) {
+  int offset = 2;
+  int num_links = atoi(fields[1].c_str());
+  Factor *factor;
+  if (fields[0] == "SEQUENCE" ||
+      fields[0] == "SEQUENCE_BUDGET") {
+    bool has_budget = false;
+    if (fields[0] == "SEQUENCE_BUDGET") has_budget = true;
+    // Read the sequence length.
+    int length = atoi(fields[offset+num_links].c_str());
+    // If budget, read the budget.
+    int budget = -1;
+    if (has_budget) {
+      ++offset; // TODO: Make sure this is fine.
+      budget = atoi(fields[offset+num_links].c_str());
+    }
+
+    // Read the number of states for each position in the sequence.
+    vector<int> num_states(length);
+    int total_states = 0;
+    for (int k = 0; k < length; ++k) {
+      num_states[k] = atoi(fields[offset+num_links+1+k].c_str());
+      total_states += num_states[k];
+    }
+
+    // Read the additional log-potentials.
+    vector<double> additional_scores;
+    int index = 0;
+    for (int i = 0; i <= length; ++i) {
+      // If i == 0, the previous state is the start symbol.
+      int num_previous_states = (i > 0)? num_states[i - 1] : 1;
+      // If i == length-1, the previous state is the final symbol.
+      int num_current_states = (i < length)? num_states[i] : 1;
+      for (int j = 0; j < num_previous_states; ++j) {
+        for (int k = 0; k < num_current_states; ++k) {
+          double log_potential = atof(fields[offset+num_links+1+length+index].c_str());
+          additional_scores.push_back(log_potential);
+          ++index;
+        }
+      }
+    }
+    if (fields.size() != offset+num_links+1+length+index) {
+      *log_ << fields.size() << " "
+           << offset+num_links+1+length+index;
+      assert(false);
+    }
+
+    // Create the factor and declare it.
+    if (has_budget) {
+      factor = new FactorSequenceBudget;
+      factor_graph->DeclareFactor(factor, binary_variables, true);
+      static_cast<FactorSequenceBudget*>(factor)->
+        Initialize(num_states, budget);
+      factor->SetAdditionalLogPotentials(additional_scores);
+      *log_ << "Read sequence budget factor." << endl;
+    } else {
+      factor = new FactorSequence;
+      factor_graph->DeclareFactor(factor, binary_variables, true);
+      static_cast<FactorSequence*>(factor)->Initialize(num_states);
+      factor->SetAdditionalLogPotentials(additional_scores);
+      *log_ << "Read sequence factor." << endl;
+    }        
+  } else if (fields[0] == "GENERAL_TREE" ||
+             fields[0] == "GENERAL_TREE_COUNTS") {
+    // Read the number of nodes in the tree.
+    int length = atoi(fields[offset+num_links].c_str());
+
+    // Read the number of states for each node in the tree.
+    vector<int> num_states(length);
+    int total_states = 0;
+    for (int k = 0; k < length; ++k) {
+      num_states[k] = atoi(fields[offset+num_links+1+k].c_str());
+      total_states += num_states[k];
+    }
+
+    // Read the parent node for each node in the tree.
+    vector<int> parents(length);
+    for (int k = 0; k < length; ++k) {
+      parents[k] = atoi(fields[offset+num_links+1+length+k].c_str());
+    }
+
+    // Read the additional log-potentials.
+    vector<double> additional_scores;
+    int index = 0;
+    for (int i = 1; i < length; ++i) {
+      int p = parents[i];
+      int num_previous_states = num_states[p];
+      int num_current_states = num_states[i];
+      for (int k = 0; k < num_previous_states; ++k) {
+        for (int j = 0; j < num_current_states; ++j) {
+          double log_potential = atof(fields[offset+num_links+1+length+length+index].c_str());
+          additional_scores.push_back(log_potential);
+          ++index;
+        }
+      }
+    }
+    if (fields.size() != offset+num_links+1+length+length+index) {
+      *log_ << fields.size() << " "
+           << offset+num_links+1+length+length+index << endl;
+      assert(false);
+    }
+
+    // Create the factor and declare it.
+    if (fields[0] == "GENERAL_TREE") {
+      factor = new FactorGeneralTree;
+      factor_graph->DeclareFactor(factor, binary_variables, true);
+      static_cast<FactorGeneralTree*>(factor)->Initialize(parents, num_states);
+    } else {
+      factor = new FactorGeneralTreeCounts;
+      factor_graph->DeclareFactor(factor, binary_variables, true);
+      static_cast<FactorGeneralTreeCounts*>(factor)->Initialize(parents, num_states);
+    }
+
+    factor->SetAdditionalLogPotentials(additional_scores);
+    if (fields[0] == "GENERAL_TREE") {
+      *log_ << "Read general tree factor." << endl;
+    } else {
+      *log_ << "Read general tree counts factor." << endl;
+    }
+  } else if (fields[0] == "ARBORESCENCE") {
+    // Read the sentence length.
+    int sentence_length = atoi(fields[offset+num_links].c_str());
+    // Read the arcs.
+    vector<Arc*> arcs(binary_variables.size());
+    for (int r = 0; r < binary_variables.size(); ++r) {
+      //*log_ << fields.size() << " " << offset+num_links+2*r+1 << endl;
+      int h = atoi(fields[offset+num_links+1+2*r].c_str());
+      int m = atoi(fields[offset+num_links+1+2*r+1].c_str());
+      Arc *arc = new Arc(h, m);
+      arcs[r] = arc;
+    }
+    factor = new FactorTree;
+    factor_graph->DeclareFactor(factor, binary_variables, true);
+    static_cast<FactorTree*>(factor)->Initialize(sentence_length, arcs);
+    for (int r = 0; r < arcs.size(); ++r) {
+      delete arcs[r];
+    }
+    *log_ << "Read tree factor." << endl;
+  } else if (fields[0] == "HEAD_AUTOMATON") {
+    // Read the length of the automaton.
+    int length = binary_variables.size() + 1;
+    vector<vector<int> > index_siblings(length, vector<int>(length+1, -1));
+    int total = 0;
+    vector<Sibling*> siblings;
+    vector<double> additional_scores;
+    for (int m = 0; m < length; ++m) {
+      for (int s = m+1; s <= length; ++s) {
+        // Create a fake sibling.
+        Sibling *sibling = new Sibling(0, m, s);
+        siblings.push_back(sibling);
+        // Read the sibling log-potential.
+        double log_potential = atof(fields[offset+num_links+total].c_str());
+        additional_scores.push_back(log_potential);
+        ++total;
+      }
+    }
+    factor = new FactorHeadAutomaton;
+    factor_graph->DeclareFactor(factor, binary_variables, true);
+    static_cast<FactorHeadAutomaton*>(factor)->Initialize(length, siblings);
+    for (int r = 0; r < siblings.size(); ++r) {
+      delete siblings[r];
+    }
+    factor->SetAdditionalLogPotentials(additional_scores);
+    *log_ << "Read head automaton factor." << endl;
+  } else if (fields[0] == "SEQUENCE_COMPRESSOR") {
+    // Read the length of the automaton.
+    int length = binary_variables.size();
+    vector<vector<int> > index_siblings(length, vector<int>(length+1, -1));
+    int total = 0;
+    vector<Sibling*> siblings;
+    vector<double> additional_scores;
+    for (int m = 0; m < length; ++m) {
+      for (int s = m+1; s <= length; ++s) {
+        // Create a fake sibling.
+        Sibling *sibling = new Sibling(0, m, s);
+        siblings.push_back(sibling);
+        // Read the sibling log-potential.
+        double log_potential = atof(fields[offset+num_links+total].c_str());
+        additional_scores.push_back(log_potential);
+        ++total;
+      }
+    }
+    factor = new FactorSequenceCompressor;
+    factor_graph->DeclareFactor(factor, binary_variables, true);
+    static_cast<FactorSequenceCompressor*>(factor)->Initialize(length, siblings);
+    for (int r = 0; r < siblings.size(); ++r) {
+      delete siblings[r];
+    }
+    factor->SetAdditionalLogPotentials(additional_scores);
+    *log_ << "Read sequence compressor factor." << endl;
+  } else if (fields[0] == "GRANDPARENT_HEAD_AUTOMATON") {
+    // Read the number of grandparents.
+    int num_grandparents = atoi(fields[offset+num_links].c_str());
+    // Read the length of the automaton.
+    int length = binary_variables.size() + 1 - num_grandparents;
+    vector<vector<int> > index_siblings(length, vector<int>(length+1, -1));
+    int total = 0;
+    vector<Grandparent*> grandparents;
+    vector<double> additional_scores;
+    for (int g = 0; g < num_grandparents; ++g) {
+      for (int m = 1; m < length; ++m) {
+        // Create a fake grandparent.
+        Grandparent *grandparent = new Grandparent(g, 0, m);
+        grandparents.push_back(grandparent);
+        // Read the sibling log-potential.
+        double log_potential = atof(fields[offset+num_links+1+total].c_str());
+        additional_scores.push_back(log_potential);
+        ++total;
+      }
+    }
+    vector<Sibling*> siblings;
+    for (int m = 0; m < length; ++m) {
+      for (int s = m+1; s <= length; ++s) {
+        // Create a fake sibling.
+        Sibling *sibling = new Sibling(0, m, s);
+        siblings.push_back(sibling);
+        // Read the sibling log-potential.
+        double log_potential = atof(fields[offset+num_links+1+total].c_str());
+        additional_scores.push_back(log_potential);
+        ++total;
+      }
+    }
+    factor = new FactorGrandparentHeadAutomaton;
+    factor_graph->DeclareFactor(factor, binary_variables, true);
+    static_cast<FactorGrandparentHeadAutomaton*>(factor)->
+      Initialize(length, num_grandparents, siblings, grandparents);
+    for (int r = 0; r < grandparents.size(); ++r) {
+      delete grandparents[r];
+    }
+    for (int r = 0; r < siblings.size(); ++r) {
+      delete siblings[r];
+    }
+    factor->SetAdditionalLogPotentials(additional_scores);
+    *log_ << "Read grandparent head automaton factor." << endl;
+  } else {
+    return NULL;
+  }
+  return factor;
+}
+
+} // namespace AD3
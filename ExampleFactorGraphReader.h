@@ -0,0 +1,48 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EXAMPLE_FACTOR_GRAPH_READER_H_
+#define EXAMPLE_FACTOR_GRAPH_READER_H_
+
+#include <iostream>
+#include "ad3/FactorGraphReader.h"
+
+namespace AD3 {
+
+// Reader which also creates the factors defined in the examples
+// (sequences, trees, head automata, etc.).
+class ExampleFactorGraphReader : public FactorGraphReader {
+ public:
+  ExampleFactorGraphReader() { log_ = &cout; }
+
+  // Set the stream for the messages about the factors read.
+  void SetLog(ostream *log) { log_ = log; }
+
+ protected:
+  Factor *ReadCustomFactor(const vector<string> &fields,
+                           const vector<BinaryVariable*> &binary_variables,
+                           const vector<bool> &negated,
+                           FactorGraph *factor_graph);
+
+ private:
+  ostream *log_;
+};
+
+} // namespace AD3
+
+#endif // EXAMPLE_FACTOR_GRAPH_READER_H_
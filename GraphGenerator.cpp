@@ -0,0 +1,403 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <math.h>
+#include "GraphGenerator.h"
+
+namespace AD3 {
+
+// Streams of random numbers.
+enum RandomStreams {
+  STREAM_VARIABLES = 0,
+  STREAM_EDGES,
+  STREAM_FACTOR_TYPES,
+  STREAM_FACTOR_VARIABLES,
+  STREAM_FACTOR_NEGATIONS,
+  STREAM_TRUE_LINKS,
+  STREAM_ASSIGNMENT,
+  STREAM_SIBLINGS,
+  STREAM_PARENTS,
+  NUM_STREAMS
+};
+
+enum LogicFactorTypes {
+  LOGIC_OR = 0,
+  LOGIC_IMPLY,
+  LOGIC_XOR,
+  NUM_LOGIC_FACTOR_TYPES
+};
+
+// Sections of a grid in the AD3 or UAI format (see WriteEdges).
+enum GridSections {
+  GRID_FACTORS = 0,
+  GRID_SCOPES,
+  GRID_TABLES
+};
+
+// Finalizer of SplitMix64, which maps consecutive integers to numbers which
+// look independent.
+static uint64_t Mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+uint64_t GraphGenerator::Random(int stream, int64_t index) {
+  uint64_t key = Mix(seed_);
+  key = Mix(key ^ (static_cast<uint64_t>(graph_) * NUM_STREAMS + stream));
+  return Mix(key ^ static_cast<uint64_t>(index));
+}
+
+double GraphGenerator::Uniform(int stream, int64_t index,
+                               double low, double high) {
+  // The 53 upper bits, as a number in [0, 1).
+  double value = (Random(stream, index) >> 11) * (1.0 / 9007199254740992.0);
+  return low + (high - low) * value;
+}
+
+int GraphGenerator::WriteGraph(int graph, FILE *file) {
+  graph_ = graph;
+  num_links_ = 0;
+  int64_t num_variables = GetNumVariables();
+  fprintf(file, "%lld\n%lld\n", static_cast<long long>(num_variables),
+          static_cast<long long>(GetNumFactors()));
+  for (int64_t i = 0; i < num_variables; ++i) {
+    fprintf(file, "%.6g\n", GetVariableLogPotential(i));
+  }
+  WriteFactors(file);
+  return ferror(file)? -1 : 0;
+}
+
+int GraphGenerator::WriteGraphUAI(int graph, FILE *file) {
+  if (!SupportsUAI()) return -1;
+  graph_ = graph;
+  fprintf(file, "MARKOV\n");
+  WriteVariablesUAI(file);
+  WriteScopesUAI(file);
+  WriteTablesUAI(file);
+  return ferror(file)? -1 : 0;
+}
+
+double GridGraphGenerator::GetVariableLogPotential(int64_t i) {
+  return Uniform(STREAM_VARIABLES, i, -0.5, 0.5);
+}
+
+double GridGraphGenerator::GetEdgeLogPotential(int64_t node, bool vertical,
+                                               int neighbour_state,
+                                               int state) {
+  if (potts_) return (neighbour_state == state)? alpha_ : 0.0;
+  int64_t edge = 2 * node + (vertical? 1 : 0);
+  int64_t index = (edge * num_states_ + neighbour_state) * num_states_ +
+    state;
+  return Uniform(STREAM_EDGES, index, -alpha_, alpha_);
+}
+
+void GridGraphGenerator::WriteEdges(int section, FILE *file) {
+  for (int i = 0; i < num_rows_; ++i) {
+    for (int j = 0; j < num_columns_; ++j) {
+      int64_t node = static_cast<int64_t>(i) * num_columns_ + j;
+      // The horizontal edge, then the vertical one.
+      for (int k = 0; k < 2; ++k) {
+        bool vertical = (k == 1);
+        if (!vertical && j == 0) continue;
+        if (vertical && i == 0) continue;
+        int64_t neighbour = vertical? node - num_columns_ : node - 1;
+        if (section == GRID_SCOPES) {
+          fprintf(file, "2 %lld %lld\n", static_cast<long long>(neighbour),
+                  static_cast<long long>(node));
+          continue;
+        }
+        if (section == GRID_FACTORS) {
+          WriteFactorStart("DENSE", 2 * num_states_, file);
+          for (int l = 0; l < num_states_; ++l) {
+            WriteLink(neighbour * num_states_ + l, false, file);
+          }
+          for (int l = 0; l < num_states_; ++l) {
+            WriteLink(node * num_states_ + l, false, file);
+          }
+          fprintf(file, " 2 %d %d", num_states_, num_states_);
+        } else {
+          fprintf(file, "%d\n", num_states_ * num_states_);
+        }
+        for (int l = 0; l < num_states_; ++l) {
+          for (int m = 0; m < num_states_; ++m) {
+            double log_potential =
+              GetEdgeLogPotential(node, vertical, l, m);
+            WriteDouble((section == GRID_FACTORS)?
+                        log_potential : exp(log_potential), file);
+          }
+        }
+        fprintf(file, "\n");
+      }
+    }
+  }
+}
+
+void GridGraphGenerator::WriteFactors(FILE *file) {
+  WriteEdges(GRID_FACTORS, file);
+}
+
+void GridGraphGenerator::WriteVariablesUAI(FILE *file) {
+  int64_t num_nodes = GetNumNodes();
+  fprintf(file, "%lld\n", static_cast<long long>(num_nodes));
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    fprintf(file, (i > 0)? " %d" : "%d", num_states_);
+  }
+  fprintf(file, "\n");
+}
+
+void GridGraphGenerator::WriteScopesUAI(FILE *file) {
+  // A unary factor per node, followed by the edges.
+  int64_t num_nodes = GetNumNodes();
+  fprintf(file, "%lld\n", static_cast<long long>(num_nodes +
+                                                 GetNumFactors()));
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    fprintf(file, "1 %lld\n", static_cast<long long>(i));
+  }
+  WriteEdges(GRID_SCOPES, file);
+}
+
+void GridGraphGenerator::WriteTablesUAI(FILE *file) {
+  int64_t num_nodes = GetNumNodes();
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    fprintf(file, "%d\n", num_states_);
+    for (int l = 0; l < num_states_; ++l) {
+      WriteDouble(exp(GetVariableLogPotential(i * num_states_ + l)), file);
+    }
+    fprintf(file, "\n");
+  }
+  WriteEdges(GRID_TABLES, file);
+}
+
+double LogicGraphGenerator::GetVariableLogPotential(int64_t i) {
+  return Uniform(STREAM_VARIABLES, i, -0.5, 0.5);
+}
+
+int LogicGraphGenerator::GetAssignment(int variable) {
+  return Random(STREAM_ASSIGNMENT, variable) & 1;
+}
+
+int LogicGraphGenerator::GetFactor(int64_t j, vector<int> *variables,
+                                   vector<bool> *negated) {
+  int type = Random(STREAM_FACTOR_TYPES, j) % NUM_LOGIC_FACTOR_TYPES;
+  // Draw distinct variables: a variable already drawn is replaced by the
+  // next one which was not.
+  variables->resize(degree_);
+  for (int k = 0; k < degree_; ++k) {
+    int variable = Random(STREAM_FACTOR_VARIABLES, j * degree_ + k) %
+      num_variables_;
+    while (true) {
+      int l = 0;
+      while (l < k && (*variables)[l] != variable) ++l;
+      if (l == k) break;
+      variable = (variable + 1) % num_variables_;
+    }
+    (*variables)[k] = variable;
+  }
+
+  // Choose the negations so that the assignment satisfies the factor.
+  negated->resize(degree_);
+  int true_link = Random(STREAM_TRUE_LINKS, j) % degree_;
+  if (type == LOGIC_OR) {
+    // Random negations, except for a link which is true.
+    for (int k = 0; k < degree_; ++k) {
+      (*negated)[k] = Random(STREAM_FACTOR_NEGATIONS, j * degree_ + k) & 1;
+    }
+    (*negated)[true_link] = (GetAssignment((*variables)[true_link]) == 0);
+  } else if (type == LOGIC_IMPLY) {
+    // The last variable is implied by the others. If all the others are
+    // true and it is false, it is swapped with the first one.
+    bool antecedents = true;
+    for (int k = 0; k < degree_ - 1; ++k) {
+      if (GetAssignment((*variables)[k]) == 0) antecedents = false;
+    }
+    if (antecedents && GetAssignment((*variables)[degree_ - 1]) == 0) {
+      int variable = (*variables)[0];
+      (*variables)[0] = (*variables)[degree_ - 1];
+      (*variables)[degree_ - 1] = variable;
+    }
+    for (int k = 0; k < degree_; ++k) {
+      (*negated)[k] = (k < degree_ - 1);
+    }
+  } else {
+    // Exactly one link is true.
+    for (int k = 0; k < degree_; ++k) {
+      bool value = (GetAssignment((*variables)[k]) == 1);
+      (*negated)[k] = (k == true_link)? !value : value;
+    }
+  }
+  return type;
+}
+
+void LogicGraphGenerator::WriteFactors(FILE *file) {
+  vector<int> variables;
+  vector<bool> negated;
+  for (int j = 0; j < num_factors_; ++j) {
+    int type = GetFactor(j, &variables, &negated);
+    WriteFactorStart((type == LOGIC_XOR)? "XOR" : "OR", degree_, file);
+    for (int k = 0; k < degree_; ++k) {
+      WriteLink(variables[k], negated[k], file);
+    }
+    fprintf(file, "\n");
+  }
+}
+
+void LogicGraphGenerator::WriteVariablesUAI(FILE *file) {
+  fprintf(file, "%d\n", num_variables_);
+  for (int i = 0; i < num_variables_; ++i) {
+    fprintf(file, (i > 0)? " 2" : "2");
+  }
+  fprintf(file, "\n");
+}
+
+void LogicGraphGenerator::WriteScopesUAI(FILE *file) {
+  // A unary factor per variable, followed by the logic factors.
+  fprintf(file, "%d\n", num_variables_ + num_factors_);
+  for (int i = 0; i < num_variables_; ++i) {
+    fprintf(file, "1 %d\n", i);
+  }
+  vector<int> variables;
+  vector<bool> negated;
+  for (int j = 0; j < num_factors_; ++j) {
+    GetFactor(j, &variables, &negated);
+    fprintf(file, "%d", degree_);
+    for (int k = 0; k < degree_; ++k) {
+      fprintf(file, " %d", variables[k]);
+    }
+    fprintf(file, "\n");
+  }
+}
+
+void LogicGraphGenerator::WriteTablesUAI(FILE *file) {
+  for (int i = 0; i < num_variables_; ++i) {
+    fprintf(file, "2\n");
+    WriteDouble(1.0, file);
+    WriteDouble(exp(GetVariableLogPotential(i)), file);
+    fprintf(file, "\n");
+  }
+  // The tables of the logic factors are 1 for the configurations which
+  // satisfy them and 0 for the others. The last variable of the scope
+  // changes the fastest.
+  vector<int> variables;
+  vector<bool> negated;
+  int num_configurations = 1 << degree_;
+  for (int j = 0; j < num_factors_; ++j) {
+    int type = GetFactor(j, &variables, &negated);
+    fprintf(file, "%d\n", num_configurations);
+    for (int index = 0; index < num_configurations; ++index) {
+      int num_true = 0;
+      for (int k = 0; k < degree_; ++k) {
+        bool value = (index >> (degree_ - 1 - k)) & 1;
+        if (value != negated[k]) ++num_true;
+      }
+      bool satisfied = (type == LOGIC_XOR)? (num_true == 1) : (num_true > 0);
+      WriteDouble(satisfied? 1.0 : 0.0, file);
+    }
+    fprintf(file, "\n");
+  }
+}
+
+double ParsingGraphGenerator::GetVariableLogPotential(int64_t i) {
+  return Uniform(STREAM_VARIABLES, i, -0.5, 0.5);
+}
+
+void ParsingGraphGenerator::WriteFactors(FILE *file) {
+  // Tree factor, with the head and modifier of each arc.
+  int64_t num_arcs = GetNumVariables();
+  WriteFactorStart("ARBORESCENCE", num_arcs, file);
+  for (int64_t r = 0; r < num_arcs; ++r) {
+    WriteLink(r, false, file);
+  }
+  WriteInteger(length_, file);
+  for (int m = 1; m < length_; ++m) {
+    for (int h = 0; h < length_; ++h) {
+      if (h == m) continue;
+      WriteInteger(h, file);
+      WriteInteger(m, file);
+    }
+  }
+  fprintf(file, "\n");
+
+  // Head automata to the right of each head, then to the left; the
+  // automaton of a head with n modifiers has a score for each sibling
+  // (m, s) with 0 <= m < s <= n + 1.
+  for (int side = 0; side < 2; ++side) {
+    for (int h = 0; h < length_; ++h) {
+      int num_modifiers = (side == 0)? length_ - 1 - h : h - 1;
+      if (num_modifiers <= 0) continue;
+      WriteFactorStart("HEAD_AUTOMATON", num_modifiers, file);
+      for (int k = 1; k <= num_modifiers; ++k) {
+        int m = (side == 0)? h + k : h - k;
+        WriteLink(GetArcIndex(h, m), false, file);
+      }
+      int64_t automaton = side * length_ + h;
+      int64_t num_siblings =
+        static_cast<int64_t>(num_modifiers + 1) * (num_modifiers + 2) / 2;
+      for (int64_t k = 0; k < num_siblings; ++k) {
+        WriteDouble(Uniform(STREAM_SIBLINGS, (automaton << 32) + k,
+                            -0.05, 0.05), file);
+      }
+      fprintf(file, "\n");
+    }
+  }
+}
+
+double SummarizationGraphGenerator::GetVariableLogPotential(int64_t i) {
+  // Only the words kept (state 1) have a score.
+  if (i % 2 == 0) return 0.0;
+  return Uniform(STREAM_VARIABLES, i / 2, 0.0, 1.0);
+}
+
+void SummarizationGraphGenerator::WriteFactors(FILE *file) {
+  for (int s = 0; s < num_sentences_; ++s) {
+    int64_t first_word = static_cast<int64_t>(s) * length_;
+    WriteFactorStart("GENERAL_TREE", 2 * length_, file);
+    for (int i = 0; i < 2 * length_; ++i) {
+      WriteLink(2 * first_word + i, false, file);
+    }
+    WriteInteger(length_, file);
+    for (int i = 0; i < length_; ++i) {
+      WriteInteger(2, file);
+    }
+    // Random tree, where the parent of each word comes before it.
+    WriteInteger(-1, file);
+    for (int i = 1; i < length_; ++i) {
+      WriteInteger(Random(STREAM_PARENTS, first_word + i) % i, file);
+    }
+    // Scores for the states of the parent and of the word.
+    for (int i = 1; i < length_; ++i) {
+      for (int k = 0; k < 4; ++k) {
+        WriteDouble(Uniform(STREAM_EDGES, 4 * (first_word + i) + k,
+                            -0.5, 0.5), file);
+      }
+    }
+    fprintf(file, "\n");
+  }
+
+  // Budget on the words kept.
+  int64_t num_words = static_cast<int64_t>(num_sentences_) * length_;
+  WriteFactorStart("BUDGET", num_words, file);
+  for (int64_t i = 0; i < num_words; ++i) {
+    WriteLink(2 * i + 1, false, file);
+  }
+  WriteInteger(budget_, file);
+  fprintf(file, "\n");
+}
+
+} // namespace AD3
@@ -0,0 +1,255 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GRAPH_GENERATOR_H_
+#define GRAPH_GENERATOR_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+namespace AD3 {
+
+// Generator of synthetic factor graphs, written in the AD3 (.fg) or UAI
+// format, for scaling studies. The graphs are written as they are
+// generated, one line at a time, and nothing but their sizes is kept in
+// memory, so that graphs of any size can be generated.
+//
+// Every random number is a function of the seed, the graph, a stream and
+// an index (e.g. the log-potential of variable i is drawn from the stream
+// of the variables at index i), rather than the next number of a sequence.
+// The generated graphs are therefore the same on every platform, and the
+// parts of a graph which appear twice in a file (such as the scopes and the
+// tables of a UAI file) can be generated again instead of being stored.
+class GraphGenerator {
+ public:
+  GraphGenerator() { seed_ = 1; graph_ = 0; num_links_ = 0; }
+  virtual ~GraphGenerator() {}
+
+  // Set the seed of the random numbers.
+  void SetSeed(uint64_t seed) { seed_ = seed; }
+
+  // Number of binary variables and factors of each graph in the AD3
+  // format.
+  virtual int64_t GetNumVariables() = 0;
+  virtual int64_t GetNumFactors() = 0;
+
+  // Number of links of the last graph written in the AD3 format.
+  int64_t GetNumLinks() { return num_links_; }
+
+  // True if the graphs can be written in the UAI format (which only has
+  // tables, and cannot express the factors of the examples).
+  virtual bool SupportsUAI() { return false; }
+
+  // Write the graph with a given index (graphs with different indices are
+  // drawn independently) in the AD3 or UAI format. Returns 0 on success and
+  // -1 if the file cannot be written or the format is not supported.
+  int WriteGraph(int graph, FILE *file);
+  int WriteGraphUAI(int graph, FILE *file);
+
+ protected:
+  // Write the factor lines of the current graph in the AD3 format.
+  virtual void WriteFactors(FILE *file) = 0;
+
+  // Log-potential of a binary variable of the current graph.
+  virtual double GetVariableLogPotential(int64_t i) = 0;
+
+  // Write the multi-variables, the scopes and the tables of the current
+  // graph in the UAI format (these are only called if SupportsUAI()).
+  virtual void WriteVariablesUAI(FILE *file) {}
+  virtual void WriteScopesUAI(FILE *file) {}
+  virtual void WriteTablesUAI(FILE *file) {}
+
+  // Random integer and random number in [low, high), drawn from a stream
+  // of the current graph at an index.
+  uint64_t Random(int stream, int64_t index);
+  double Uniform(int stream, int64_t index, double low, double high);
+
+  // Write the start of a factor line: the type, the number of links and
+  // the links (one-based indices of the variables, negative if negated).
+  void WriteFactorStart(const char *type, int num_links, FILE *file) {
+    fprintf(file, "%s %d", type, num_links);
+    num_links_ += num_links;
+  }
+  void WriteLink(int64_t variable, bool negated, FILE *file) {
+    fprintf(file, negated? " -%lld" : " %lld",
+            static_cast<long long>(variable + 1));
+  }
+
+  // Write a number, preceded by a space.
+  void WriteInteger(int64_t value, FILE *file) {
+    fprintf(file, " %lld", static_cast<long long>(value));
+  }
+  void WriteDouble(double value, FILE *file) {
+    fprintf(file, " %.6g", value);
+  }
+
+ protected:
+  uint64_t seed_;
+  // Index of the graph being written.
+  int graph_;
+  int64_t num_links_;
+};
+
+// Grid of multi-variables with dense pairwise factors between neighbours
+// (see examples/cpp/dense/simple_grid.cpp). The edges have a Potts table
+// (alpha on the diagonal, zero elsewhere), shared by all of them, or
+// random tables in [-alpha, alpha].
+class GridGraphGenerator : public GraphGenerator {
+ public:
+  GridGraphGenerator(int num_rows, int num_columns, int num_states,
+                     bool potts, double alpha) {
+    num_rows_ = num_rows;
+    num_columns_ = num_columns;
+    num_states_ = num_states;
+    potts_ = potts;
+    alpha_ = alpha;
+  }
+
+  int64_t GetNumVariables() {
+    return GetNumNodes() * num_states_;
+  }
+  int64_t GetNumFactors() {
+    return static_cast<int64_t>(num_rows_) * (num_columns_ - 1) +
+      static_cast<int64_t>(num_rows_ - 1) * num_columns_;
+  }
+  bool SupportsUAI() { return true; }
+
+ protected:
+  void WriteFactors(FILE *file);
+  double GetVariableLogPotential(int64_t i);
+  void WriteVariablesUAI(FILE *file);
+  void WriteScopesUAI(FILE *file);
+  void WriteTablesUAI(FILE *file);
+
+  int64_t GetNumNodes() {
+    return static_cast<int64_t>(num_rows_) * num_columns_;
+  }
+  // Log-potential of the edge between a node and its neighbour on the left
+  // (or above, if vertical is true), for a pair of states.
+  double GetEdgeLogPotential(int64_t node, bool vertical,
+                             int neighbour_state, int state);
+  // Write a line for each edge of the grid, in the order of the factors:
+  // its factor in the AD3 format, or its scope or table in the UAI format.
+  void WriteEdges(int section, FILE *file);
+
+  int num_rows_;
+  int num_columns_;
+  int num_states_;
+  bool potts_;
+  double alpha_;
+};
+
+// Random logic graph: binary variables with random log-potentials, linked
+// by OR, IMPLY and XOR factors (see examples/cpp/logic/simple_coref.cpp) of
+// a fixed degree, on random variables. The negations of the links are
+// chosen so that a random assignment satisfies all the factors, and the
+// graph is therefore always feasible. IMPLY factors are written as OR
+// factors with the antecedents negated.
+class LogicGraphGenerator : public GraphGenerator {
+ public:
+  LogicGraphGenerator(int num_variables, int num_factors, int degree) {
+    num_variables_ = num_variables;
+    num_factors_ = num_factors;
+    degree_ = degree;
+  }
+
+  int64_t GetNumVariables() { return num_variables_; }
+  int64_t GetNumFactors() { return num_factors_; }
+  bool SupportsUAI() { return true; }
+
+ protected:
+  void WriteFactors(FILE *file);
+  double GetVariableLogPotential(int64_t i);
+  void WriteVariablesUAI(FILE *file);
+  void WriteScopesUAI(FILE *file);
+  void WriteTablesUAI(FILE *file);
+
+  // Type (one of the LogicFactorTypes in GraphGenerator.cpp), variables
+  // and negations of a factor.
+  int GetFactor(int64_t j, vector<int> *variables, vector<bool> *negated);
+
+  // Value of a variable in the assignment which satisfies all the factors.
+  int GetAssignment(int variable);
+
+  int num_variables_;
+  int num_factors_;
+  int degree_;
+};
+
+// Dependency parsing graph for a sentence (see
+// examples/cpp/parsing/simple_parser.cpp): one variable per arc, a tree
+// factor linked to all of them, and a head automaton for each side of each
+// head word, with scores for consecutive siblings.
+class ParsingGraphGenerator : public GraphGenerator {
+ public:
+  // The length includes the root symbol.
+  ParsingGraphGenerator(int length) { length_ = length; }
+
+  int64_t GetNumVariables() {
+    return static_cast<int64_t>(length_ - 1) * (length_ - 1);
+  }
+  int64_t GetNumFactors() {
+    // The automata without modifiers are left out.
+    return 1 + (length_ - 1) + (length_ - 2);
+  }
+
+ protected:
+  void WriteFactors(FILE *file);
+  double GetVariableLogPotential(int64_t i);
+
+  // Index of the variable of the arc from head h to modifier m.
+  int64_t GetArcIndex(int h, int m) {
+    return static_cast<int64_t>(m - 1) * (length_ - 1) + ((h < m)? h : h-1);
+  }
+
+  int length_;
+};
+
+// Budgeted summarization graph: a document of sentences, each one a random
+// dependency tree of words, where each word is kept or not. Each sentence
+// has a tree factor (GENERAL_TREE, with two states per word) with scores for
+// the states of each word and its parent, and a BUDGET factor limits the
+// number of words kept in the whole document.
+class SummarizationGraphGenerator : public GraphGenerator {
+ public:
+  SummarizationGraphGenerator(int num_sentences, int length, int budget) {
+    num_sentences_ = num_sentences;
+    length_ = length;
+    budget_ = budget;
+  }
+
+  int64_t GetNumVariables() {
+    return 2 * static_cast<int64_t>(num_sentences_) * length_;
+  }
+  int64_t GetNumFactors() { return num_sentences_ + 1; }
+
+ protected:
+  void WriteFactors(FILE *file);
+  double GetVariableLogPotential(int64_t i);
+
+  int num_sentences_;
+  int length_;
+  int budget_;
+};
+
+} // namespace AD3
+
+#endif // GRAPH_GENERATOR_H_
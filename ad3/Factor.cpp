@@ -16,11 +16,112 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <math.h>
 #include "Factor.h"
 #include "Utils.h"
 
 namespace AD3 {
 
+// Get the values divided by denominator, and register a new user of them.
+// Factors sharing a table may be solved in parallel, hence the critical
+// section; it is kept out of the header so that only this file, which is
+// compiled with OpenMP, sees the pragma.
+const vector<double> *SharedLogPotentials::AcquireScaledValues(
+  double denominator) {
+  const vector<double> *values = NULL;
+#pragma omp critical(ad3_shared_log_potentials)
+  {
+    ScaledValues *scaled = NULL;
+    for (int i = 0; i < scaled_values_.size(); ++i) {
+      if (scaled_values_[i]->denominator == denominator) {
+        scaled = scaled_values_[i];
+        break;
+      }
+    }
+    if (scaled == NULL) {
+      scaled = new ScaledValues;
+      scaled->denominator = denominator;
+      scaled->num_users = 0;
+      scaled->values.resize(values_.size());
+      for (int i = 0; i < values_.size(); ++i) {
+        scaled->values[i] = values_[i] / denominator;
+      }
+      scaled_values_.push_back(scaled);
+    }
+    ++scaled->num_users;
+    values = &scaled->values;
+  }
+  return values;
+}
+
+// Unregister a user of scaled values, deleting them if they are unused.
+void SharedLogPotentials::ReleaseScaledValues(const vector<double> *values) {
+#pragma omp critical(ad3_shared_log_potentials)
+  {
+    for (int i = 0; i < scaled_values_.size(); ++i) {
+      ScaledValues *scaled = scaled_values_[i];
+      if (&scaled->values != values) continue;
+      if (--scaled->num_users == 0) {
+        delete scaled;
+        scaled_values_.erase(scaled_values_.begin() + i);
+      }
+      break;
+    }
+  }
+}
+
+// Compute the max-marginal differences by flipping each variable of the
+// MAP configuration. The penalty is larger than twice the score of any
+// configuration, so the re-solved MAP flips the variable whenever some
+// configuration allows it.
+void Factor::ComputeMaxMarginalDifferences(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *max_marginal_differences) {
+  int factor_degree = binary_variables_.size();
+  max_marginal_differences->resize(factor_degree);
+
+  vector<double> variable_posteriors;
+  vector<double> additional_posteriors;
+  double value;
+  SolveMAP(variable_log_potentials, additional_log_potentials,
+           &variable_posteriors, &additional_posteriors, &value);
+  vector<bool> map_values(factor_degree);
+  for (int i = 0; i < factor_degree; ++i) {
+    map_values[i] = (variable_posteriors[i] > 0.5);
+  }
+
+  double penalty = 0.0;
+  for (int i = 0; i < factor_degree; ++i) {
+    penalty += fabs(variable_log_potentials[i]);
+  }
+  for (int i = 0; i < additional_log_potentials.size(); ++i) {
+    penalty += fabs(additional_log_potentials[i]);
+  }
+  penalty = 2.0 * penalty + 1.0;
+
+  vector<double> log_potentials(variable_log_potentials);
+  for (int i = 0; i < factor_degree; ++i) {
+    // Penalize the current value of the i-th variable.
+    double shift = map_values[i]? -penalty : penalty;
+    log_potentials[i] += shift;
+    double flipped_value;
+    SolveMAP(log_potentials, additional_log_potentials,
+             &variable_posteriors, &additional_posteriors, &flipped_value);
+    log_potentials[i] = variable_log_potentials[i];
+
+    bool flipped = (variable_posteriors[i] > 0.5);
+    if (flipped == map_values[i]) {
+      // The variable cannot take the other value.
+      (*max_marginal_differences)[i] = map_values[i]? 1e100 : -1e100;
+    } else if (map_values[i]) {
+      (*max_marginal_differences)[i] = value - flipped_value;
+    } else {
+      (*max_marginal_differences)[i] = flipped_value - shift - value;
+    }
+  }
+}
+
 // Add evidence information to the factor.
 // Returns 0 if nothing changed.
 // Returns 1 if new evidence was set or new links were disabled,
@@ -150,6 +251,43 @@ void FactorXOR::SolveQP(const vector<double> &variable_log_potentials,
   }
 }
 
+// Compute the max-marginal differences. Each configuration has a single
+// active (non-negated) variable; its score is the sum of the potentials
+// of the negated variables plus the signed potential of the active one.
+void FactorXOR::ComputeMaxMarginalDifferences(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *max_marginal_differences) {
+  int factor_degree = binary_variables_.size();
+  max_marginal_differences->resize(factor_degree);
+
+  // Score of each variable when it is the active one (up to a constant).
+  vector<double> scores(factor_degree);
+  for (int f = 0; f < factor_degree; ++f) {
+    scores[f] = negated_[f]?
+      -variable_log_potentials[f] : variable_log_potentials[f];
+  }
+
+  // Find the best and second best active variables.
+  int first = -1;
+  int second = -1;
+  for (int f = 0; f < factor_degree; ++f) {
+    if (first < 0 || scores[f] > scores[first]) {
+      second = first;
+      first = f;
+    } else if (second < 0 || scores[f] > scores[second]) {
+      second = f;
+    }
+  }
+
+  for (int f = 0; f < factor_degree; ++f) {
+    int other = (f == first)? second : first;
+    // If there is no other variable, this one must be active.
+    double difference = (other < 0)? 1e100 : scores[f] - scores[other];
+    (*max_marginal_differences)[f] = negated_[f]? -difference : difference;
+  }
+}
+
 // Add evidence information to the factor.
 // Returns 0 if nothing changed.
 // Returns 1 if new evidence was set or new links were disabled,
@@ -1073,4 +1211,23 @@ void FactorPAIR::SolveQP(const vector<double> &variable_log_potentials,
   }
 }
 
+// Compute the max-marginal differences from the scores of the four
+// configurations.
+void FactorPAIR::ComputeMaxMarginalDifferences(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *max_marginal_differences) {
+  max_marginal_differences->resize(variable_log_potentials.size());
+
+  double p[4] = { 0.0, // 00
+                  variable_log_potentials[1], // 01
+                  variable_log_potentials[0], // 10
+                  variable_log_potentials[0] + variable_log_potentials[1] +
+                    additional_log_potentials[0] // 11
+  };
+
+  (*max_marginal_differences)[0] = MAX(p[2], p[3]) - MAX(p[0], p[1]);
+  (*max_marginal_differences)[1] = MAX(p[1], p[3]) - MAX(p[0], p[2]);
+}
+
 } // namespace AD3
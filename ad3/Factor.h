@@ -38,7 +38,8 @@ struct FactorTypes {
     FACTOR_ATMOSTONE,
     FACTOR_BUDGET,
     FACTOR_KNAPSACK,
-    FACTOR_MULTI_DENSE
+    FACTOR_MULTI_DENSE,
+    FACTOR_MULTI_SPARSE
   };
 };
 
@@ -84,10 +85,50 @@ class BinaryVariable {
   vector<int> links_; // Link identifiers.
 };
 
+// Immutable table of additional log-potentials shared by several factors
+// (e.g. the same pairwise table on every edge of a grid). The copies of the
+// table divided by a denominator (see
+// Factor::ComputeCachedAdditionalLogPotentials) are shared too: there is
+// one for each denominator in use, which is deleted when no factor uses it
+// anymore. Tables are created and owned by the factor graph, and must
+// outlive the factors which use them.
+class SharedLogPotentials {
+ public:
+  SharedLogPotentials(const vector<double> &values) : values_(values) {}
+  virtual ~SharedLogPotentials() {
+    for (int i = 0; i < scaled_values_.size(); ++i) {
+      delete scaled_values_[i];
+    }
+  }
+
+  // Get the values of the table.
+  const vector<double> &GetValues() { return values_; }
+
+  // Get the values divided by denominator, and register a new user of
+  // them. Each call must be matched by a call to ReleaseScaledValues.
+  const vector<double> *AcquireScaledValues(double denominator);
+
+  // Unregister a user of scaled values, deleting them if they are unused.
+  void ReleaseScaledValues(const vector<double> *values);
+
+ private:
+  struct ScaledValues {
+    double denominator;
+    int num_users;
+    vector<double> values;
+  };
+  vector<double> values_;
+  vector<ScaledValues*> scaled_values_;
+};
+
 // Base class for a factor.
 class Factor {
  public:
-  Factor() {}
+  Factor() {
+    shared_additional_log_potentials_ = NULL;
+    shared_additional_log_potentials_last_ = NULL;
+    cached_additional_version_ = 0;
+  }
   virtual ~Factor() {}
 
   // Return the type.
@@ -160,14 +201,32 @@ class Factor {
     return 0;
   }
 
+  // True if AddEvidence is implemented for this factor.
+  virtual bool SupportsEvidence() { return false; }
+
   // Gets/Sets additional log potentials.
   const vector<double> &GetAdditionalLogPotentials() {
+    if (shared_additional_log_potentials_) {
+      return shared_additional_log_potentials_->GetValues();
+    }
     return additional_log_potentials_;
   }
 
   void SetAdditionalLogPotentials(
       const vector<double> &additional_log_potentials) {
+    ReleaseSharedAdditionalLogPotentials();
     additional_log_potentials_ = additional_log_potentials;
+    ++cached_additional_version_;
+  }
+
+  // Use a shared table of additional log potentials instead of a copy.
+  void SetSharedAdditionalLogPotentials(
+      SharedLogPotentials *additional_log_potentials) {
+    ReleaseSharedAdditionalLogPotentials();
+    vector<double>().swap(additional_log_potentials_);
+    vector<double>().swap(additional_log_potentials_last_);
+    shared_additional_log_potentials_ = additional_log_potentials;
+    ++cached_additional_version_;
   }
 
   // Gets/Sets/Computes cached values.
@@ -175,12 +234,40 @@ class Factor {
     return &variable_log_potentials_last_;
   }
   void ComputeCachedAdditionalLogPotentials(double denominator) {
+    if (shared_additional_log_potentials_) {
+      if (shared_additional_log_potentials_last_ &&
+          shared_additional_log_potentials_last_denominator_ == denominator) {
+        return;
+      }
+      // Acquire before releasing, so that values still in use by this
+      // factor are not deleted and computed again.
+      const vector<double> *values =
+        shared_additional_log_potentials_->AcquireScaledValues(denominator);
+      if (shared_additional_log_potentials_last_) {
+        shared_additional_log_potentials_->ReleaseScaledValues(
+          shared_additional_log_potentials_last_);
+      }
+      shared_additional_log_potentials_last_ = values;
+      shared_additional_log_potentials_last_denominator_ = denominator;
+      ++cached_additional_version_;
+      return;
+    }
     additional_log_potentials_last_.resize(additional_log_potentials_.size());
     for (int i = 0; i < additional_log_potentials_.size(); ++i) {
       additional_log_potentials_last_[i] = 
           additional_log_potentials_[i] / denominator;
     }
+    ++cached_additional_version_;
+  }
+  const vector<double> &GetCachedAdditionalLogPotentials() {
+    if (shared_additional_log_potentials_last_) {
+      return *shared_additional_log_potentials_last_;
+    }
+    return additional_log_potentials_last_;
   }
+  // Version of the cached additional log potentials, which changes
+  // whenever they may have changed.
+  int GetCachedAdditionalVersion() { return cached_additional_version_; }
   const vector<double> &GetCachedVariablePosteriors() {
     return variable_posteriors_last_;
   }
@@ -201,10 +288,21 @@ class Factor {
                        vector<double> *variable_posteriors,
                        vector<double> *additional_posteriors) = 0;
 
+  // Compute the max-marginal differences (used by MPLP): for each binary
+  // variable, the score of the best configuration where the variable is 1
+  // minus the score of the best configuration where it is 0. Values
+  // which no configuration can take get a difference of +/-1e100.
+  // By default, each variable is flipped in turn by solving the MAP
+  // with a large penalty; factors may override this.
+  virtual void ComputeMaxMarginalDifferences(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *max_marginal_differences);
+
   // Cached version of SolveMAP.
   virtual void SolveMAPCached(double *value) {
     SolveMAP(variable_log_potentials_last_,
-             additional_log_potentials_last_,
+             GetCachedAdditionalLogPotentials(),
              &variable_posteriors_last_,
              &additional_posteriors_last_,
              value);
@@ -213,12 +311,22 @@ class Factor {
   // Cached version of SolveQP.
   virtual void SolveQPCached() {
     SolveQP(variable_log_potentials_last_,
-            additional_log_potentials_last_,
+            GetCachedAdditionalLogPotentials(),
             &variable_posteriors_last_,
             &additional_posteriors_last_);
   }
 
  private:
+  // Stop using a shared table of additional log potentials.
+  void ReleaseSharedAdditionalLogPotentials() {
+    if (shared_additional_log_potentials_last_) {
+      shared_additional_log_potentials_->ReleaseScaledValues(
+        shared_additional_log_potentials_last_);
+    }
+    shared_additional_log_potentials_ = NULL;
+    shared_additional_log_potentials_last_ = NULL;
+  }
+
   int id_; // Factor id.
 
  protected:
@@ -234,6 +342,12 @@ class Factor {
   vector<double> variable_posteriors_last_;
   vector<double> additional_posteriors_last_;
 
+  // Shared additional log-potentials (if not NULL, they are used instead of
+  // additional_log_potentials_), and their cached values.
+  SharedLogPotentials *shared_additional_log_potentials_;
+  const vector<double> *shared_additional_log_potentials_last_;
+  double shared_additional_log_potentials_last_denominator_;
+  int cached_additional_version_;
 };
 
 // XOR factor. Only configurations with exactly one 1 are legal.
@@ -249,6 +363,7 @@ class FactorXOR : public Factor {
   }
 
   // Add evidence information to the factor.
+  bool SupportsEvidence() { return true; }
   int AddEvidence(vector<bool> *active_links,
                   vector<int> *evidence,
                   vector<int> *additional_evidence);
@@ -266,6 +381,12 @@ class FactorXOR : public Factor {
                vector<double> *variable_posteriors,
                vector<double> *additional_posteriors);
 
+  // Compute the max-marginal differences in closed form.
+  void ComputeMaxMarginalDifferences(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *max_marginal_differences);
+
  private:
   // Cached copy of the last sort.
   vector<pair<double,int> > last_sort_;
@@ -284,6 +405,7 @@ class FactorAtMostOne : public Factor {
   }
 
   // Add evidence information to the factor.
+  bool SupportsEvidence() { return true; }
   int AddEvidence(vector<bool> *active_links,
                   vector<int> *evidence,
                   vector<int> *additional_evidence);
@@ -319,6 +441,7 @@ class FactorOR : public Factor {
   }
 
   // Add evidence information to the factor.
+  bool SupportsEvidence() { return true; }
   int AddEvidence(vector<bool> *active_links,
                   vector<int> *evidence,
                   vector<int> *additional_evidence);
@@ -370,6 +493,7 @@ public:
   }
 
   // Add evidence information to the factor.
+  bool SupportsEvidence() { return true; }
   int AddEvidence(vector<bool> *active_links,
                   vector<int> *evidence,
                   vector<int> *additional_evidence);
@@ -507,7 +631,7 @@ class FactorPAIR : public Factor {
   }
 
   // Get edge log-potential.
-  double GetLogPotential() { return additional_log_potentials_[0]; }
+  double GetLogPotential() { return GetAdditionalLogPotentials()[0]; }
 
   // Compute the MAP (local subproblem in the projected subgradient algorithm).
   void SolveMAP(const vector<double> &variable_log_potentials,
@@ -522,7 +646,14 @@ class FactorPAIR : public Factor {
                vector<double> *variable_posteriors,
                vector<double> *additional_posteriors);
 
+  // Compute the max-marginal differences in closed form.
+  void ComputeMaxMarginalDifferences(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *max_marginal_differences);
+
   // Add evidence information to the factor.
+  bool SupportsEvidence() { return true; }
   int AddEvidence(vector<bool> *active_links,
                   vector<int> *evidence,
                   vector<int> *additional_evidence);
@@ -48,36 +48,137 @@ class FactorDense : public GenericFactor {
     // Write the additional log-potentials.
     int num_configurations = GetNumConfigurations();
     for (int index = 0; index < num_configurations; ++index) {
-        stream << " " << setprecision(9) << additional_log_potentials_[index];
+        stream << " " << setprecision(9) << GetAdditionalLogPotentials()[index];
     }
       
     stream << endl;
   }
 
-  // Compute the score of a given assignment.
+  // Find the most likely assignment. The configurations are enumerated
+  // with an odometer over the states of all but the last multi-variable,
+  // keeping the partial sums of their log-potentials; for each of these,
+  // the configurations that differ in the last state are contiguous in
+  // the table, and are scored and maximized in a tight loop.
   void Maximize(const vector<double> &variable_log_potentials,
                 const vector<double> &additional_log_potentials,
                 Configuration &configuration,
                 double *value) {
     vector<int> *states = static_cast<vector<int>*>(configuration);
+    int last = multi_variables_.size() - 1;
+    int num_last_states = multi_variables_[last]->GetNumStates();
+    const double *last_scores =
+      &variable_log_potentials[GetVariableIndex(last, 0)];
+    // prefix_scores_[i] is the sum of the log-potentials of the states of
+    // the first i multi-variables.
+    prefix_scores_.resize(last + 1);
+    row_scores_.resize(num_last_states);
+    states->assign(last + 1, 0);
+    prefix_scores_[0] = 0.0;
+    for (int i = 0; i < last; ++i) {
+      prefix_scores_[i+1] = prefix_scores_[i] +
+        variable_log_potentials[GetVariableIndex(i, 0)];
+    }
+
     int best = -1;
     *value = -1e12;
+    int num_configurations = additional_log_potentials.size();
+    for (int offset = 0; offset < num_configurations;
+         offset += num_last_states) {
+      const double *additionals = &additional_log_potentials[offset];
+      double prefix_score = prefix_scores_[last];
+      double *scores = &row_scores_[0];
+      for (int k = 0; k < num_last_states; ++k) {
+        scores[k] = additionals[k] + last_scores[k] + prefix_score;
+      }
+      // Independent partial maxima, so that the loop can be vectorized.
+      double max_scores[4] = { scores[0], scores[0], scores[0], scores[0] };
+      int k = 0;
+      for (; k + 4 <= num_last_states; k += 4) {
+        for (int l = 0; l < 4; ++l) {
+          if (scores[k+l] > max_scores[l]) max_scores[l] = scores[k+l];
+        }
+      }
+      for (; k < num_last_states; ++k) {
+        if (scores[k] > max_scores[0]) max_scores[0] = scores[k];
+      }
+      double max_score = max_scores[0];
+      for (int l = 1; l < 4; ++l) {
+        if (max_scores[l] > max_score) max_score = max_scores[l];
+      }
+      if (best < 0 || max_score > *value) {
+        // Keep the first configuration with the best score.
+        for (k = 0; k < num_last_states - 1 && scores[k] != max_score; ++k) {}
+        best = offset + k;
+        *value = max_score;
+      }
+
+      // Advance the odometer and update the partial sums.
+      int i = last - 1;
+      while (i >= 0 && ++(*states)[i] == multi_variables_[i]->GetNumStates()) {
+        (*states)[i] = 0;
+        --i;
+      }
+      if (i < 0) break;
+      for (; i < last; ++i) {
+        prefix_scores_[i+1] = prefix_scores_[i] +
+          variable_log_potentials[GetVariableIndex(i, (*states)[i])];
+      }
+    }
+    assert(best >= 0);
+    GetConfigurationStates(best, states);
+  }
+
+  // Compute the max-marginal differences. The best score for each state
+  // of each multi-variable is obtained in a single pass over the table;
+  // the difference of a state is its best score minus the best score of
+  // the other states of the same multi-variable.
+  void ComputeMaxMarginalDifferences(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *max_marginal_differences) {
+    vector<double> best_scores(variable_log_potentials.size(), -1e100);
+    vector<int> states(multi_variables_.size());
     for (int index = 0;
          index < additional_log_potentials.size();
          ++index) {
       double score = additional_log_potentials[index];
-      GetConfigurationStates(index, states);
-      for (int i = 0; i < states->size(); ++i) {
-        int variable_index = GetVariableIndex(i, (*states)[i]);
+      GetConfigurationStates(index, &states);
+      for (int i = 0; i < states.size(); ++i) {
+        int variable_index = GetVariableIndex(i, states[i]);
         score += variable_log_potentials[variable_index];
       }
-      if (best < 0 || score > *value) {
-        best = index;
-        *value = score;
+      for (int i = 0; i < states.size(); ++i) {
+        int variable_index = GetVariableIndex(i, states[i]);
+        if (score > best_scores[variable_index]) {
+          best_scores[variable_index] = score;
+        }
+      }
+    }
+
+    max_marginal_differences->resize(variable_log_potentials.size());
+    for (int i = 0; i < multi_variables_.size(); ++i) {
+      int num_states = multi_variables_[i]->GetNumStates();
+      // Find the best and second best states.
+      int first = -1;
+      int second = -1;
+      for (int state = 0; state < num_states; ++state) {
+        double score = best_scores[GetVariableIndex(i, state)];
+        if (first < 0 || score > best_scores[GetVariableIndex(i, first)]) {
+          second = first;
+          first = state;
+        } else if (second < 0 ||
+                   score > best_scores[GetVariableIndex(i, second)]) {
+          second = state;
+        }
+      }
+      for (int state = 0; state < num_states; ++state) {
+        int other = (state == first)? second : first;
+        int variable_index = GetVariableIndex(i, state);
+        (*max_marginal_differences)[variable_index] = (other < 0)? 1e100 :
+          best_scores[variable_index] -
+          best_scores[GetVariableIndex(i, other)];
       }
     }
-    assert(best >= 0);
-    GetConfigurationStates(best, states);
   }
 
   // Compute the score of a given assignment.
@@ -117,6 +218,18 @@ class FactorDense : public GenericFactor {
     (*additional_posteriors)[index] += weight;
   }
   
+  // The support of a configuration is one variable per multi-variable,
+  // in increasing order.
+  void ComputeVariableSupport(const Configuration &configuration,
+                              vector<pair<int, double> > *support) {
+    const vector<int> *states =
+        static_cast<const vector<int>*>(configuration);
+    support->resize(states->size());
+    for (int i = 0; i < states->size(); ++i) {
+      (*support)[i] = make_pair(GetVariableIndex(i, (*states)[i]), 1.0);
+    }
+  }
+
   // Count how many common values two configurations have.
   int CountCommonValues(const Configuration &configuration1,
                         const Configuration &configuration2) {
@@ -145,6 +258,15 @@ class FactorDense : public GenericFactor {
     return true;
   }
 
+  // Hash a configuration by its index in the table, which is unique.
+  bool HashConfiguration(const Configuration &configuration,
+                         unsigned int *hash) {
+    const vector<int> *states =
+        static_cast<const vector<int>*>(configuration);
+    *hash = static_cast<unsigned int>(GetConfigurationIndex(*states));
+    return true;
+  }
+
   // Delete configuration.
   void DeleteConfiguration(
     Configuration configuration) {
@@ -158,13 +280,19 @@ class FactorDense : public GenericFactor {
     return static_cast<Configuration>(states); 
   }
 
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *states =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*states));
+  }
+
  public:
   // Initialize the factor and build internal structure. 
   // num_states contains the number of states for each multi-variable linked to 
   // the factor.
   // Note: the variables and the additional log-potentials must be ordered
   // properly.
-  void Initialize(const vector<MultiVariable*> &multi_variables) {
+  virtual void Initialize(const vector<MultiVariable*> &multi_variables) {
     multi_variables_ = multi_variables;
 
     // Build offsets.
@@ -220,6 +348,9 @@ class FactorDense : public GenericFactor {
   vector<MultiVariable*> multi_variables_;
   // Offsets of the variables in the pool of values.
   vector<int> variable_offsets_;
+  // Scratch vectors for Maximize.
+  vector<double> prefix_scores_;
+  vector<double> row_scores_;
 };
 
 } // namespace AD3
@@ -17,6 +17,8 @@
 // along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <iostream>
+#include <algorithm>
+#include <queue>
 #include <math.h>
 #include "FactorGraph.h"
 #include "Utils.h"
@@ -109,9 +111,42 @@ void FactorGraph::ConvertToBinaryFactorGraph(FactorGraph *binary_factor_graph) {
             CreateFactorXOROUT(binary_variables_array[variable_index]);
         }
       }
+    } else if (factor->type() == FactorTypes::FACTOR_MULTI_SPARSE) {
+      // Same as above, with one extra variable per allowed configuration.
+      FactorSparse *factor_sparse = static_cast<FactorSparse*>(factor);
+      int num_configurations = factor_sparse->GetNumConfigurations();
+      vector<BinaryVariable*> extra_variables(num_configurations);
+      vector<vector<BinaryVariable*> >
+        binary_variables_array(factor_sparse->Degree());
+      for (int index = 0; index < num_configurations; ++index) {
+        extra_variables[index] =
+          binary_factor_graph->CreateBinaryVariable();
+        extra_variables[index]->
+          SetLogPotential(factor_sparse->GetAdditionalLogPotentials()[index]);
+        for (int j = 0; j < factor_sparse->GetNumMultiVariables(); ++j) {
+          int state = factor_sparse->GetConfigurationState(index, j);
+          int variable_index = factor_sparse->GetVariableIndex(j, state);
+          binary_variables_array[variable_index].
+            push_back(extra_variables[index]);
+        }
+      }
+      for (int j = 0; j < factor_sparse->GetNumMultiVariables(); ++j) {
+        MultiVariable *multi_variable = factor_sparse->GetMultiVariable(j);
+        for (int state = 0;
+             state < multi_variable->GetNumStates();
+             ++state) {
+          BinaryVariable *binary_variable =
+            binary_variables_from_multi[multi_variable->GetId()][state];
+          int variable_index = factor_sparse->GetVariableIndex(j, state);
+          binary_variables_array[variable_index].push_back(binary_variable);
+          binary_factor_graph->
+            CreateFactorXOROUT(binary_variables_array[variable_index]);
+        }
+      }
     } else {    
       cout << "Error: factor type = " << factor->type()
-           << " (for now, only multi-dense factors can be binarized.)"
+           << " (for now, only multi-dense and multi-sparse factors can be "
+           << "binarized.)"
            << endl;
     }
   }
@@ -137,6 +172,248 @@ void FactorGraph::CopyAdditionalLogPotentials(
   }
 }
 
+int FactorGraph::ComputeAdditionalFactorOffsets(
+    vector<int>* factor_indices) {
+  factor_indices->resize(factors_.size());
+  int offset = 0;
+  for (int j = 0; j < factors_.size(); ++j) {
+    (*factor_indices)[j] = offset;
+    offset += factors_[j]->GetAdditionalLogPotentials().size();
+  }
+  return offset;
+}
+
+// Make the values of each multi-variable one-hot, by choosing the state
+// with the largest score. States whose scores differ less than
+// tie_threshold are ties, in which case states already set to 1 win.
+void FactorGraph::DecodeMultiVariables(const vector<double> &scores,
+                                       double tie_threshold,
+                                       vector<int> *values) {
+  for (int i = 0; i < multi_variables_.size(); ++i) {
+    MultiVariable *multi_variable = multi_variables_[i];
+    int best = -1;
+    for (int state = 0; state < multi_variable->GetNumStates(); ++state) {
+      int k = multi_variable->GetState(state)->GetId();
+      if (best < 0 || scores[k] > scores[best] + tie_threshold ||
+          (scores[k] > scores[best] - tie_threshold &&
+           (*values)[k] > (*values)[best])) {
+        best = k;
+      }
+    }
+    for (int state = 0; state < multi_variable->GetNumStates(); ++state) {
+      int k = multi_variable->GetState(state)->GetId();
+      (*values)[k] = (k == best)? 1 : 0;
+    }
+  }
+}
+
+// Each factor is solved with potentials that force the given values of
+// its variables, which gives the best values of the additional variables
+// (or shows that the factor rules out the assignment). The penalty is
+// larger than twice the score of the additional log-potentials.
+bool FactorGraph::EvaluateAssignment(
+    const vector<int> &values,
+    const vector<int> &additional_factor_offsets,
+    vector<double> *additional_posteriors,
+    double *value) {
+  vector<double> log_potentials;
+  vector<double> variable_posteriors;
+  vector<double> factor_additional_posteriors;
+  *value = 0.0;
+  for (int i = 0; i < variables_.size(); ++i) {
+    *value += values[i] * variables_[i]->GetLogPotential();
+  }
+  for (int j = 0; j < factors_.size(); ++j) {
+    Factor *factor = factors_[j];
+    int factor_degree = factor->Degree();
+    const vector<double> &additional_log_potentials =
+      factor->GetAdditionalLogPotentials();
+    double penalty = 0.0;
+    for (int i = 0; i < additional_log_potentials.size(); ++i) {
+      penalty += fabs(additional_log_potentials[i]);
+    }
+    penalty = 2.0 * penalty + 1.0;
+
+    log_potentials.resize(factor_degree);
+    double forced_score = 0.0;
+    for (int i = 0; i < factor_degree; ++i) {
+      int k = factor->GetVariable(i)->GetId();
+      log_potentials[i] = values[k]? penalty : -penalty;
+      if (values[k]) forced_score += penalty;
+    }
+    double val;
+    factor->SolveMAP(log_potentials,
+                     additional_log_potentials,
+                     &variable_posteriors,
+                     &factor_additional_posteriors,
+                     &val);
+    for (int i = 0; i < factor_degree; ++i) {
+      int k = factor->GetVariable(i)->GetId();
+      if ((variable_posteriors[i] > 0.5) != (values[k] == 1)) return false;
+    }
+    *value += val - forced_score;
+
+    // Note: factors without additional variables may leave
+    // factor_additional_posteriors untouched.
+    int offset = additional_factor_offsets[j];
+    for (int i = 0; i < additional_log_potentials.size(); ++i) {
+      (*additional_posteriors)[offset] = factor_additional_posteriors[i];
+      ++offset;
+    }
+  }
+  return true;
+}
+
+// Multi-variables take the state with the largest posterior (the first one
+// in case of ties); the other binary variables are rounded.
+bool FactorGraph::EvaluateRoundedPosteriors(const vector<double> &posteriors,
+                                            double *value) {
+  vector<int> values(variables_.size());
+  for (int i = 0; i < variables_.size(); ++i) {
+    values[i] = (posteriors[i] > 0.5)? 1 : 0;
+  }
+  DecodeMultiVariables(posteriors, 0.0, &values);
+  vector<int> additional_factor_offsets(factors_.size());
+  int offset = 0;
+  for (int j = 0; j < factors_.size(); ++j) {
+    additional_factor_offsets[j] = offset;
+    offset += factors_[j]->GetAdditionalLogPotentials().size();
+  }
+  vector<double> additional_posteriors(offset);
+  return EvaluateAssignment(values, additional_factor_offsets,
+                            &additional_posteriors, value);
+}
+
+// Compute the MAP of a factor with its cached log-potentials, which are
+// first recomputed from the Lagrange multipliers if required.
+void FactorGraph::SolveCachedFactor(Factor *factor,
+                                    bool recompute_cache,
+                                    double *value) {
+  if (recompute_cache) {
+    int factor_degree = factor->Degree();
+    vector<double> *cached_log_potentials =
+      factor->GetMutableCachedVariableLogPotentials();
+    cached_log_potentials->resize(factor_degree);
+    for (int i = 0; i < factor_degree; ++i) {
+      int m = factor->GetLinkId(i);
+      BinaryVariable* variable = factor->GetVariable(i);
+      int variable_degree = variable->Degree();
+      double val = variable->GetLogPotential() / 
+        static_cast<double>(variable_degree)
+        + 2.0 * lambdas_[m];
+      (*cached_log_potentials)[i] = val;
+    }
+    factor->ComputeCachedAdditionalLogPotentials(1.0);
+  }
+  factor->SolveMAPCached(value);
+}
+
+void FactorGraph::InitializeEvidenceBuffers() {
+  evidence_offsets_.resize(factors_.size());
+  int offset = GetNumVariables();
+  for (int j = 0; j < factors_.size(); ++j) {
+    evidence_offsets_[j] = offset;
+    offset += factors_[j]->GetAdditionalLogPotentials().size();
+  }
+  factor_in_queue_.assign(factors_.size(), false);
+}
+
+// Propagate evidence with a queue of factors (unit propagation).
+// A factor is examined again only when one of its variables gets new
+// evidence.
+bool FactorGraph::PropagateEvidence(const vector<int> *variables,
+                                    vector<int> *evidence,
+                                    vector<bool> *active_links,
+                                    vector<bool> *active_factors,
+                                    int *num_visits) {
+  if (!variables) InitializeEvidenceBuffers();
+  assert(evidence_offsets_.size() == factors_.size());
+  assert(factor_in_queue_.size() == factors_.size());
+  vector<bool> &in_queue = factor_in_queue_;
+
+  // Start with all factors or with the factors linked to the given
+  // variables.
+  queue<int> factor_queue;
+  if (!variables) {
+    for (int j = 0; j < factors_.size(); ++j) {
+      factor_queue.push(j);
+      in_queue[j] = true;
+    }
+  } else {
+    for (int k = 0; k < variables->size(); ++k) {
+      BinaryVariable *variable = variables_[(*variables)[k]];
+      for (int l = 0; l < variable->Degree(); ++l) {
+        int j = variable->GetFactor(l)->GetId();
+        if (in_queue[j]) continue;
+        factor_queue.push(j);
+        in_queue[j] = true;
+      }
+    }
+  }
+
+  // These vectors are reused for all the factors.
+  vector<int> local_evidence;
+  vector<bool> local_active_links;
+  vector<int> additional_evidence;
+
+  *num_visits = 0;
+  while (!factor_queue.empty()) {
+    int i = factor_queue.front();
+    factor_queue.pop();
+    in_queue[i] = false;
+    Factor *factor = factors_[i];
+    if (!(*active_factors)[i] || !factor->SupportsEvidence()) continue;
+    ++(*num_visits);
+
+    // Add evidence to the factor.
+    // Returns 0 if nothing changed.
+    // Returns 1 if new evidence was set or new links were disabled,
+    // but factor keeps active.
+    // Returns 2 if factor became inactive.
+    // Returns -1 if a contradiction was found, in which case the
+    // problem is infeasible.
+    int factor_degree = factor->Degree();
+    local_evidence.resize(factor_degree);
+    local_active_links.resize(factor_degree);
+    additional_evidence.clear();
+    for (int j = 0; j < factor_degree; ++j) {
+      local_evidence[j] = (*evidence)[factor->GetVariable(j)->GetId()];
+      local_active_links[j] = (*active_links)[factor->GetLinkId(j)];
+    }
+    int ret = factor->AddEvidence(&local_active_links, &local_evidence,
+                                  &additional_evidence);
+    for (int j = 0; j < factor_degree; ++j) {
+      BinaryVariable *variable = factor->GetVariable(j);
+      int k = variable->GetId();
+      (*active_links)[factor->GetLinkId(j)] = local_active_links[j];
+      if ((*evidence)[k] == local_evidence[j]) continue;
+      (*evidence)[k] = local_evidence[j];
+      // New evidence: examine the factors linked to this variable.
+      for (int l = 0; l < variable->Degree(); ++l) {
+        int m = variable->GetFactor(l)->GetId();
+        if (in_queue[m]) continue;
+        factor_queue.push(m);
+        in_queue[m] = true;
+      }
+    }
+    for (int j = 0; j < additional_evidence.size(); ++j) {
+      assert(evidence_offsets_[i] + j < evidence->size());
+      (*evidence)[evidence_offsets_[i] + j] = additional_evidence[j];
+    }
+    if (ret < 0) {
+      if (verbosity_ > 1) factor->Print(cout);
+      // Leave the queue flags cleared for the next call.
+      while (!factor_queue.empty()) {
+        in_queue[factor_queue.front()] = false;
+        factor_queue.pop();
+      }
+      return false;
+    }
+    if (ret == 2) (*active_factors)[i] = false;
+  }
+  return true;
+}
+
 // Transform the factor graph to incorporate evidence information.
 // The vector evidence is given {0,1,-1} values (-1 means no evidence). The 
 // size of the vector is the number of variables plus the number of additional
@@ -152,55 +429,15 @@ int FactorGraph::AddEvidence(vector<int> *evidence,
   // Set array of active links and active factors.
   vector<bool> active_links(num_links_, true);
   vector<bool> active_factors(factors_.size(), true);
-  bool changed = true;
-  int num_passes = 0;
-  while (changed) {
-    changed = false;
-    ++num_passes;
-    int offset = GetNumVariables();
-    // Go through each factor and propagate evidence.
-    for (int i = 0; i < factors_.size(); ++i) {
-      Factor *factor = factors_[i];
-      if (!active_factors[i]) {
-        offset += factor->GetAdditionalLogPotentials().size();
-        continue;
-      }
-      // Add evidence to the factor.
-      // Returns 0 if nothing changed.
-      // Returns 1 if new evidence was set or new links were disabled,
-      // but factor keeps active.
-      // Returns 2 if factor became inactive.
-      // Returns -1 if a contradiction was found, in which case the
-      // problem is infeasible.
-      vector<int> local_evidence(factor->Degree(), -1);
-      vector<bool> local_active_links(factor->Degree(), true);
-      vector<int> additional_evidence;
-      for (int j = 0; j < factor->Degree(); ++j) {
-        local_evidence[j] = (*evidence)[factor->GetVariable(j)->GetId()];
-        local_active_links[j] = active_links[factor->GetLinkId(j)];
-      }
-      int ret = factor->AddEvidence(&local_active_links, &local_evidence, 
-                                    &additional_evidence);
-      for (int j = 0; j < factor->Degree(); ++j) {
-        (*evidence)[factor->GetVariable(j)->GetId()] = local_evidence[j];
-        active_links[factor->GetLinkId(j)] = local_active_links[j];
-      }
-      for (int j = 0; j < additional_evidence.size(); ++j) {
-        assert(offset + j < evidence->size());
-        (*evidence)[offset + j] = additional_evidence[j];
-      }
-      offset += factor->GetAdditionalLogPotentials().size();
-      if (ret < 0) {
-        factor->Print(cout);
-        return STATUS_INFEASIBLE;
-      }
-      if (ret != 0) changed = true;
-      if (ret == 2) active_factors[i] = false;
-    }    
+  int num_visits;
+  if (!PropagateEvidence(NULL, evidence, &active_links, &active_factors,
+                         &num_visits)) {
+    return STATUS_INFEASIBLE;
   }
 
   if (verbosity_ > 1) {
-    cout << "Factor graph reduced after " << num_passes << " passes." << endl;
+    cout << "Factor graph reduced after " << num_visits << " factor visits."
+         << endl;
   }
 
   // Handle special factors.
@@ -219,6 +456,7 @@ int FactorGraph::AddEvidence(vector<int> *evidence,
         factor_or->InitializeFromOROUT(factor);
         if (owned_factors_[i]) delete factor;
         factor = factor_or;
+        factors_[i] = factor_or;
         owned_factors_[i] = true; // Mark as owned.
       }
     } else if (factor->type() == FactorTypes::FACTOR_PAIR) {
@@ -409,8 +647,14 @@ int FactorGraph::RunPSDD(double lower_bound,
   vector<double> maps_sum(variables_.size(), 0.0);
   int t;
   double dual_obj_best = 1e100, primal_rel_obj_best = -1e100;
-  //double primal_obj_best = -1e100;
+  double primal_obj_best = -1e100;
   int num_iterations_compute_dual = 50;
+  int num_iterations_compute_primal = 10;
+  // State of the Polyak stepsize.
+  double polyak_margin = 0.0;
+  int num_polyak_failures = 0;
+  int num_iterations_polyak_patience = 10;
+  vector<int> decoded_values(variables_.size());
 
   // Compute extra score to account for variables that are not connected 
   // to any factor.
@@ -456,16 +700,26 @@ int FactorGraph::RunPSDD(double lower_bound,
   maps_av_.clear();
   maps_av_.resize(variables_.size(), 0.5);
 
-  int num_times_increment = 0;
+  int num_dual_increases = 0;
   double dual_obj_prev = 1e100;
   double dual_obj = extra_score;
   // Stores each factor contribution to the dual objective.
   vector<double> dual_obj_factors(factors_.size(), 0.0);
+  // Factors whose MAP is computed in parallel in the current iteration,
+  // and the corresponding values.
+  vector<int> factors_to_solve;
+  vector<double> factor_values(factors_.size(), 0.0);
+  vector<double> decoded_additional_posteriors(
+    additional_log_potentials.size(), 0.0);
 
   for (t = 0; t < psdd_max_iterations_; ++t) {
-    // Set stepsize.
-    //double eta = psdd_eta_ / static_cast<double>(num_times_increment+1);
+    // Set stepsize. Polyak's stepsize depends on the current dual
+    // objective and subgradient, so it is only set after computing them.
+    bool polyak = (psdd_stepsize_rule_ == PSDD_STEPSIZE_POLYAK);
     double eta = psdd_eta_ / sqrt(static_cast<double>(t+1));
+    if (psdd_stepsize_rule_ == PSDD_STEPSIZE_ADAPTIVE) {
+      eta = psdd_eta_ / static_cast<double>(num_dual_increases+1);
+    }
 
     // Initialize all variables as inactive.
     for (int i = 0; i < variables_.size(); ++i) {
@@ -473,12 +727,31 @@ int FactorGraph::RunPSDD(double lower_bound,
     }
 
     // Optimize over maps_. (Compute dual value.)
+    // Skip inactive factors, but periodically update everything.
+    // TODO: actually use num_iterations_reset somewhere
+    bool solve_all_factors = (0 == (t % num_iterations_reset)) ||
+      recompute_everything;
+    // With several threads, the MAPs are computed beforehand in parallel;
+    // each factor only touches its own cache.
+    bool parallel = (num_threads_ > 1);
+    if (parallel) {
+      factors_to_solve.clear();
+      for (int j = 0; j < factors_.size(); ++j) {
+        if (solve_all_factors || factor_is_active[j]) {
+          factors_to_solve.push_back(j);
+        }
+      }
+      int num_factors_to_solve = factors_to_solve.size();
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+      for (int r = 0; r < num_factors_to_solve; ++r) {
+        int j = factors_to_solve[r];
+        SolveCachedFactor(factors_[j], recompute_everything, &factor_values[j]);
+      }
+    }
+
     int num_inactive_factors = 0;
     for (int j = 0; j < factors_.size(); ++j) {
-      // Skip inactive factors, but periodically update everything.
-      // TODO: actually use num_iterations_reset somewhere
-      if ((0 != (t % num_iterations_reset)) && 
-          !recompute_everything && !factor_is_active[j]) {
+      if (!solve_all_factors && !factor_is_active[j]) {
         ++num_inactive_factors;
         continue;
       }
@@ -486,26 +759,13 @@ int FactorGraph::RunPSDD(double lower_bound,
       Factor *factor = factors_[j];
       int factor_degree = factor->Degree();
 
-      // When properly flagged, need to recompute everything.
-      if (recompute_everything) {
-        vector<double> *cached_log_potentials =
-          factor->GetMutableCachedVariableLogPotentials();
-        cached_log_potentials->resize(factor_degree);
-        for (int i = 0; i < factor_degree; ++i) {
-          int m = factor->GetLinkId(i);
-          BinaryVariable* variable = factor->GetVariable(i);
-          int variable_degree = variable->Degree();
-          double val = variable->GetLogPotential() / 
-            static_cast<double>(variable_degree)
-            + 2.0 * lambdas_[m];
-          (*cached_log_potentials)[i] = val;
-        }
-        factor->ComputeCachedAdditionalLogPotentials(1.0);
-      }
-
       // Compute the MAP and update the dual objective.
       double val;
-      factor->SolveMAPCached(&val);
+      if (parallel) {
+        val = factor_values[j];
+      } else {
+        SolveCachedFactor(factor, recompute_everything, &val);
+      }
       double delta = 0.0;
       for (int i = 0; i < factor_degree; ++i) {
         int m = factor->GetLinkId(i);
@@ -540,7 +800,8 @@ int FactorGraph::RunPSDD(double lower_bound,
       }
     }
 
-    // Optimize over maps_av and update Lagrange multipliers.
+    // Optimize over maps_av and update Lagrange multipliers (the latter
+    // is deferred for Polyak's stepsize).
     double primal_residual = 0.0;
     for (int i = 0; i < variables_.size(); ++i) {
       BinaryVariable *variable = variables_[i];
@@ -562,9 +823,11 @@ int FactorGraph::RunPSDD(double lower_bound,
       }
       for (int j = 0; j < variable_degree; ++j) {
         int m = variable->GetLinkId(j);
+        double diff_penalty = maps_[m] - maps_av_[i];
+        primal_residual += diff_penalty * diff_penalty;
+        if (polyak) continue;
         Factor* factor = variable->GetFactor(j);
         int k = factor->GetId();
-        double diff_penalty = maps_[m] - maps_av_[i];
         int l = indVinF[m];
         vector<double> *cached_log_potentials =
           factor->GetMutableCachedVariableLogPotentials();
@@ -573,9 +836,10 @@ int FactorGraph::RunPSDD(double lower_bound,
 
         // Mark factor as active.
         factor_is_active[k] = true;
-        primal_residual += diff_penalty * diff_penalty;
       }
     }
+    // The projected subgradient of the dual is 2 * (maps_ - maps_av_).
+    double squared_residual = primal_residual;
     primal_residual = sqrt(primal_residual / lambdas_.size()); 
 
     // If primal residual is low enough or enough iterations 
@@ -588,10 +852,9 @@ int FactorGraph::RunPSDD(double lower_bound,
       compute_primal_rel = true;
     }
 
-    // Check if dual improved so that num_times_increment 
-    // can be incremented.
-    if (dual_obj < dual_obj_prev) {
-      ++num_times_increment;
+    // Count how many times the dual did not improve.
+    if (dual_obj >= dual_obj_prev) {
+      ++num_dual_increases;
     }
     dual_obj_prev = dual_obj;
 
@@ -606,6 +869,77 @@ int FactorGraph::RunPSDD(double lower_bound,
         primal_rel_obj += (*additional_posteriors)[i] * additional_log_potentials[i];
       }
     }
+    if (primal_rel_obj_best < primal_rel_obj) {
+      primal_rel_obj_best = primal_rel_obj; 
+    }
+
+    // Polyak's stepsize needs an estimate of the optimal value: every few
+    // iterations, round maps_av_ to an assignment and keep the best
+    // objective of the feasible ones.
+    if (polyak &&
+        0 == (t % num_iterations_compute_primal)) {
+      for (int i = 0; i < variables_.size(); ++i) {
+        decoded_values[i] = (maps_av_[i] > 0.5)? 1 : 0;
+      }
+      DecodeMultiVariables(maps_av_, 1e-12, &decoded_values);
+      double primal_obj;
+      if (EvaluateAssignment(decoded_values,
+                             additional_factor_offsets,
+                             &decoded_additional_posteriors,
+                             &primal_obj) &&
+          primal_obj_best < primal_obj) {
+        primal_obj_best = primal_obj;
+      }
+    }
+
+    if (polyak) {
+      // Polyak's stepsize, (dual - target) / |subgradient|^2, scaled by
+      // psdd_eta_. The target is the best dual objective minus a margin,
+      // which grows when the dual objective decreases and is halved when
+      // it fails to decrease for several iterations. It never goes below
+      // the best primal objective.
+      if (t == 0) {
+        polyak_margin = (primal_obj_best > -1e100)?
+          dual_obj - primal_obj_best : 0.1 * MAX(1.0, fabs(dual_obj));
+      } else if (dual_obj >= dual_obj_best) {
+        ++num_polyak_failures;
+        if (num_polyak_failures >= num_iterations_polyak_patience) {
+          polyak_margin *= 0.5;
+          num_polyak_failures = 0;
+        }
+      } else {
+        polyak_margin *= 1.2;
+        num_polyak_failures = 0;
+      }
+      double target = (dual_obj < dual_obj_best)? dual_obj : dual_obj_best;
+      target -= polyak_margin;
+      if (target < primal_obj_best) target = primal_obj_best;
+      double gap = dual_obj - target;
+      if (gap > 0.0 && squared_residual > 0.0) {
+        eta = psdd_eta_ * gap / (2.0 * squared_residual);
+      }
+
+      // Update Lagrange multipliers.
+      for (int i = 0; i < variables_.size(); ++i) {
+        if (!variable_is_active[i]) continue;
+        BinaryVariable *variable = variables_[i];
+        int variable_degree = variable->Degree();
+        for (int j = 0; j < variable_degree; ++j) {
+          int m = variable->GetLinkId(j);
+          Factor* factor = variable->GetFactor(j);
+          int k = factor->GetId();
+          double diff_penalty = maps_[m] - maps_av_[i];
+          int l = indVinF[m];
+          vector<double> *cached_log_potentials =
+            factor->GetMutableCachedVariableLogPotentials();
+          (*cached_log_potentials)[l] -= 2.0 * eta * diff_penalty;
+          lambdas_[m] -= eta * diff_penalty;
+
+          // Mark factor as active.
+          factor_is_active[k] = true;
+        }
+      }
+    }
 
     if (dual_obj_best > dual_obj) {
       dual_obj_best = dual_obj;
@@ -617,9 +951,6 @@ int FactorGraph::RunPSDD(double lower_bound,
         break;
       }
     }
-    if (primal_rel_obj_best < primal_rel_obj) {
-      primal_rel_obj_best = primal_rel_obj; 
-    }
     if (compute_primal_rel) {
       gettimeofday(&end, NULL);
       if (verbosity_ > 1) {
@@ -629,6 +960,7 @@ int FactorGraph::RunPSDD(double lower_bound,
              << "\tPrimal residual = " << primal_residual
              << "\tBest dual obj = " << dual_obj_best
              << "\tBest primal rel obj = " << primal_rel_obj_best
+             << "\tBest primal obj = " << primal_obj_best
              << "\tCached factors = " << 
           static_cast<double>(num_inactive_factors) /
           static_cast<double>(factors_.size())
@@ -670,6 +1002,7 @@ int FactorGraph::RunPSDD(double lower_bound,
          << *value << endl;
   }
   *upper_bound = dual_obj_best;
+  last_num_iterations_ += t;
 
   gettimeofday(&end, NULL);
   if (verbosity_ > 1) {
@@ -703,185 +1036,26 @@ int FactorGraph::RunPSDD(double lower_bound,
   }
 }
 
-int FactorGraph::RunBranchAndBound(double cumulative_value,
-                                   vector<bool> &branched_variables,
-                                   int depth,
-                                   vector<double>* posteriors,
-                                   vector<double>* additional_posteriors,
-                                   double *value,
-                                   double *best_lower_bound,
-                                   double *best_upper_bound) {
-  int max_branching_depth = 5; // 2;
-
-  // Solve the LP relaxation.
-  int status = RunAD3(*best_lower_bound + cumulative_value,
-                      posteriors,
-                      additional_posteriors,
-                      value,
-                      best_upper_bound);
-
-  *value -= cumulative_value;
-  *best_upper_bound -= cumulative_value;
-  if (status == STATUS_OPTIMAL_INTEGER) {
-    if (*value > *best_lower_bound) {
-      *best_lower_bound = *value;
-    }
-    return status;
-  } else if (status == STATUS_INFEASIBLE) {
-    *value = -1e100;
-    *best_upper_bound = -1e100;
-    return status;
-  }
-
-  if (max_branching_depth >= 0 && depth > max_branching_depth) {
-    *value = -1e100;
-    *best_upper_bound = -1e100;
-    if (verbosity_ > 1) {
-        cout << "Maximum depth exceeded." << endl;
-    }
-    return STATUS_UNSOLVED;
-  }
-
-  // Look for the most fractional component.
-  int variable_to_branch = -1;
-  double most_fractional_value = 0.25; // 0.25 = (1-0.5) * (1-0.5).
-  for (int i = 0; i < variables_.size(); ++i) {
-    if (branched_variables[i]) continue; // Already branched.
-    double diff = (*posteriors)[i] - 0.5;
-    diff *= diff;
-    if (variable_to_branch < 0 || diff < most_fractional_value) {
-      variable_to_branch = i;
-      most_fractional_value = diff;
-    }
-  }
-  assert(variable_to_branch >= 0);
-  branched_variables[variable_to_branch] = true;
-  if (verbosity_ > 1) {
-      cout << "Branching on variable " << variable_to_branch
-           << " at depth " << depth
-           << " (value = " << (*posteriors)[variable_to_branch] << ")"
-           << endl;
-  }
-
-  double infinite_potential = 1000.0;
-  double original_potential = variables_[variable_to_branch]->GetLogPotential();
-  status = STATUS_OPTIMAL_INTEGER;
-
-  // Zero branch.
-  vector<double> posteriors_zero;
-  vector<double> additional_posteriors_zero;
-  double value_zero;
-  double upper_bound_zero;
-  double score = variables_[variable_to_branch]->GetLogPotential();
-  variables_[variable_to_branch]->SetLogPotential(score - infinite_potential);
-  int status_zero = RunBranchAndBound(cumulative_value,
-                                      branched_variables,
-                                      depth + 1,
-                                      &posteriors_zero,
-                                      &additional_posteriors_zero,
-                                      &value_zero,
-                                      best_lower_bound,
-                                      best_upper_bound);
-  // Put back the original potential.
-  variables_[variable_to_branch]->SetLogPotential(original_potential);
-  if (status_zero != STATUS_OPTIMAL_INTEGER &&
-      status_zero != STATUS_INFEASIBLE) {
-    status = STATUS_UNSOLVED;
-    //return STATUS_UNSOLVED;
-  }
-
-  // One branch.
-  vector<double> posteriors_one;
-  vector<double> additional_posteriors_one;
-  double value_one;
-  double upper_bound_one;
-  score = variables_[variable_to_branch]->GetLogPotential();
-  variables_[variable_to_branch]->SetLogPotential(score + infinite_potential);
-  int status_one = RunBranchAndBound(cumulative_value + infinite_potential,
-                                     branched_variables,
-                                     depth + 1,
-                                     &posteriors_one,
-                                     &additional_posteriors_one,
-                                     &value_one,
-                                     best_lower_bound,
-                                     best_upper_bound);
-  // Put back the original potential.
-  variables_[variable_to_branch]->SetLogPotential(original_potential);
-  if (status_one != STATUS_OPTIMAL_INTEGER &&
-      status_one != STATUS_INFEASIBLE) {
-    status = STATUS_UNSOLVED;
-    //return STATUS_UNSOLVED;
-  }
-
-  branched_variables[variable_to_branch] = false;
-
-  if (status_zero == STATUS_INFEASIBLE &&
-      status_one == STATUS_INFEASIBLE) {
-    *value = -1e100;
-    return STATUS_INFEASIBLE;
-  }
-
-  if (value_zero >= value_one) {
-    *value = value_zero;
-    *posteriors = posteriors_zero;
-    *additional_posteriors = additional_posteriors_zero;
-  } else {
-    *value = value_one;
-    *posteriors = posteriors_one;
-    *additional_posteriors = additional_posteriors_one;
-  }
-
-  //return STATUS_OPTIMAL_INTEGER;
-  return status;
-}
-
-int FactorGraph::RunAD3(double lower_bound,
-                        vector<double> *posteriors,
-                        vector<double> *additional_posteriors,
-                        double *value,
-                        double *upper_bound) {
+int FactorGraph::RunMPLP(double lower_bound,
+                         vector<double> *posteriors,
+                         vector<double> *additional_posteriors,
+                         double *value,
+                         double *upper_bound) {
   timeval start, end;
   gettimeofday(&start, NULL);
 
-  // Stopping criterion parameters.
-  double residual_threshold = ad3_residual_threshold_; // 1e-6;
-  //double gap_threshold = 1e-6;
-
-  // Stepsize adjustment parameters.
-  double max_eta = 100.0;
-  double min_eta = 1e-3;
-  double gamma_primal = 100.0; // 10.0
-  double gamma_dual = 10.0;
-  double factor_step = 2.0;
-  double tau = 1.0;
-  int num_iterations_adapt_eta = 10; // 1
-
-  // Caching parameters.
-  vector<bool> factor_is_active(factors_.size(), true);
-  vector<bool> variable_is_active(variables_.size(), false);
-  int num_iterations_reset = 50;
-  double cache_tolerance = 1e-12;
-  bool caching = true; // true
+  // Beliefs closer to zero than this are ties, which are broken by the
+  // MAP assignments of the factors.
+  double tie_threshold = 1e-9;
+  // Relative duality gap below which the assignment is optimal.
+  double gap_threshold = 1e-9;
 
   // Optimization status.
   bool optimal = false;
   bool reached_lower_bound = false;
 
-  // Miscellaneous.
-  vector<double> log_potentials;
-  vector<double> factor_variable_posteriors;
-  vector<double> factor_additional_posteriors;
-  bool eta_changed = true;
-  vector<double> maps_sum(variables_.size(), 0.0);
-  int t;
-  double dual_obj_best = 1e100, primal_rel_obj_best = -1e100;
-  double primal_obj_best = -1e100;
-  int num_iterations_compute_dual = 50;
-
   // Compute extra score to account for variables that are not connected 
   // to any factor.
-  // TODO: Precompute the value of these variables and eliminate them
-  // from the pool.
   double extra_score = 0.0;
   for (int i = 0; i < variables_.size(); ++i) {
     BinaryVariable *variable = variables_[i];
@@ -896,7 +1070,7 @@ int FactorGraph::RunAD3(double lower_bound,
     }
   }
 
-  posteriors->resize(variables_.size(), 0.0);
+  posteriors->assign(variables_.size(), 0.0);
 
   // Copy all additional log potentials to a vector and save room 
   // for the posteriors of additional variables.
@@ -904,38 +1078,1079 @@ int FactorGraph::RunAD3(double lower_bound,
   vector<int> additional_factor_offsets(factors_.size());
   CopyAdditionalLogPotentials(&additional_log_potentials,
                               &additional_factor_offsets);
-  additional_posteriors->resize(additional_log_potentials.size(), 0.0);
+  additional_posteriors->assign(additional_log_potentials.size(), 0.0);
 
-  // Map indices of variables in factors.
-  vector<int> indVinF(num_links_, -1);
-  for (int j = 0; j < factors_.size(); ++j) {
-    int factor_degree = factors_[j]->Degree();
-    for (int l = 0; l < factor_degree; ++l) {
-      indVinF[factors_[j]->GetLinkId(l)] = l;
-    }
+  // Max-marginal differences of values ruled out by a factor are
+  // infinite; they are clamped to a bound larger than twice the score of
+  // any configuration, which keeps the same optimal assignments.
+  double score_bound = 0.0;
+  for (int i = 0; i < variables_.size(); ++i) {
+    score_bound += fabs(variables_[i]->GetLogPotential());
   }
+  for (int i = 0; i < additional_log_potentials.size(); ++i) {
+    score_bound += fabs(additional_log_potentials[i]);
+  }
+  score_bound = 2.0 * score_bound + 1.0;
 
+  // Messages from factors to variables (lambdas_) and beliefs of the
+  // variables, both stored as the difference between the values for
+  // states 1 and 0. The belief of a variable is its log-potential plus
+  // the sum of its incoming messages.
   lambdas_.clear();
   lambdas_.resize(num_links_, 0.0);
-  maps_.clear();
-  maps_.resize(num_links_, 0.0);
-  maps_av_.clear();
-  maps_av_.resize(variables_.size(), 0.5);
-
-  double eta = ad3_eta_;
-  for (t = 0; t < ad3_max_iterations_; ++t) {
-    int num_inactive_factors = 0;
+  vector<double> beliefs(variables_.size());
+  for (int i = 0; i < variables_.size(); ++i) {
+    beliefs[i] = variables_[i]->GetLogPotential();
+  }
 
-    // Initialize all variables as inactive.
+  // Miscellaneous.
+  vector<double> log_potentials;
+  vector<double> max_marginal_differences;
+  vector<double> variable_posteriors;
+  vector<double> factor_additional_posteriors;
+  vector<double> map_additional_posteriors(additional_log_potentials.size(),
+                                           0.0);
+  // Assignment decoded from the beliefs and values chosen by the factors
+  // for the ties.
+  vector<int> decoded_values(variables_.size());
+  vector<int> tie_values(variables_.size());
+  int t;
+  double dual_obj_best = 1e100, primal_obj_best = -1e100;
+  double dual_obj_prev = 1e100;
+
+  for (t = 0; t < mplp_max_iterations_; ++t) {
+    // Block coordinate descent: update all messages of one factor at a
+    // time, given the messages sent by the other factors (star update).
+    for (int j = 0; j < factors_.size(); ++j) {
+      Factor *factor = factors_[j];
+      int factor_degree = factor->Degree();
+      if (factor_degree == 0) continue;
+
+      log_potentials.resize(factor_degree);
+      for (int i = 0; i < factor_degree; ++i) {
+        int m = factor->GetLinkId(i);
+        int k = factor->GetVariable(i)->GetId();
+        log_potentials[i] = beliefs[k] - lambdas_[m];
+      }
+      factor->ComputeMaxMarginalDifferences(
+        log_potentials,
+        factor->GetAdditionalLogPotentials(),
+        &max_marginal_differences);
+
+      // The new beliefs split the max-marginals evenly among the
+      // variables of the factor.
+      for (int i = 0; i < factor_degree; ++i) {
+        int m = factor->GetLinkId(i);
+        int k = factor->GetVariable(i)->GetId();
+        double difference = max_marginal_differences[i];
+        if (difference > score_bound) {
+          difference = score_bound;
+        } else if (difference < -score_bound) {
+          difference = -score_bound;
+        }
+        beliefs[k] = difference / static_cast<double>(factor_degree);
+        lambdas_[m] = beliefs[k] - log_potentials[i];
+      }
+    }
+
+    // Compute the dual objective: the sum of the maxima of the beliefs
+    // and of the MAPs of the factors under the reparameterized potentials.
+    // Ties in the beliefs are broken by the first factor of each variable.
+    double dual_obj = extra_score;
+    for (int i = 0; i < variables_.size(); ++i) {
+      if (variables_[i]->Degree() > 0) dual_obj += MAX(0.0, beliefs[i]);
+    }
+    tie_values.assign(variables_.size(), -1);
+    for (int j = 0; j < factors_.size(); ++j) {
+      Factor *factor = factors_[j];
+      int factor_degree = factor->Degree();
+      log_potentials.resize(factor_degree);
+      for (int i = 0; i < factor_degree; ++i) {
+        int m = factor->GetLinkId(i);
+        log_potentials[i] = -lambdas_[m];
+      }
+      double val;
+      factor->SolveMAP(log_potentials,
+                       factor->GetAdditionalLogPotentials(),
+                       &variable_posteriors,
+                       &factor_additional_posteriors,
+                       &val);
+      dual_obj += val;
+      for (int i = 0; i < factor_degree; ++i) {
+        int k = factor->GetVariable(i)->GetId();
+        if (tie_values[k] < 0) {
+          tie_values[k] = (variable_posteriors[i] > 0.5)? 1 : 0;
+        }
+      }
+    }
+    if (dual_obj_best > dual_obj) {
+      dual_obj_best = dual_obj;
+      if (dual_obj_best < lower_bound) {
+        reached_lower_bound = true;
+        break;
+      }
+    }
+
+    // Decode an assignment from the beliefs.
+    for (int i = 0; i < variables_.size(); ++i) {
+      if (variables_[i]->Degree() == 0) {
+        decoded_values[i] = (variables_[i]->GetLogPotential() > 0)? 1 : 0;
+      } else if (beliefs[i] > tie_threshold) {
+        decoded_values[i] = 1;
+      } else if (beliefs[i] < -tie_threshold) {
+        decoded_values[i] = 0;
+      } else {
+        decoded_values[i] = (tie_values[i] > 0)? 1 : 0;
+      }
+    }
+    DecodeMultiVariables(beliefs, tie_threshold, &decoded_values);
+
+    // Evaluate the decoded assignment.
+    double primal_obj;
+    bool feasible = EvaluateAssignment(decoded_values,
+                                       additional_factor_offsets,
+                                       &map_additional_posteriors,
+                                       &primal_obj);
+
+    // Keep the best feasible assignment (or the last decoded one, if
+    // none was feasible so far).
+    if (!feasible) primal_obj = -1e100;
+    if (primal_obj_best < primal_obj || primal_obj_best == -1e100) {
+      if (feasible) primal_obj_best = primal_obj;
+      for (int i = 0; i < variables_.size(); ++i) {
+        (*posteriors)[i] = decoded_values[i];
+      }
+      *additional_posteriors = map_additional_posteriors;
+    }
+
+    if (verbosity_ > 1) {
+      gettimeofday(&end, NULL);
+      cout << "Iteration = " << t
+           << "\tDual obj = " << dual_obj
+           << "\tPrimal obj = " << primal_obj
+           << "\tBest dual obj = " << dual_obj_best
+           << "\tBest primal obj = " << primal_obj_best
+           << "\tTime = " << ((double) diff_ms(end,start))/1000.0 << " sec."
+           << endl;
+    }
+
+    // If the duality gap is closed, the assignment is optimal.
+    if (dual_obj_best - primal_obj_best <
+        gap_threshold * MAX(1.0, fabs(dual_obj_best))) {
+      optimal = true;
+      break;
+    }
+
+    // Stop if the dual objective does not decrease anymore.
+    if (dual_obj_prev - dual_obj <
+        mplp_dual_threshold_ * MAX(1.0, fabs(dual_obj))) {
+      break;
+    }
+    dual_obj_prev = dual_obj;
+  }
+
+  *value = 0.0;
+  for (int i = 0; i < variables_.size(); ++i) {
+    *value += (*posteriors)[i] * variables_[i]->GetLogPotential();
+  }
+  for (int i = 0; i < additional_log_potentials.size(); ++i) {
+    *value += (*additional_posteriors)[i] * additional_log_potentials[i];
+  }
+
+  if (verbosity_ > 1) {
+    cout << "Solution value after "
+         << t << " iterations (MPLP) = "
+         << *value << endl;
+  }
+  *upper_bound = dual_obj_best;
+  last_num_iterations_ += t;
+
+  gettimeofday(&end, NULL);
+  if (verbosity_ > 1) {
+    cout << "Took " << ((double) diff_ms(end,start))/1000.0 << " sec." << endl;
+  }
+
+  if (optimal) {
+    if (verbosity_ > 1) {
+      cout << "Solution is integer." << endl;
+    }
+    return STATUS_OPTIMAL_INTEGER;
+  } else {
+    if (reached_lower_bound) {
+      if (verbosity_ > 1) {
+        cout << "Reached lower bound: " << lower_bound << "." << endl;
+      }
+      return STATUS_INFEASIBLE;
+    } else {
+      if (verbosity_ > 1) {
+        cout << "Solution is only approximate." << endl;
+      }
+      return STATUS_UNSOLVED;
+    }
+  }
+}
+
+void FactorGraph::SaveAD3State(AD3State *state) {
+  state->lambdas = lambdas_;
+  state->maps = maps_;
+  state->maps_av = maps_av_;
+  state->eta = ad3_last_eta_;
+  state->active_sets.resize(factors_.size());
+  state->saved_active_sets.assign(factors_.size(), false);
+  for (int j = 0; j < factors_.size(); ++j) {
+    if (!factors_[j]->IsGeneric()) continue;
+    GenericFactor *factor = static_cast<GenericFactor*>(factors_[j]);
+    state->saved_active_sets[j] =
+      factor->SaveActiveSet(&state->active_sets[j]);
+  }
+}
+
+void FactorGraph::DeleteAD3State(AD3State *state) {
+  for (int j = 0; j < state->active_sets.size(); ++j) {
+    if (!state->saved_active_sets[j]) continue;
+    GenericFactor *factor = static_cast<GenericFactor*>(factors_[j]);
+    factor->DeleteActiveSet(&state->active_sets[j]);
+  }
+  state->active_sets.clear();
+  state->saved_active_sets.clear();
+}
+
+bool FactorGraph::FixVariables(const vector<int> &variables,
+                               const vector<int> &values) {
+  for (int k = 0; k < variables.size(); ++k) {
+    int i = variables[k];
+    if (evidence_[i] >= 0 && evidence_[i] != values[k]) return false;
+    evidence_[i] = values[k];
+  }
+  int num_visits;
+  return PropagateEvidence(&variables, &evidence_, &active_links_,
+                           &active_factors_, &num_visits);
+}
+
+int FactorGraph::SelectMostFractionalVariable(
+    const vector<double> &posteriors) {
+  int variable_to_branch = -1;
+  double most_fractional_value = 0.25; // 0.25 = (1-0.5) * (1-0.5).
+  for (int i = 0; i < variables_.size(); ++i) {
+    if (evidence_[i] >= 0) continue; // Already fixed.
+    double diff = posteriors[i] - 0.5;
+    diff *= diff;
+    if (variable_to_branch < 0 || diff < most_fractional_value) {
+      variable_to_branch = i;
+      most_fractional_value = diff;
+    }
+  }
+  return variable_to_branch;
+}
+
+int FactorGraph::SelectPseudoCostVariable(const vector<double> &posteriors) {
+  // Variables which were never branched on use the average pseudo-cost.
+  double average_costs[2] = { 0.0, 0.0 };
+  int num_average_costs[2] = { 0, 0 };
+  for (int i = 0; i < variables_.size(); ++i) {
+    for (int b = 0; b < 2; ++b) {
+      if (num_pseudo_costs_[2*i + b] == 0) continue;
+      average_costs[b] += pseudo_costs_[2*i + b] / num_pseudo_costs_[2*i + b];
+      ++num_average_costs[b];
+    }
+  }
+  for (int b = 0; b < 2; ++b) {
+    average_costs[b] = (num_average_costs[b] > 0)?
+      average_costs[b] / num_average_costs[b] : 1.0;
+  }
+
+  // Score each fractional variable by the product of the estimated
+  // degradations of both children.
+  double epsilon = 1e-6;
+  int variable_to_branch = -1;
+  double best_score = -1.0;
+  for (int i = 0; i < variables_.size(); ++i) {
+    if (evidence_[i] >= 0) continue;
+    if (NEARLY_BINARY(posteriors[i], 1e-6)) continue;
+    double costs[2];
+    for (int b = 0; b < 2; ++b) {
+      int num = num_pseudo_costs_[2*i + b];
+      costs[b] = (num > 0)? pseudo_costs_[2*i + b] / num : average_costs[b];
+    }
+    double score = MAX(epsilon, posteriors[i] * costs[0]) *
+      MAX(epsilon, (1.0 - posteriors[i]) * costs[1]);
+    if (score > best_score) {
+      best_score = score;
+      variable_to_branch = i;
+    }
+  }
+  if (variable_to_branch < 0) {
+    return SelectMostFractionalVariable(posteriors);
+  }
+  return variable_to_branch;
+}
+
+int FactorGraph::SelectStrongBranchingVariable(
+    const vector<double> &posteriors,
+    double value,
+    const AD3State &state,
+    double lower_bound) {
+  // Pick the most fractional candidates.
+  vector<pair<double, int> > candidates;
+  for (int i = 0; i < variables_.size(); ++i) {
+    if (evidence_[i] >= 0) continue;
+    if (NEARLY_BINARY(posteriors[i], 1e-6)) continue;
+    double diff = posteriors[i] - 0.5;
+    candidates.push_back(pair<double, int>(diff * diff, i));
+  }
+  if (candidates.size() == 0) return SelectMostFractionalVariable(posteriors);
+  sort(candidates.begin(), candidates.end());
+  if (candidates.size() > ad3_num_strong_branching_candidates_) {
+    candidates.resize(ad3_num_strong_branching_candidates_);
+  }
+
+  // Run a few iterations of AD3 on both children of each candidate.
+  int max_iterations = ad3_max_iterations_;
+  ad3_max_iterations_ = ad3_max_iterations_strong_branching_;
+  double epsilon = 1e-6;
+  int variable_to_branch = -1;
+  double best_score = -1.0;
+  vector<double> child_posteriors;
+  vector<double> child_additional_posteriors;
+  for (int k = 0; k < candidates.size(); ++k) {
+    int i = candidates[k].second;
+    double degradations[2];
+    for (int b = 0; b < 2; ++b) {
+      vector<int> evidence = evidence_;
+      vector<bool> active_links = active_links_;
+      vector<bool> active_factors = active_factors_;
+      vector<int> variables(1, i);
+      vector<int> values(1, b);
+      degradations[b] = 1e100;
+      if (FixVariables(variables, values)) {
+        double child_value, child_upper_bound;
+        int status = RunAD3(lower_bound, &child_posteriors,
+                            &child_additional_posteriors,
+                            &child_value, &child_upper_bound, &state);
+        if (status != STATUS_INFEASIBLE) {
+          degradations[b] = MAX(epsilon, value - child_value);
+        }
+      }
+      evidence_.swap(evidence);
+      active_links_.swap(active_links);
+      active_factors_.swap(active_factors);
+    }
+    double score = degradations[0] * degradations[1];
+    if (verbosity_ > 1) {
+      cout << "Strong branching candidate " << i
+           << " (degradations = " << degradations[0] << ", "
+           << degradations[1] << ")" << endl;
+    }
+    if (score > best_score) {
+      best_score = score;
+      variable_to_branch = i;
+    }
+  }
+  ad3_max_iterations_ = max_iterations;
+  return variable_to_branch;
+}
+
+bool FactorGraph::SelectBranchingGroup(const vector<double> &posteriors,
+                                       Branch *branch) {
+  // Collect the groups: states of multi-variables, and inputs of XOR
+  // factors without negated inputs.
+  vector<vector<int> > groups;
+  for (int k = 0; k < multi_variables_.size(); ++k) {
+    MultiVariable *multi_variable = multi_variables_[k];
+    vector<int> group;
+    for (int l = 0; l < multi_variable->GetNumStates(); ++l) {
+      group.push_back(multi_variable->GetState(l)->GetId());
+    }
+    groups.push_back(group);
+  }
+  for (int j = 0; j < factors_.size(); ++j) {
+    Factor *factor = factors_[j];
+    if (!active_factors_[j]) continue;
+    if (factor->type() != FactorTypes::FACTOR_XOR) continue;
+    vector<int> group;
+    for (int l = 0; l < factor->Degree(); ++l) {
+      if (factor->IsVariableNegated(l)) break;
+      group.push_back(factor->GetVariable(l)->GetId());
+    }
+    if (group.size() < factor->Degree()) continue;
+    groups.push_back(group);
+  }
+
+  // Pick the group whose mass is the most spread among its free states.
+  int best_group = -1;
+  double best_fractionality = 1e-6;
+  for (int k = 0; k < groups.size(); ++k) {
+    double mass = 0.0;
+    double max_mass = 0.0;
+    int num_free = 0;
+    for (int l = 0; l < groups[k].size(); ++l) {
+      int i = groups[k][l];
+      if (evidence_[i] >= 0) continue;
+      ++num_free;
+      mass += posteriors[i];
+      if (posteriors[i] > max_mass) max_mass = posteriors[i];
+    }
+    if (num_free < 2) continue;
+    double fractionality = mass - max_mass;
+    if (fractionality > best_fractionality) {
+      best_fractionality = fractionality;
+      best_group = k;
+    }
+  }
+  if (best_group < 0) return false;
+
+  // Split the free states in two halves of similar mass. In the first child
+  // the states of the second half are set to zero, and vice-versa.
+  vector<pair<double, int> > states;
+  double mass = 0.0;
+  for (int l = 0; l < groups[best_group].size(); ++l) {
+    int i = groups[best_group][l];
+    if (evidence_[i] >= 0) continue;
+    states.push_back(pair<double, int>(-posteriors[i], i));
+    mass += posteriors[i];
+  }
+  sort(states.begin(), states.end());
+  double cumulative_mass = 0.0;
+  for (int l = 0; l < states.size(); ++l) {
+    bool first_half = (l == 0) ||
+      (l < states.size() - 1 && cumulative_mass < 0.5 * mass);
+    cumulative_mass -= states[l].first;
+    branch->variables[first_half? 1 : 0].push_back(states[l].second);
+    branch->values[first_half? 1 : 0].push_back(0);
+  }
+  branch->variable = -1;
+  if (verbosity_ > 1) {
+    cout << "Branching on a group of " << states.size() << " states ("
+         << branch->variables[1].size() << " vs "
+         << branch->variables[0].size() << ")" << endl;
+  }
+  return true;
+}
+
+bool FactorGraph::SelectBranch(const vector<double> &posteriors,
+                               double value,
+                               const AD3State &state,
+                               double lower_bound,
+                               Branch *branch) {
+  branch->variable = -1;
+  for (int b = 0; b < 2; ++b) {
+    branch->variables[b].clear();
+    branch->values[b].clear();
+  }
+
+  if (ad3_branching_strategy_ == BRANCHING_GROUPS &&
+      SelectBranchingGroup(posteriors, branch)) {
+    return true;
+  }
+
+  int variable_to_branch = -1;
+  if (ad3_branching_strategy_ == BRANCHING_PSEUDO_COST) {
+    variable_to_branch = SelectPseudoCostVariable(posteriors);
+  } else if (ad3_branching_strategy_ == BRANCHING_STRONG) {
+    variable_to_branch = SelectStrongBranchingVariable(posteriors, value,
+                                                       state, lower_bound);
+  } else {
+    variable_to_branch = SelectMostFractionalVariable(posteriors);
+  }
+  if (variable_to_branch < 0) return false;
+
+  branch->variable = variable_to_branch;
+  for (int b = 0; b < 2; ++b) {
+    branch->variables[b].push_back(variable_to_branch);
+    branch->values[b].push_back(b);
+  }
+  return true;
+}
+
+int FactorGraph::RunBranchAndBound(int depth,
+                                   const AD3State *warm_start,
+                                   vector<double>* posteriors,
+                                   vector<double>* additional_posteriors,
+                                   double *value,
+                                   double *relaxation_value,
+                                   double *best_lower_bound,
+                                   double *best_upper_bound) {
+  int max_branching_depth = 5; // 2;
+
+  // Solve the LP relaxation (variables with evidence are fixed).
+  int status = RunAD3(*best_lower_bound,
+                      posteriors,
+                      additional_posteriors,
+                      value,
+                      best_upper_bound,
+                      warm_start);
+  *relaxation_value = *value;
+
+  if (status == STATUS_OPTIMAL_INTEGER) {
+    if (*value > *best_lower_bound) {
+      *best_lower_bound = *value;
+    }
+    return status;
+  } else if (status == STATUS_INFEASIBLE) {
+    *value = -1e100;
+    *best_upper_bound = -1e100;
+    return status;
+  }
+
+  // If every variable is fixed, the relaxation can still be fractional or
+  // unsolved, when a factor which ignores evidence rules out the fixed
+  // assignment. This node is a leaf: score the assignment directly.
+  bool all_fixed = true;
+  for (int i = 0; i < variables_.size(); ++i) {
+    if (evidence_[i] < 0) {
+      all_fixed = false;
+      break;
+    }
+  }
+  if (all_fixed) {
+    if (verbosity_ > 1) {
+      cout << "All variables fixed at depth " << depth << "." << endl;
+    }
+    vector<int> values(evidence_.begin(),
+                       evidence_.begin() + variables_.size());
+    // Each multi-variable must be in exactly one state.
+    bool feasible = true;
+    for (int k = 0; k < multi_variables_.size() && feasible; ++k) {
+      int num_active = 0;
+      for (int l = 0; l < multi_variables_[k]->GetNumStates(); ++l) {
+        num_active += values[multi_variables_[k]->GetState(l)->GetId()];
+      }
+      if (num_active != 1) feasible = false;
+    }
+    if (feasible) {
+      vector<int> additional_factor_offsets(factors_.size());
+      int offset = 0;
+      for (int j = 0; j < factors_.size(); ++j) {
+        additional_factor_offsets[j] = offset;
+        offset += factors_[j]->GetAdditionalLogPotentials().size();
+      }
+      additional_posteriors->assign(offset, 0.0);
+      feasible = EvaluateAssignment(values, additional_factor_offsets,
+                                    additional_posteriors, value);
+    }
+    if (!feasible) {
+      *value = -1e100;
+      *best_upper_bound = -1e100;
+      return STATUS_INFEASIBLE;
+    }
+    posteriors->assign(values.begin(), values.end());
+    *best_upper_bound = *value;
+    if (*value > *best_lower_bound) {
+      *best_lower_bound = *value;
+    }
+    return STATUS_OPTIMAL_INTEGER;
+  }
+
+  if (max_branching_depth >= 0 && depth > max_branching_depth) {
+    *value = -1e100;
+    *best_upper_bound = -1e100;
+    if (verbosity_ > 1) {
+        cout << "Maximum depth exceeded." << endl;
+    }
+    return STATUS_UNSOLVED;
+  }
+
+  // Both children are warm-started from the solution of this node.
+  // Only the states along the current path are kept in memory.
+  AD3State state;
+  SaveAD3State(&state);
+
+  Branch branch;
+  bool can_branch = SelectBranch(*posteriors, *value, state,
+                                 *best_lower_bound, &branch);
+  assert(can_branch);
+  if (verbosity_ > 1 && branch.variable >= 0) {
+      cout << "Branching on variable " << branch.variable
+           << " at depth " << depth
+           << " (value = " << (*posteriors)[branch.variable] << ")"
+           << endl;
+  }
+
+  // Solve the zero branch, then the one branch. For groups, the first
+  // child keeps the states with more mass.
+  status = STATUS_OPTIMAL_INTEGER;
+  vector<double> child_posteriors[2];
+  vector<double> child_additional_posteriors[2];
+  double child_values[2];
+  int child_status[2];
+  for (int b = 0; b < 2; ++b) {
+    vector<int> evidence = evidence_;
+    vector<bool> active_links = active_links_;
+    vector<bool> active_factors = active_factors_;
+    double child_relaxation_value;
+    double upper_bound;
+    if (FixVariables(branch.variables[b], branch.values[b])) {
+      child_status[b] = RunBranchAndBound(depth + 1,
+                                          &state,
+                                          &child_posteriors[b],
+                                          &child_additional_posteriors[b],
+                                          &child_values[b],
+                                          &child_relaxation_value,
+                                          best_lower_bound,
+                                          &upper_bound);
+    } else {
+      // The evidence is contradictory.
+      child_status[b] = STATUS_INFEASIBLE;
+      child_values[b] = -1e100;
+    }
+    evidence_.swap(evidence);
+    active_links_.swap(active_links);
+    active_factors_.swap(active_factors);
+
+    // Update the pseudo-costs with the degradation of the objective
+    // per unit of change in the branched variable.
+    if (branch.variable >= 0 && child_status[b] != STATUS_INFEASIBLE) {
+      double change = (b == 0)? (*posteriors)[branch.variable] :
+        1.0 - (*posteriors)[branch.variable];
+      if (change > 1e-6) {
+        double degradation = MAX(0.0, *value - child_relaxation_value);
+        pseudo_costs_[2*branch.variable + b] += degradation / change;
+        ++num_pseudo_costs_[2*branch.variable + b];
+      }
+    }
+
+    if (child_status[b] != STATUS_OPTIMAL_INTEGER &&
+        child_status[b] != STATUS_INFEASIBLE) {
+      status = STATUS_UNSOLVED;
+    }
+  }
+
+  DeleteAD3State(&state);
+
+  if (child_status[0] == STATUS_INFEASIBLE &&
+      child_status[1] == STATUS_INFEASIBLE) {
+    *value = -1e100;
+    return STATUS_INFEASIBLE;
+  }
+
+  int best = (child_values[0] >= child_values[1])? 0 : 1;
+  *value = child_values[best];
+  *posteriors = child_posteriors[best];
+  *additional_posteriors = child_additional_posteriors[best];
+
+  return status;
+}
+
+// Find the root of element i in a union-find forest (with path halving).
+static int FindRoot(vector<int> *parents, int i) {
+  while ((*parents)[i] != i) {
+    (*parents)[i] = (*parents)[(*parents)[i]];
+    i = (*parents)[i];
+  }
+  return i;
+}
+
+void FactorGraph::FindComponents(const vector<int> &variable_degrees,
+                                 vector<AD3Component> *components) {
+  // Union-find over variables and factors (factor j is node
+  // variables_.size() + j).
+  int num_variables = variables_.size();
+  int num_nodes = num_variables + factors_.size();
+  vector<int> parents(num_nodes);
+  vector<int> sizes(num_nodes, 1);
+  for (int i = 0; i < num_nodes; ++i) parents[i] = i;
+  for (int j = 0; j < factors_.size(); ++j) {
+    if (!IsFactorActive(j)) continue;
+    Factor *factor = factors_[j];
+    for (int i = 0; i < factor->Degree(); ++i) {
+      int r1 = FindRoot(&parents, num_variables + j);
+      int r2 = FindRoot(&parents, factor->GetVariable(i)->GetId());
+      if (r1 == r2) continue;
+      if (sizes[r1] < sizes[r2]) swap(r1, r2);
+      parents[r2] = r1;
+      sizes[r1] += sizes[r2];
+    }
+  }
+
+  // Number the components by decreasing number of links, so that the
+  // largest ones are scheduled first.
+  vector<int> num_links(num_nodes, 0);
+  vector<pair<int, int> > roots;
+  for (int j = 0; j < factors_.size(); ++j) {
+    if (!IsFactorActive(j)) continue;
+    int r = FindRoot(&parents, num_variables + j);
+    // Factors are counted too, so that factors without variables still
+    // make a component.
+    if (num_links[r] == 0) roots.push_back(pair<int, int>(0, r));
+    num_links[r] += factors_[j]->Degree() + 1;
+  }
+  for (int k = 0; k < roots.size(); ++k) {
+    roots[k].first = -num_links[roots[k].second];
+  }
+  sort(roots.begin(), roots.end());
+  vector<int> component_ids(num_nodes, -1);
+  components->clear();
+  components->resize(roots.size());
+  for (int k = 0; k < roots.size(); ++k) {
+    int r = roots[k].second;
+    component_ids[r] = k;
+    (*components)[k].num_links = 0;
+  }
+
+  for (int j = 0; j < factors_.size(); ++j) {
+    if (!IsFactorActive(j)) continue;
+    int k = component_ids[FindRoot(&parents, num_variables + j)];
+    (*components)[k].factors.push_back(j);
+    (*components)[k].num_links += factors_[j]->Degree();
+  }
+  for (int i = 0; i < num_variables; ++i) {
+    if (variable_degrees[i] == 0) continue;
+    int k = component_ids[FindRoot(&parents, i)];
+    (*components)[k].variables.push_back(i);
+  }
+}
+
+int FactorGraph::RunAD3(double lower_bound,
+                        vector<double> *posteriors,
+                        vector<double> *additional_posteriors,
+                        double *value,
+                        double *upper_bound,
+                        const AD3State *warm_start) {
+  timeval start, end;
+  gettimeofday(&start, NULL);
+
+  // Optimization status.
+  bool optimal = false;
+  bool reached_lower_bound = false;
+
+  AD3Workspace workspace;
+  workspace.factor_is_active.assign(factors_.size(), true);
+  workspace.variable_is_active.assign(variables_.size(), false);
+  workspace.maps_sum.assign(variables_.size(), 0.0);
+  if (ad3_solve_trees_exactly_) {
+    workspace.variable_nodes.assign(variables_.size(), -1);
+  }
+
+  // Variables with evidence (set by branch-and-bound) are fixed, and
+  // factors made inactive by the evidence are removed with their links.
+  bool use_evidence = !evidence_.empty();
+  vector<int> &variable_degrees = workspace.variable_degrees;
+  variable_degrees.resize(variables_.size());
+  int num_active_links = 0;
+  for (int i = 0; i < variables_.size(); ++i) {
+    BinaryVariable *variable = variables_[i];
+    variable_degrees[i] = 0;
+    for (int j = 0; j < variable->Degree(); ++j) {
+      if (!IsFactorActive(variable->GetFactor(j)->GetId())) continue;
+      ++variable_degrees[i];
+    }
+    num_active_links += variable_degrees[i];
+  }
+
+  // Compute extra score to account for variables that are not connected
+  // to any factor.
+  // TODO: Precompute the value of these variables and eliminate them
+  // from the pool.
+  double extra_score = 0.0;
+  for (int i = 0; i < variables_.size(); ++i) {
+    BinaryVariable *variable = variables_[i];
+    int variable_degree = variable_degrees[i];
+    double log_potential = variable->GetLogPotential();
+    if (variable_degree == 0 && GetEvidence(i) >= 0) {
+      extra_score += GetEvidence(i) * log_potential;
+    } else if (variable_degree == 0 && log_potential > 0) {
+      if (verbosity_ > 0 && variable->Degree() == 0) {
+        cout << "Warning: variable " << i << " is not linked to any factor."
+             << endl;
+      }
+      extra_score += log_potential;
+    }
+  }
+
+  posteriors->resize(variables_.size(), 0.0);
+
+  // Save room for the posteriors of additional variables. The additional
+  // log-potentials are read from the factors (rather than copied, since
+  // they may be tables shared by many factors).
+  vector<int> &additional_factor_offsets =
+    workspace.additional_factor_offsets;
+  int num_additionals =
+    ComputeAdditionalFactorOffsets(&additional_factor_offsets);
+  additional_posteriors->resize(num_additionals, 0.0);
+
+  // Additional information of inactive factors is fixed by the evidence.
+  for (int j = 0; j < factors_.size(); ++j) {
+    if (IsFactorActive(j)) continue;
+    int offset = additional_factor_offsets[j];
+    const vector<double> &additional_log_potentials =
+      factors_[j]->GetAdditionalLogPotentials();
+    for (int l = 0; l < additional_log_potentials.size(); ++l) {
+      int value = evidence_[variables_.size() + offset + l];
+      (*additional_posteriors)[offset + l] = (value > 0)? 1.0 : 0.0;
+      if (value > 0) extra_score += additional_log_potentials[l];
+    }
+  }
+
+  // Map indices of variables in factors.
+  vector<int> &indVinF = workspace.indVinF;
+  indVinF.assign(num_links_, -1);
+  for (int j = 0; j < factors_.size(); ++j) {
+    int factor_degree = factors_[j]->Degree();
+    for (int l = 0; l < factor_degree; ++l) {
+      indVinF[factors_[j]->GetLinkId(l)] = l;
+    }
+  }
+
+  double eta = ad3_eta_;
+  if (warm_start) {
+    // Start from a previous solution (e.g. the parent node in
+    // branch-and-bound), including the active sets of generic factors.
+    lambdas_ = warm_start->lambdas;
+    maps_ = warm_start->maps;
+    maps_av_ = warm_start->maps_av;
+    eta = warm_start->eta;
+    for (int j = 0; j < warm_start->active_sets.size(); ++j) {
+      if (!warm_start->saved_active_sets[j]) continue;
+      GenericFactor *factor = static_cast<GenericFactor*>(factors_[j]);
+      factor->RestoreActiveSet(warm_start->active_sets[j]);
+    }
+    for (int j = 0; j < factors_.size(); ++j) {
+      Factor *factor = factors_[j];
+      if (!IsFactorActive(j)) continue;
+      for (int i = 0; i < factor->Degree(); ++i) {
+        workspace.maps_sum[factor->GetVariable(i)->GetId()] +=
+          maps_[factor->GetLinkId(i)];
+      }
+    }
+    // The dual variables of a free variable must sum to zero over the
+    // active links; this may not hold if some factors became inactive.
     for (int i = 0; i < variables_.size(); ++i) {
-      variable_is_active[i] = false;
+      BinaryVariable *variable = variables_[i];
+      if (GetEvidence(i) >= 0 || variable_degrees[i] == 0) continue;
+      double sum = 0.0;
+      for (int j = 0; j < variable->Degree(); ++j) {
+        if (!IsFactorActive(variable->GetFactor(j)->GetId())) continue;
+        sum += lambdas_[variable->GetLinkId(j)];
+      }
+      sum /= static_cast<double>(variable_degrees[i]);
+      for (int j = 0; j < variable->Degree(); ++j) {
+        if (!IsFactorActive(variable->GetFactor(j)->GetId())) continue;
+        lambdas_[variable->GetLinkId(j)] -= sum;
+      }
+    }
+  } else {
+    lambdas_.clear();
+    lambdas_.resize(num_links_, 0.0);
+    maps_.clear();
+    maps_.resize(num_links_, 0.0);
+    maps_av_.clear();
+    maps_av_.resize(variables_.size(), 0.5);
+  }
+  if (use_evidence) {
+    for (int i = 0; i < variables_.size(); ++i) {
+      if (evidence_[i] >= 0) maps_av_[i] = evidence_[i];
     }
+  }
 
-    // Optimize over maps_.
+  // Independent parts of the graph are solved separately, so that small
+  // components stop as soon as they converge. Variables outside all
+  // components get their values right away.
+  vector<AD3Component> components;
+  if (ad3_decompose_components_) {
+    FindComponents(variable_degrees, &components);
+  }
+  if (components.size() > 1) {
+    for (int i = 0; i < variables_.size(); ++i) {
+      if (variable_degrees[i] > 0) continue;
+      if (GetEvidence(i) >= 0) {
+        maps_av_[i] = GetEvidence(i);
+      } else {
+        maps_av_[i] = (variables_[i]->GetLogPotential() > 0)? 1.0 : 0.0;
+      }
+      (*posteriors)[i] = maps_av_[i];
+    }
+  } else {
+    components.clear();
+    components.resize(1);
     for (int j = 0; j < factors_.size(); ++j) {
+      if (IsFactorActive(j)) components[0].factors.push_back(j);
+    }
+    for (int i = 0; i < variables_.size(); ++i) {
+      components[0].variables.push_back(i);
+    }
+    components[0].num_links = num_active_links;
+  }
+
+  int num_components = components.size();
+  if (num_components == 1) {
+    if (!ad3_solve_trees_exactly_ ||
+        !SolveTreeComponent(extra_score, eta, &workspace, &components[0],
+                            posteriors, additional_posteriors)) {
+      RunAD3Component(lower_bound, extra_score, eta, verbosity_ > 1,
+                      &workspace, &components[0],
+                      posteriors, additional_posteriors);
+    }
+  } else {
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+    for (int k = 0; k < num_components; ++k) {
+      if (ad3_solve_trees_exactly_ &&
+          SolveTreeComponent(0.0, eta, &workspace, &components[k],
+                             posteriors, additional_posteriors)) {
+        continue;
+      }
+      RunAD3Component(-1e100, 0.0, eta, false, &workspace, &components[k],
+                      posteriors, additional_posteriors);
+    }
+  }
+
+  // Combine the results of the components. The bound is the sum of the
+  // bounds of each component; the last stepsize is the one of the slowest
+  // component.
+  int t = 0;
+  int num_exact_components = 0;
+  double dual_obj_best = (num_components == 1)? 0.0 : extra_score;
+  optimal = true;
+  for (int k = 0; k < num_components; ++k) {
+    const AD3Component &component = components[k];
+    if (component.solved_exactly) ++num_exact_components;
+    dual_obj_best += component.upper_bound;
+    if (!component.optimal) optimal = false;
+    if (component.reached_lower_bound) reached_lower_bound = true;
+    if (k == 0 || component.num_iterations > t) {
+      t = component.num_iterations;
+      eta = component.eta;
+    }
+  }
+  if (reached_lower_bound || dual_obj_best < lower_bound) {
+    reached_lower_bound = true;
+    optimal = false;
+  }
+  if (verbosity_ > 1 && num_components > 1) {
+    cout << "Solved " << num_components << " components; the largest has "
+         << components[0].factors.size() << " factors." << endl;
+  }
+  if (verbosity_ > 1 && num_exact_components > 0) {
+    cout << "Solved " << num_exact_components
+         << " tree-structured components exactly." << endl;
+  }
+
+  bool fractional = false;
+  *value = 0.0;
+  for (int i = 0; i < variables_.size(); ++i) {
+    if (!NEARLY_BINARY((*posteriors)[i], 1e-12)) fractional = true;
+    *value += variables_[i]->GetLogPotential() * (*posteriors)[i];
+  }
+  for (int j = 0; j < factors_.size(); ++j) {
+    int offset = additional_factor_offsets[j];
+    const vector<double> &additional_log_potentials =
+      factors_[j]->GetAdditionalLogPotentials();
+    for (int l = 0; l < additional_log_potentials.size(); ++l) {
+      *value += additional_log_potentials[l] *
+        (*additional_posteriors)[offset + l];
+    }
+  }
+
+  if (verbosity_ > 1) {
+    cout << "Solution value after "
+         << t << " iterations (AD3) = "
+         << *value << endl;
+  }
+  *upper_bound = dual_obj_best;
+  last_num_iterations_ += t;
+  ad3_last_eta_ = eta;
+
+  gettimeofday(&end, NULL);
+  if (verbosity_ > 1) {
+    cout << "Took " << ((double) diff_ms(end,start))/1000.0 << " sec." << endl;
+  }
+
+  if (optimal) {
+    if (!fractional) {
+      if (verbosity_ > 1) {
+        cout << "Solution is integer." << endl;
+      }
+      return STATUS_OPTIMAL_INTEGER;
+    } else {
+      if (verbosity_ > 1) {
+        cout << "Solution is fractional." << endl;
+      }
+      return STATUS_OPTIMAL_FRACTIONAL;
+    }
+  } else {
+    if (reached_lower_bound) {
+      if (verbosity_ > 1) {
+        cout << "Reached lower bound: " << lower_bound << "." << endl;
+      }
+      return STATUS_INFEASIBLE;
+    } else {
+      if (verbosity_ > 1) {
+        cout << "Solution is only approximate." << endl;
+      }
+      return STATUS_UNSOLVED;
+    }
+  }
+}
+
+void FactorGraph::RunAD3Component(double lower_bound,
+                                  double extra_score,
+                                  double eta,
+                                  bool print_log,
+                                  AD3Workspace *workspace,
+                                  AD3Component *component,
+                                  vector<double> *posteriors,
+                                  vector<double> *additional_posteriors) {
+  timeval start, end;
+  gettimeofday(&start, NULL);
+
+  // Stopping criterion parameters.
+  double residual_threshold = ad3_residual_threshold_; // 1e-6;
+  //double gap_threshold = 1e-6;
+
+  // Stepsize adjustment parameters.
+  double max_eta = 100.0;
+  double min_eta = 1e-3;
+  double gamma_primal = 100.0; // 10.0
+  double gamma_dual = 10.0;
+  double factor_step = 2.0;
+  double tau = 1.0;
+  int num_iterations_adapt_eta = 10; // 1
+
+  // Caching parameters.
+  vector<char> &factor_is_active = workspace->factor_is_active;
+  vector<char> &variable_is_active = workspace->variable_is_active;
+  int num_iterations_reset = 50;
+  double cache_tolerance = 1e-12;
+  bool caching = true; // true
+
+  // Optimization status.
+  bool optimal = false;
+  bool reached_lower_bound = false;
+
+  // Miscellaneous.
+  vector<double> log_potentials;
+  vector<double> factor_variable_posteriors;
+  vector<double> factor_additional_posteriors;
+  bool eta_changed = true;
+  vector<double> &maps_sum = workspace->maps_sum;
+  int t;
+  double dual_obj_best = 1e100, primal_rel_obj_best = -1e100;
+  double primal_obj_best = -1e100;
+  int num_iterations_compute_dual = 50;
+
+  bool use_evidence = !evidence_.empty();
+  const vector<int> &variable_degrees = workspace->variable_degrees;
+  const vector<int> &indVinF = workspace->indVinF;
+  const vector<int> &additional_factor_offsets =
+    workspace->additional_factor_offsets;
+  const vector<int> &factors = component->factors;
+  const vector<int> &variables = component->variables;
+  int num_active_links = component->num_links;
+
+  for (t = 0; t < ad3_max_iterations_; ++t) {
+    int num_inactive_factors = 0;
+
+    // Initialize all variables as inactive.
+    for (int r = 0; r < variables.size(); ++r) {
+      variable_is_active[variables[r]] = false;
+    }
+
+    // Optimize over maps_.
+    for (int s = 0; s < factors.size(); ++s) {
+      int j = factors[s];
+
       // Skip inactive factors, but periodically update everything.
       // TODO: actually use num_iterations_reset somewhere
-      if ((0 != (t % num_iterations_reset)) && 
+      if ((0 != (t % num_iterations_reset)) &&
           !eta_changed && !factor_is_active[j]) {
         ++num_inactive_factors;
         continue;
@@ -953,8 +2168,8 @@ int FactorGraph::RunAD3(double lower_bound,
           int m = factor->GetLinkId(i);
           BinaryVariable* variable = factor->GetVariable(i);
           int k = variable->GetId();
-          int variable_degree = variable->Degree();
-          double val = variable->GetLogPotential() / 
+          int variable_degree = variable_degrees[k];
+          double val = variable->GetLogPotential() /
             static_cast<double>(variable_degree)
             + 2.0 * lambdas_[m];
           (*cached_log_potentials)[i] = maps_av_[k] + val / (2.0 * eta);
@@ -994,31 +2209,38 @@ int FactorGraph::RunAD3(double lower_bound,
     // Optimize over maps_av and update Lagrange multipliers.
     double primal_residual = 0.0;
     double dual_residual = 0.0;
-    for (int i = 0; i < variables_.size(); ++i) {
+    for (int r = 0; r < variables.size(); ++r) {
+      int i = variables[r];
       BinaryVariable *variable = variables_[i];
-      int variable_degree = variable->Degree();
+      int variable_degree = variable_degrees[i];
+      int fixed_value = GetEvidence(i);
 
       if (!variable_is_active[i]) {
         // TODO: precompute values of these variables beforehand.
-        if (variable_degree == 0) {
+        if (fixed_value >= 0) {
+          maps_av_[i] = fixed_value;
+        } else if (variable_degree == 0) {
           maps_av_[i] = (variable->GetLogPotential() > 0)? 1.0 : 0.0;
         }
         // Make sure dual_residual = 0 and maps_av_[i] does not change.
-        continue; 
+        continue;
       }
 
       double map_av_prev = maps_av_[i];
-      if (variable_degree == 0) {
+      if (fixed_value >= 0) {
+        maps_av_[i] = fixed_value;
+      } else if (variable_degree == 0) {
         maps_av_[i] = (variable->GetLogPotential() > 0)? 1.0 : 0.0;
       } else {
         maps_av_[i] = maps_sum[i] / static_cast<double>(variable_degree);
       }
       double diff = maps_av_[i] - map_av_prev;
       dual_residual += variable_degree * diff * diff;
-      for (int j = 0; j < variable_degree; ++j) {
+      for (int j = 0; j < variable->Degree(); ++j) {
         int m = variable->GetLinkId(j);
         Factor* factor = variable->GetFactor(j);
         int k = factor->GetId();
+        if (!IsFactorActive(k)) continue;
         double diff_penalty = maps_[m] - maps_av_[i];
         int l = indVinF[m];
         vector<double> *cached_log_potentials =
@@ -1031,10 +2253,10 @@ int FactorGraph::RunAD3(double lower_bound,
         primal_residual += diff_penalty * diff_penalty;
       }
     }
-    primal_residual = sqrt(primal_residual / lambdas_.size()); 
-    dual_residual = sqrt(dual_residual / lambdas_.size());
+    primal_residual = sqrt(primal_residual / MAX(1, num_active_links));
+    dual_residual = sqrt(dual_residual / MAX(1, num_active_links));
 
-    // If primal residual is low enough or enough iterations 
+    // If primal residual is low enough or enough iterations
     // have passed, compute the dual.
     bool compute_dual = false;
     bool compute_primal_rel = false;
@@ -1051,8 +2273,8 @@ int FactorGraph::RunAD3(double lower_bound,
     double dual_obj = 1e100;
     if (compute_dual) {
       dual_obj = 0.0;
-      for (int j = 0; j < factors_.size(); ++j) {
-        Factor *factor = factors_[j];
+      for (int s = 0; s < factors.size(); ++s) {
+        Factor *factor = factors_[factors[s]];
         int factor_degree = factor->Degree();
         log_potentials.resize(factor_degree);
         factor_variable_posteriors.resize(factor_degree);
@@ -1062,8 +2284,8 @@ int FactorGraph::RunAD3(double lower_bound,
         for (int i = 0; i < factor_degree; ++i) {
           int m = factor->GetLinkId(i);
           BinaryVariable *variable = factor->GetVariable(i);
-          int variable_degree = variable->Degree();
-          log_potentials[i] = variable->GetLogPotential() / 
+          int variable_degree = variable_degrees[variable->GetId()];
+          log_potentials[i] = variable->GetLogPotential() /
             static_cast<double>(variable_degree)
             + 2.0 * lambdas_[m];
           delta -= lambdas_[m];
@@ -1073,21 +2295,49 @@ int FactorGraph::RunAD3(double lower_bound,
                          factor->GetAdditionalLogPotentials(),
                          &factor_variable_posteriors,
                          &factor_additional_posteriors,
-                         &val); 
+                         &val);
         dual_obj += val + delta;
       }
       dual_obj += extra_score;
+
+      // With evidence, the dual variables of the fixed variables (and of
+      // free variables whose factors were removed) need not sum to zero.
+      if (use_evidence) {
+        for (int r = 0; r < variables.size(); ++r) {
+          int i = variables[r];
+          BinaryVariable *variable = variables_[i];
+          if (variable_degrees[i] == 0) continue;
+          double sum = 0.0;
+          for (int j = 0; j < variable->Degree(); ++j) {
+            if (!IsFactorActive(variable->GetFactor(j)->GetId())) continue;
+            sum += lambdas_[variable->GetLinkId(j)];
+          }
+          if (evidence_[i] >= 0) {
+            dual_obj += sum * (1.0 - 2.0 * evidence_[i]);
+          } else {
+            dual_obj += fabs(sum);
+          }
+        }
+      }
     }
 
     // Compute relaxed primal objective.
     double primal_rel_obj = -1e100;
     if (compute_primal_rel) {
       primal_rel_obj = 0.0;
-      for (int i = 0; i < variables_.size(); ++i) {
+      for (int r = 0; r < variables.size(); ++r) {
+        int i = variables[r];
         primal_rel_obj += maps_av_[i] * variables_[i]->GetLogPotential();
       }
-      for (int i = 0; i < additional_log_potentials.size(); ++i) {
-        primal_rel_obj += (*additional_posteriors)[i] * additional_log_potentials[i];
+      for (int s = 0; s < factors.size(); ++s) {
+        int j = factors[s];
+        int offset = additional_factor_offsets[j];
+        const vector<double> &additional_log_potentials =
+          factors_[j]->GetAdditionalLogPotentials();
+        for (int l = 0; l < additional_log_potentials.size(); ++l) {
+          primal_rel_obj += (*additional_posteriors)[offset + l] *
+            additional_log_potentials[l];
+        }
       }
     }
 
@@ -1103,7 +2353,8 @@ int FactorGraph::RunAD3(double lower_bound,
 
     if (dual_obj_best > dual_obj) {
       dual_obj_best = dual_obj;
-      for (int i = 0; i < variables_.size(); ++i) {
+      for (int r = 0; r < variables.size(); ++r) {
+        int i = variables[r];
         (*posteriors)[i] = maps_av_[i];
       }
       if (dual_obj_best < lower_bound) {
@@ -1112,11 +2363,11 @@ int FactorGraph::RunAD3(double lower_bound,
       }
     }
     if (primal_rel_obj_best < primal_rel_obj) {
-      primal_rel_obj_best = primal_rel_obj; 
+      primal_rel_obj_best = primal_rel_obj;
     }
     if (compute_dual) {
       gettimeofday(&end, NULL);
-      if (verbosity_ > 1) { 
+      if (print_log) {
         cout << "Iteration = " << t
              << "\tDual obj = " << dual_obj
              << "\tPrimal rel obj = " << primal_rel_obj
@@ -1126,22 +2377,23 @@ int FactorGraph::RunAD3(double lower_bound,
              << "\tBest dual obj = " << dual_obj_best
              << "\tBest primal rel obj = " << primal_rel_obj_best
              << "\tBest primal obj = " << primal_obj_best
-             << "\tCached factors = " << 
+             << "\tCached factors = " <<
           static_cast<double>(num_inactive_factors) /
-          static_cast<double>(factors_.size())
+          static_cast<double>(factors.size())
              << "\teta = " << eta
-             << "\tChanged eta = " << (eta_changed? "true" : "false") 
+             << "\tChanged eta = " << (eta_changed? "true" : "false")
              << "\tTime = " << ((double) diff_ms(end,start))/1000.0 << " sec."
-             << endl; 
+             << endl;
       }
     }
     //double gap = dual_obj_best - primal_rel_obj_best;
 
     // If both primal and dual residuals fall below a threshold,
     // we are done. TODO: also use gap?
-    if (dual_residual < residual_threshold && 
+    if (dual_residual < residual_threshold &&
         primal_residual < residual_threshold) {
-      for (int i = 0; i < variables_.size(); ++i) {
+      for (int r = 0; r < variables.size(); ++r) {
+        int i = variables[r];
         (*posteriors)[i] = maps_av_[i];
       }
       optimal = true;
@@ -1165,53 +2417,328 @@ int FactorGraph::RunAD3(double lower_bound,
     }
   }
 
-  bool fractional = false;
-  *value = 0.0;
-  for (int i = 0; i < variables_.size(); ++i) {
-    if (!NEARLY_BINARY((*posteriors)[i], 1e-12)) fractional = true;
-    *value += variables_[i]->GetLogPotential() * (*posteriors)[i];
-  }
-  for (int i = 0; i < additional_log_potentials.size(); ++i) {
-    *value += additional_log_potentials[i] * (*additional_posteriors)[i];
+  component->optimal = optimal;
+  component->reached_lower_bound = reached_lower_bound;
+  component->upper_bound = dual_obj_best;
+  component->eta = eta;
+  component->num_iterations = t;
+  component->solved_exactly = false;
+}
+
+
+bool FactorGraph::SolveTreeComponent(double extra_score,
+                                     double eta,
+                                     AD3Workspace *workspace,
+                                     AD3Component *component,
+                                     vector<double> *posteriors,
+                                     vector<double> *additional_posteriors) {
+  const vector<int> &factors = component->factors;
+  vector<int> &variable_nodes = workspace->variable_nodes;
+  int num_factors = factors.size();
+
+  // Group the variables into nodes: the states of each multi-variable
+  // of a dense factor (or the inputs of a XOR factor, which then acts as
+  // a unary factor) make a node, and each variable of a PAIR factor
+  // makes a binary node. A node lists its variables (a binary node has
+  // a single one) and the factors list their nodes.
+  vector<int> node_sizes;
+  vector<bool> node_binary;
+  vector<int> node_offsets(1, 0);
+  vector<int> node_variables;
+  vector<int> factor_offsets(1, 0);
+  vector<int> factor_nodes;
+  vector<int> group_sizes;
+  for (int s = 0; s < num_factors; ++s) {
+    Factor *factor = factors_[factors[s]];
+    group_sizes.clear();
+    if (factor->type() == FactorTypes::FACTOR_MULTI_DENSE) {
+      FactorDense *factor_dense = static_cast<FactorDense*>(factor);
+      for (int k = 0; k < factor_dense->GetNumMultiVariables(); ++k) {
+        group_sizes.push_back(
+          factor_dense->GetMultiVariable(k)->GetNumStates());
+      }
+    } else if (factor->type() == FactorTypes::FACTOR_XOR) {
+      if (factor->Degree() == 0) return false;
+      for (int l = 0; l < factor->Degree(); ++l) {
+        if (factor->IsVariableNegated(l)) return false;
+      }
+      group_sizes.push_back(factor->Degree());
+    }
+    if (!group_sizes.empty()) {
+      int offset = 0;
+      for (int k = 0; k < group_sizes.size(); ++k) {
+        int num_states = group_sizes[k];
+        int node = variable_nodes[factor->GetVariable(offset)->GetId()];
+        if (node < 0) {
+          node = node_sizes.size();
+          node_sizes.push_back(num_states);
+          node_binary.push_back(false);
+          for (int l = 0; l < num_states; ++l) {
+            int i = factor->GetVariable(offset + l)->GetId();
+            if (variable_nodes[i] >= 0) return false;
+            variable_nodes[i] = node;
+            node_variables.push_back(i);
+          }
+          node_offsets.push_back(node_variables.size());
+        } else {
+          // The node must be the same multi-variable.
+          if (node_binary[node] || node_sizes[node] != num_states) {
+            return false;
+          }
+          for (int l = 0; l < num_states; ++l) {
+            if (node_variables[node_offsets[node] + l] !=
+                factor->GetVariable(offset + l)->GetId()) return false;
+          }
+        }
+        factor_nodes.push_back(node);
+        offset += num_states;
+      }
+    } else if (factor->type() == FactorTypes::FACTOR_PAIR) {
+      for (int l = 0; l < 2; ++l) {
+        if (factor->IsVariableNegated(l)) return false;
+        int i = factor->GetVariable(l)->GetId();
+        int node = variable_nodes[i];
+        if (node < 0) {
+          node = node_sizes.size();
+          node_sizes.push_back(2);
+          node_binary.push_back(true);
+          variable_nodes[i] = node;
+          node_variables.push_back(i);
+          node_offsets.push_back(node_variables.size());
+        } else if (!node_binary[node]) {
+          return false;
+        }
+        factor_nodes.push_back(node);
+      }
+    } else {
+      return false;
+    }
+    factor_offsets.push_back(factor_nodes.size());
   }
+  int num_nodes = node_sizes.size();
 
-  if (verbosity_ > 1) {
-    cout << "Solution value after "
-         << t << " iterations (AD3) = "
-         << *value << endl;
+  // Factors linked to each node.
+  vector<int> node_factor_offsets(num_nodes + 1, 0);
+  for (int l = 0; l < factor_nodes.size(); ++l) {
+    ++node_factor_offsets[factor_nodes[l] + 1];
+  }
+  for (int n = 0; n < num_nodes; ++n) {
+    node_factor_offsets[n + 1] += node_factor_offsets[n];
+  }
+  vector<int> node_factors(factor_nodes.size());
+  vector<int> positions(node_factor_offsets.begin(),
+                        node_factor_offsets.end() - 1);
+  for (int f = 0; f < num_factors; ++f) {
+    for (int l = factor_offsets[f]; l < factor_offsets[f + 1]; ++l) {
+      node_factors[positions[factor_nodes[l]]++] = f;
+    }
   }
-  *upper_bound = dual_obj_best;
 
-  gettimeofday(&end, NULL);
-  if (verbosity_ > 1) {
-    cout << "Took " << ((double) diff_ms(end,start))/1000.0 << " sec." << endl;
+  // Traverse each tree from a root node, keeping the factors in
+  // breadth-first order. Meeting a node or a factor twice means there
+  // is a cycle.
+  vector<int> node_parents(num_nodes, -2); // Parent factor (-1 for roots).
+  vector<int> factor_parents(num_factors, -1); // Position of parent node.
+  vector<int> roots;
+  vector<int> order;
+  vector<int> queue_nodes;
+  for (int r = 0; r < num_nodes; ++r) {
+    if (node_parents[r] != -2) continue;
+    roots.push_back(r);
+    node_parents[r] = -1;
+    queue_nodes.assign(1, r);
+    for (int q = 0; q < queue_nodes.size(); ++q) {
+      int n = queue_nodes[q];
+      for (int l = node_factor_offsets[n]; l < node_factor_offsets[n + 1];
+           ++l) {
+        int f = node_factors[l];
+        if (f == node_parents[n]) continue;
+        if (factor_parents[f] >= 0) return false;
+        order.push_back(f);
+        bool found_parent = false;
+        for (int k = factor_offsets[f]; k < factor_offsets[f + 1]; ++k) {
+          int m = factor_nodes[k];
+          if (m == n && !found_parent) {
+            factor_parents[f] = k - factor_offsets[f];
+            found_parent = true;
+            continue;
+          }
+          if (node_parents[m] != -2) return false;
+          node_parents[m] = f;
+          queue_nodes.push_back(m);
+        }
+      }
+    }
   }
 
-  if (optimal) {
-    if (!fractional) {
-      if (verbosity_ > 1) {
-        cout << "Solution is integer." << endl;
+  // Initialize the beliefs of the nodes with the variable log-potentials;
+  // values ruled out by the evidence get -1e100.
+  vector<int> value_offsets(num_nodes + 1, 0);
+  for (int n = 0; n < num_nodes; ++n) {
+    value_offsets[n + 1] = value_offsets[n] + node_sizes[n];
+  }
+  vector<double> beliefs(value_offsets[num_nodes]);
+  for (int n = 0; n < num_nodes; ++n) {
+    double *node_beliefs = &beliefs[value_offsets[n]];
+    if (node_binary[n]) {
+      int i = node_variables[node_offsets[n]];
+      node_beliefs[0] = 0.0;
+      node_beliefs[1] = variables_[i]->GetLogPotential();
+      if (GetEvidence(i) >= 0) node_beliefs[1 - GetEvidence(i)] = -1e100;
+      continue;
+    }
+    int fixed_state = -1;
+    for (int l = 0; l < node_sizes[n]; ++l) {
+      int i = node_variables[node_offsets[n] + l];
+      node_beliefs[l] = variables_[i]->GetLogPotential();
+      if (GetEvidence(i) == 0) node_beliefs[l] = -1e100;
+      if (GetEvidence(i) == 1) fixed_state = l;
+    }
+    if (fixed_state >= 0) {
+      for (int l = 0; l < node_sizes[n]; ++l) {
+        if (l != fixed_state) node_beliefs[l] = -1e100;
       }
-      return STATUS_OPTIMAL_INTEGER;
+    }
+  }
+
+  // Upward pass: each factor sends to its parent node the max-marginals
+  // of its subtree, remembering the best configuration for each value of
+  // the parent.
+  vector<int> best_offsets(num_factors + 1, 0);
+  for (int f = 0; f < num_factors; ++f) {
+    int parent = factor_nodes[factor_offsets[f] + factor_parents[f]];
+    best_offsets[f + 1] = best_offsets[f] + node_sizes[parent];
+  }
+  vector<int> best_configurations(best_offsets[num_factors], -1);
+  vector<double> best_scores;
+  vector<int> states;
+  double pair_table[4] = {0.0, 0.0, 0.0, 0.0};
+  vector<double> xor_table;
+  for (int o = order.size() - 1; o >= 0; --o) {
+    int f = order[o];
+    Factor *factor = factors_[factors[f]];
+    const double *table;
+    if (factor->type() == FactorTypes::FACTOR_PAIR) {
+      pair_table[3] = static_cast<FactorPAIR*>(factor)->GetLogPotential();
+      table = pair_table;
+    } else if (factor->type() == FactorTypes::FACTOR_XOR) {
+      xor_table.assign(factor->Degree(), 0.0);
+      table = &xor_table[0];
     } else {
-      if (verbosity_ > 1) {
-        cout << "Solution is fractional." << endl;
+      table = &factor->GetAdditionalLogPotentials()[0];
+    }
+    const int *nodes = &factor_nodes[factor_offsets[f]];
+    int degree = factor_offsets[f + 1] - factor_offsets[f];
+    int parent_position = factor_parents[f];
+    int parent = nodes[parent_position];
+    int num_configurations = 1;
+    for (int k = 0; k < degree; ++k) num_configurations *= node_sizes[nodes[k]];
+
+    int *best = &best_configurations[best_offsets[f]];
+    best_scores.assign(node_sizes[parent], -1e100);
+    states.assign(degree, 0);
+    for (int index = 0; index < num_configurations; ++index) {
+      double score = table[index];
+      for (int k = 0; k < degree; ++k) {
+        if (k == parent_position) continue;
+        score += beliefs[value_offsets[nodes[k]] + states[k]];
+      }
+      int value = states[parent_position];
+      if (best[value] < 0 || score > best_scores[value]) {
+        best[value] = index;
+        best_scores[value] = score;
+      }
+      // Next configuration (the last node changes faster).
+      for (int k = degree - 1; k >= 0; --k) {
+        if (++states[k] < node_sizes[nodes[k]]) break;
+        states[k] = 0;
       }
-      return STATUS_OPTIMAL_FRACTIONAL;
     }
-  } else {
-    if (reached_lower_bound) {
-      if (verbosity_ > 1) {
-        cout << "Reached lower bound: " << lower_bound << "." << endl;
+    for (int l = 0; l < node_sizes[parent]; ++l) {
+      beliefs[value_offsets[parent] + l] += best_scores[l];
+    }
+  }
+
+  // Decode the roots and then the rest of the trees top-down.
+  vector<int> node_values(num_nodes, -1);
+  vector<int> factor_configurations(num_factors, -1);
+  double value = 0.0;
+  for (int t = 0; t < roots.size(); ++t) {
+    int r = roots[t];
+    int best = 0;
+    for (int l = 1; l < node_sizes[r]; ++l) {
+      if (beliefs[value_offsets[r] + l] > beliefs[value_offsets[r] + best]) {
+        best = l;
       }
-      return STATUS_INFEASIBLE;
+    }
+    node_values[r] = best;
+    value += beliefs[value_offsets[r] + best];
+  }
+  for (int o = 0; o < order.size(); ++o) {
+    int f = order[o];
+    const int *nodes = &factor_nodes[factor_offsets[f]];
+    int degree = factor_offsets[f + 1] - factor_offsets[f];
+    int parent_position = factor_parents[f];
+    int index = best_configurations[best_offsets[f] +
+                                    node_values[nodes[parent_position]]];
+    factor_configurations[f] = index;
+    for (int k = degree - 1; k >= 0; --k) {
+      if (k != parent_position) {
+        node_values[nodes[k]] = index % node_sizes[nodes[k]];
+      }
+      index /= node_sizes[nodes[k]];
+    }
+  }
+  bool infeasible = (value < -1e99);
+
+  // Write the solution.
+  for (int n = 0; n < num_nodes; ++n) {
+    for (int l = node_offsets[n]; l < node_offsets[n + 1]; ++l) {
+      int i = node_variables[l];
+      if (node_binary[n]) {
+        maps_av_[i] = node_values[n];
+      } else {
+        maps_av_[i] = (l - node_offsets[n] == node_values[n])? 1.0 : 0.0;
+      }
+      (*posteriors)[i] = maps_av_[i];
+    }
+  }
+  for (int r = 0; r < component->variables.size(); ++r) {
+    int i = component->variables[r];
+    if (workspace->variable_degrees[i] > 0) continue;
+    if (GetEvidence(i) >= 0) {
+      maps_av_[i] = GetEvidence(i);
     } else {
-      if (verbosity_ > 1) {
-        cout << "Solution is only approximate." << endl;
+      maps_av_[i] = (variables_[i]->GetLogPotential() > 0)? 1.0 : 0.0;
+    }
+    (*posteriors)[i] = maps_av_[i];
+  }
+  for (int f = 0; f < num_factors; ++f) {
+    int j = factors[f];
+    Factor *factor = factors_[j];
+    for (int i = 0; i < factor->Degree(); ++i) {
+      maps_[factor->GetLinkId(i)] = maps_av_[factor->GetVariable(i)->GetId()];
+    }
+    int offset = workspace->additional_factor_offsets[j];
+    int num_additional = factor->GetAdditionalLogPotentials().size();
+    if (factor->type() == FactorTypes::FACTOR_PAIR) {
+      (*additional_posteriors)[offset] =
+        (factor_configurations[f] == 3)? 1.0 : 0.0;
+    } else {
+      for (int l = 0; l < num_additional; ++l) {
+        (*additional_posteriors)[offset + l] =
+          (l == factor_configurations[f])? 1.0 : 0.0;
       }
-      return STATUS_UNSOLVED;
     }
   }
+
+  component->optimal = !infeasible;
+  component->reached_lower_bound = infeasible;
+  component->upper_bound = infeasible? -1e100 : value + extra_score;
+  component->eta = eta;
+  component->num_iterations = 0;
+  component->solved_exactly = true;
+  return true;
 }
 
 
@@ -16,10 +16,15 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
 
+#ifndef FACTOR_GRAPH_H_
+#define FACTOR_GRAPH_H_
+
 #include <iostream>
 #include "Factor.h"
 #include "GenericFactor.h"
 #include "FactorDense.h"
+#include "FactorPairDense.h"
+#include "FactorSparse.h"
 
 namespace AD3 {
 
@@ -30,13 +35,45 @@ enum OptimizationStatus {
   STATUS_UNSOLVED
 };
 
+// Strategies for choosing where to branch in SolveExactMAPWithAD3.
+enum BranchingStrategy {
+  // Branch on the variable whose value is closest to 0.5.
+  BRANCHING_MOST_FRACTIONAL = 0,
+  // Branch on the variable with the largest estimated degradation of the
+  // objective, learned from previous branchings (pseudo-costs).
+  BRANCHING_PSEUDO_COST,
+  // Try the most fractional candidates with a few iterations of AD3
+  // and branch on the one whose children degrade the objective the most.
+  BRANCHING_STRONG,
+  // Branch on multi-variables and XOR factors, splitting their states
+  // in two groups.
+  BRANCHING_GROUPS
+};
+
+// Stepsize rules of the projected subgradient algorithm (PSDD).
+enum PSDDStepsizeRule {
+  // eta / sqrt(t+1), where t is the iteration.
+  PSDD_STEPSIZE_SQRT = 0,
+  // eta / (k+1), where k is the number of times the dual objective
+  // did not decrease.
+  PSDD_STEPSIZE_ADAPTIVE,
+  // Polyak's stepsize, using the best primal objective as an estimate of
+  // the optimal value (eta scales the step).
+  PSDD_STEPSIZE_POLYAK
+};
+
 class FactorGraph {
  public:
   FactorGraph() {
     verbosity_ = 0;
     num_links_ = 0;
+    num_threads_ = 1;
+    ad3_use_warm_start_ = false;
+    last_upper_bound_ = 1e100;
+    last_num_iterations_ = 0;
     ResetParametersAD3();
     ResetParametersPSDD();
+    ResetParametersMPLP();
   }
   ~FactorGraph() {
     for (int i = 0; i < variables_.size(); ++i) {
@@ -48,11 +85,31 @@ class FactorGraph {
     for (int i = 0; i < factors_.size(); ++i) {
       if (owned_factors_[i]) delete factors_[i];
     }
+    for (int i = 0; i < shared_log_potentials_.size(); ++i) {
+      delete shared_log_potentials_[i];
+    }
   }
 
   // Set verbosity level.
   void SetVerbosity(int verbosity) { verbosity_ = verbosity; }
 
+  // Set the number of threads used to solve independent subproblems
+  // (requires OpenMP; 1 means serial).
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
+  // Reserve space for a number of binary variables, multi-variables and
+  // factors, when it is known in advance (e.g. from the header of a file).
+  void ReserveVariables(int num_variables) {
+    variables_.reserve(num_variables);
+  }
+  void ReserveMultiVariables(int num_multi_variables) {
+    multi_variables_.reserve(num_multi_variables);
+  }
+  void ReserveFactors(int num_factors) {
+    factors_.reserve(num_factors);
+    owned_factors_.reserve(num_factors);
+  }
+
   // Create a new state (binary variable).
   BinaryVariable *CreateBinaryVariable() {
     BinaryVariable *variable = new BinaryVariable;
@@ -293,10 +350,12 @@ class FactorGraph {
   // Create a new dense factor.
   // All additional log-potentials are assumed to be in the following order:
   // scores[0,0,...,0], scores[0,0,...,1], etc.
+  // Factors linking two multi-variables use a specialized QP solver.
   Factor *CreateFactorDense(const vector<MultiVariable*> &multi_variables,
                             const vector<double> &additional_log_potentials,
                             bool owned_by_graph = true) {
-    Factor *factor = new FactorDense;
+    Factor *factor = (multi_variables.size() == 2)?
+      new FactorPairDense : new FactorDense;
     vector<BinaryVariable*> variables;
     for (int i = 0; i < multi_variables.size(); ++i) {
       variables.insert(variables.end(),
@@ -310,12 +369,65 @@ class FactorGraph {
     return factor;
   }
 
+  // Create a new dense factor whose additional log-potentials are a table
+  // shared with other factors (see CreateSharedLogPotentials).
+  Factor *CreateFactorDense(const vector<MultiVariable*> &multi_variables,
+                            SharedLogPotentials *additional_log_potentials,
+                            bool owned_by_graph = true) {
+    Factor *factor = CreateFactorDense(multi_variables, vector<double>(),
+                                       owned_by_graph);
+    assert(additional_log_potentials->GetValues().size() ==
+           static_cast<FactorDense*>(factor)->GetNumConfigurations());
+    factor->SetSharedAdditionalLogPotentials(additional_log_potentials);
+    return factor;
+  }
+
+  // Create a table of additional log-potentials which can be shared by
+  // several factors, instead of each factor keeping its own copy. The table
+  // is owned by the graph, and cannot be modified.
+  // Only the potentials are shared: the posteriors of the additional
+  // variables (and the active set of the QP) are still kept per factor, so
+  // memory still grows with the number of factors times the table size.
+  SharedLogPotentials *CreateSharedLogPotentials(
+    const vector<double> &additional_log_potentials) {
+    SharedLogPotentials *table =
+      new SharedLogPotentials(additional_log_potentials);
+    shared_log_potentials_.push_back(table);
+    return table;
+  }
+
+  // Create a new sparse factor, where only the configurations listed in
+  // configurations (the states of each one, one after the other) are
+  // allowed. There is one additional log-potential per allowed
+  // configuration.
+  Factor *CreateFactorSparse(const vector<MultiVariable*> &multi_variables,
+                             const vector<int> &configurations,
+                             const vector<double> &additional_log_potentials,
+                             bool owned_by_graph = true) {
+    Factor *factor = new FactorSparse;
+    vector<BinaryVariable*> variables;
+    for (int i = 0; i < multi_variables.size(); ++i) {
+      variables.insert(variables.end(),
+                       multi_variables[i]->GetStates().begin(),
+                       multi_variables[i]->GetStates().end());
+    }
+    vector<bool> negated;
+    DeclareFactor(factor, variables, negated, owned_by_graph);
+    static_cast<FactorSparse*>(factor)->Initialize(multi_variables,
+                                                   configurations);
+    factor->SetAdditionalLogPotentials(additional_log_potentials);
+    return factor;
+  }
+
   // Count variables/factors.
   int GetNumVariables() { return variables_.size(); }
+  int GetNumMultiVariables() { return multi_variables_.size(); }
   int GetNumFactors() { return factors_.size(); }
+  int GetNumLinks() { return num_links_; }
 
   // Get variables/factors.
   BinaryVariable *GetBinaryVariable(int i) { return variables_[i]; }
+  MultiVariable *GetMultiVariable(int i) { return multi_variables_[i]; }
   Factor *GetFactor(int i) { return factors_[i]; }
 
   // Get primal/dual variables.
@@ -323,6 +435,46 @@ class FactorGraph {
   const vector<double> &GetLocalPrimalVariables() { return maps_; }
   const vector<double> &GetGlobalPrimalVariables() { return maps_av_; }
 
+  // Get the value of eta at the end of the last run of AD3.
+  double GetLastEtaAD3() { return ad3_last_eta_; }
+
+  // Get the upper bound on the MAP value (the best value of the dual)
+  // found by the last run of AD3, PSDD or MPLP.
+  double GetLastUpperBound() { return last_upper_bound_; }
+
+  // Get the number of iterations of the last run of AD3, PSDD or MPLP (for
+  // AD3, those of the component which took the most; for the exact MAP,
+  // the sum over the nodes of the branch-and-bound).
+  int GetLastNumIterations() { return last_num_iterations_; }
+
+  // Round the posteriors to an assignment (the state with the largest
+  // posterior for each multi-variable, and a threshold of 0.5 for the
+  // other binary variables) and compute its score, which is a lower bound
+  // on the MAP value. Returns false if the assignment violates a hard
+  // constraint.
+  bool EvaluateRoundedPosteriors(const vector<double> &posteriors,
+                                 double *value);
+
+  // Start the next run of SolveLPMAPWithAD3 from the given dual variables,
+  // local and global primal variables and eta (e.g. the state saved by a
+  // previous run on the same graph), instead of from scratch. The state is
+  // ignored if variables or factors are added in the meantime.
+  void SetWarmStartAD3(const vector<double> &dual_variables,
+                       const vector<double> &local_primal_variables,
+                       const vector<double> &global_primal_variables,
+                       double eta) {
+    assert(dual_variables.size() == num_links_);
+    assert(local_primal_variables.size() == num_links_);
+    assert(global_primal_variables.size() == variables_.size());
+    ad3_warm_start_.lambdas = dual_variables;
+    ad3_warm_start_.maps = local_primal_variables;
+    ad3_warm_start_.maps_av = global_primal_variables;
+    ad3_warm_start_.eta = eta;
+    ad3_warm_start_.active_sets.clear();
+    ad3_warm_start_.saved_active_sets.clear();
+    ad3_use_warm_start_ = true;
+  }
+
   // Check if there is any multi-variable which does not
   // belong to any factor, and if so, assign a XOR factor
   // to the corresponding binary variables.
@@ -357,7 +509,7 @@ class FactorGraph {
     }
   }
 
-  // Set options of AD3/PSDD algorithms.
+  // Set options of AD3/PSDD/MPLP algorithms.
   void SetMaxIterationsAD3(int max_iterations) {
     ad3_max_iterations_ = max_iterations;
   }
@@ -366,16 +518,66 @@ class FactorGraph {
   void SetResidualThresholdAD3(double threshold) {
     ad3_residual_threshold_ = threshold;
   }
+  void SetDecomposeComponentsAD3(bool decompose) {
+    ad3_decompose_components_ = decompose;
+  }
+  void SetSolveTreesExactlyAD3(bool solve_exactly) {
+    ad3_solve_trees_exactly_ = solve_exactly;
+  }
   void SetMaxIterationsPSDD(int max_iterations) {
     psdd_max_iterations_ = max_iterations;
   }
   void SetEtaPSDD(double eta) { psdd_eta_ = eta; }
+  void SetStepsizeRulePSDD(int rule) { psdd_stepsize_rule_ = rule; }
+  void SetMaxIterationsMPLP(int max_iterations) {
+    mplp_max_iterations_ = max_iterations;
+  }
+  void SetDualThresholdMPLP(double threshold) {
+    mplp_dual_threshold_ = threshold;
+  }
+
+  // Set options of the branch-and-bound (SolveExactMAPWithAD3).
+  void SetBranchingStrategyAD3(int strategy) {
+    ad3_branching_strategy_ = strategy;
+  }
+  void SetNumStrongBranchingCandidatesAD3(int num_candidates) {
+    ad3_num_strong_branching_candidates_ = num_candidates;
+  }
+  void SetMaxIterationsStrongBranchingAD3(int max_iterations) {
+    ad3_max_iterations_strong_branching_ = max_iterations;
+  }
 
   int SolveLPMAPWithAD3(vector<double> *posteriors,
                         vector<double> *additional_posteriors,
                         double *value) {
     double upper_bound;
-    return RunAD3(-1e100, posteriors, additional_posteriors, value, &upper_bound);
+    last_num_iterations_ = 0;
+    if (ad3_use_warm_start_) {
+      ad3_use_warm_start_ = false;
+      // The state is only valid if the graph did not change after it was
+      // set.
+      if (ad3_warm_start_.lambdas.size() != num_links_ ||
+          ad3_warm_start_.maps_av.size() != variables_.size()) {
+        if (verbosity_ > 0) {
+          cout << "Warning: the factor graph changed; "
+               << "ignoring the warm start." << endl;
+        }
+        ad3_warm_start_ = AD3State();
+        int status = RunAD3(-1e100, posteriors, additional_posteriors, value,
+                            &upper_bound);
+        last_upper_bound_ = upper_bound;
+        return status;
+      }
+      int status = RunAD3(-1e100, posteriors, additional_posteriors, value,
+                          &upper_bound, &ad3_warm_start_);
+      ad3_warm_start_ = AD3State();
+      last_upper_bound_ = upper_bound;
+      return status;
+    }
+    int status = RunAD3(-1e100, posteriors, additional_posteriors, value,
+                        &upper_bound);
+    last_upper_bound_ = upper_bound;
+    return status;
   }
 
   int SolveExactMAPWithAD3(vector<double> *posteriors,
@@ -383,16 +585,38 @@ class FactorGraph {
                            double *value) {
     double best_lower_bound = -1e100;
     double upper_bound;
-    vector<bool> branched_variables(variables_.size(), false);
+    double relaxation_value;
     int depth = 0;
-    int status = RunBranchAndBound(0.0,
-                                   branched_variables,
-                                   depth,
+    last_num_iterations_ = 0;
+
+    // Branching fixes variables by setting evidence, which is propagated
+    // through the factors without transforming the factor graph.
+    int num_additional = 0;
+    for (int j = 0; j < factors_.size(); ++j) {
+      num_additional += factors_[j]->GetAdditionalLogPotentials().size();
+    }
+    evidence_.assign(variables_.size() + num_additional, -1);
+    InitializeEvidenceBuffers();
+    active_links_.assign(num_links_, true);
+    active_factors_.assign(factors_.size(), true);
+    pseudo_costs_.assign(2 * variables_.size(), 0.0);
+    num_pseudo_costs_.assign(2 * variables_.size(), 0);
+
+    int status = RunBranchAndBound(depth,
+                                   NULL,
                                    posteriors,
                                    additional_posteriors,
                                    value,
+                                   &relaxation_value,
                                    &best_lower_bound,
                                    &upper_bound);
+
+    evidence_.clear();
+    active_links_.clear();
+    active_factors_.clear();
+    evidence_offsets_.clear();
+    factor_in_queue_.clear();
+    last_upper_bound_ = upper_bound;
     if (verbosity_ > 1) {
       cout << "Solution value for AD3 ILP: " << *value << endl;
     }
@@ -402,45 +626,236 @@ class FactorGraph {
   int SolveLPMAPWithPSDD(vector<double> *posteriors,
                          vector<double> *additional_posteriors,
                          double *value) {
-    // Add code here for tuning the stepsize.
     double upper_bound;
-    return RunPSDD(-1e100, posteriors, additional_posteriors, value, &upper_bound);
+    last_num_iterations_ = 0;
+    int status = RunPSDD(-1e100, posteriors, additional_posteriors, value,
+                         &upper_bound);
+    last_upper_bound_ = upper_bound;
+    return status;
+  }
+
+  // Solve the dual of the LP-MAP relaxation by block coordinate descent
+  // (MPLP). The posteriors are the integer assignment decoded from the
+  // beliefs; the status is STATUS_OPTIMAL_INTEGER only if the decoded
+  // assignment is certified optimal by the dual.
+  int SolveLPMAPWithMPLP(vector<double> *posteriors,
+                         vector<double> *additional_posteriors,
+                         double *value) {
+    double upper_bound;
+    last_num_iterations_ = 0;
+    int status = RunMPLP(-1e100, posteriors, additional_posteriors, value,
+                         &upper_bound);
+    last_upper_bound_ = upper_bound;
+    return status;
   }
 
  private:
+  // State of AD3 saved at a branch-and-bound node, used to warm-start
+  // the runs of its children. One active set is kept per factor (empty
+  // for non-generic factors or factors that cannot copy configurations).
+  struct AD3State {
+    vector<double> lambdas;
+    vector<double> maps;
+    vector<double> maps_av;
+    double eta;
+    vector<ActiveSetState> active_sets;
+    vector<bool> saved_active_sets;
+  };
+
+  // Branching decision: the variables fixed in each of the two children
+  // of a node and their values. For single-variable branching, variable
+  // is the branched variable (-1 otherwise).
+  struct Branch {
+    vector<int> variables[2];
+    vector<int> values[2];
+    int variable;
+  };
+
+  // Connected component of the factor graph (active factors and the
+  // variables linked to them), on which AD3 runs with its own stepsize
+  // and stopping criterion. The other fields store the result of the run.
+  struct AD3Component {
+    vector<int> factors;
+    vector<int> variables;
+    int num_links;
+    bool optimal;
+    bool reached_lower_bound;
+    double upper_bound;
+    double eta;
+    int num_iterations;
+    bool solved_exactly;
+  };
+
+  // Data of a run of AD3 shared by all the components. Everything is
+  // indexed by global variable/factor/link ids; since components are
+  // disjoint, they can be solved concurrently.
+  struct AD3Workspace {
+    vector<int> variable_degrees;
+    vector<int> indVinF;
+    vector<int> additional_factor_offsets;
+    vector<double> maps_sum;
+    vector<char> factor_is_active;
+    vector<char> variable_is_active;
+    // Node of each variable in a tree component (see SolveTreeComponent).
+    vector<int> variable_nodes;
+  };
+
   void ResetParametersAD3() {
     ad3_eta_ = 0.1;
     ad3_adapt_eta_ = true;
     ad3_max_iterations_ = 1000;
     ad3_residual_threshold_ = 1e-6;
+    ad3_decompose_components_ = true;
+    ad3_solve_trees_exactly_ = true;
+    ad3_branching_strategy_ = BRANCHING_MOST_FRACTIONAL;
+    ad3_num_strong_branching_candidates_ = 4;
+    ad3_max_iterations_strong_branching_ = 50;
+    ad3_last_eta_ = ad3_eta_;
   }
 
   void ResetParametersPSDD() {
     psdd_eta_ = 1.0;
     psdd_max_iterations_ = 1000;
+    psdd_stepsize_rule_ = PSDD_STEPSIZE_SQRT;
+  }
+
+  void ResetParametersMPLP() {
+    mplp_max_iterations_ = 1000;
+    mplp_dual_threshold_ = 1e-9;
   }
 
   void CopyAdditionalLogPotentials(vector<double>* additional_log_potentials,
                                    vector<int>* factor_indices);
 
+  // Compute the positions of the additional log-potentials of each factor
+  // in the vector given by CopyAdditionalLogPotentials, without copying
+  // them; returns the size of that vector.
+  int ComputeAdditionalFactorOffsets(vector<int>* factor_indices);
+
+  // Make the decoded values of each multi-variable one-hot, choosing the
+  // state with the largest score.
+  void DecodeMultiVariables(const vector<double> &scores,
+                            double tie_threshold,
+                            vector<int> *values);
+
+  // Compute the score of an assignment of the binary variables, along with
+  // the best assignment of the additional variables. Returns false if
+  // the assignment is infeasible.
+  bool EvaluateAssignment(const vector<int> &values,
+                          const vector<int> &additional_factor_offsets,
+                          vector<double> *additional_posteriors,
+                          double *value);
+
+  // Compute the MAP of a factor with its cached log-potentials (used by
+  // PSDD), recomputing them first if required.
+  void SolveCachedFactor(Factor *factor, bool recompute_cache, double *value);
+
+  // Propagate evidence through the factors until nothing changes.
+  // Updates the evidence of variables and additional information, and
+  // disables links and factors. Factors which do not support evidence
+  // are left untouched. If variables is not NULL, only the factors linked
+  // to those variables (which got new evidence) are examined at first;
+  // such incremental calls only cost the factors they visit, and must
+  // follow a call to InitializeEvidenceBuffers (or a full propagation,
+  // with variables = NULL) on the same graph.
+  // Returns false if a contradiction was found.
+  bool PropagateEvidence(const vector<int> *variables,
+                         vector<int> *evidence,
+                         vector<bool> *active_links,
+                         vector<bool> *active_factors,
+                         int *num_visits);
+
+  // Set up the buffers of PropagateEvidence for the current graph.
+  void InitializeEvidenceBuffers();
+
+  // Evidence set by branch-and-bound (empty otherwise).
+  int GetEvidence(int i) { return evidence_.empty()? -1 : evidence_[i]; }
+  bool IsFactorActive(int j) {
+    return active_factors_.empty() || active_factors_[j];
+  }
+
+  // Fix variables to the given values and propagate the evidence.
+  // Returns false if the evidence is contradictory.
+  bool FixVariables(const vector<int> &variables, const vector<int> &values);
+
+  // Choose the two children of a node according to the branching strategy.
+  // Returns false if there is no free variable left (RunBranchAndBound
+  // treats such nodes as leaves before branching).
+  bool SelectBranch(const vector<double> &posteriors,
+                    double value,
+                    const AD3State &state,
+                    double lower_bound,
+                    Branch *branch);
+  int SelectMostFractionalVariable(const vector<double> &posteriors);
+  int SelectPseudoCostVariable(const vector<double> &posteriors);
+  int SelectStrongBranchingVariable(const vector<double> &posteriors,
+                                    double value,
+                                    const AD3State &state,
+                                    double lower_bound);
+  bool SelectBranchingGroup(const vector<double> &posteriors,
+                            Branch *branch);
+
   int RunPSDD(double lower_bound,
               vector<double> *posteriors,
               vector<double> *additional_posteriors,
               double *value,
               double *upper_bound);
 
+  int RunMPLP(double lower_bound,
+              vector<double> *posteriors,
+              vector<double> *additional_posteriors,
+              double *value,
+              double *upper_bound);
+
+  // Save/delete the state left by the last run of AD3.
+  void SaveAD3State(AD3State *state);
+  void DeleteAD3State(AD3State *state);
+
+  // If warm_start is not NULL, the dual variables, the stepsize and the
+  // active sets of the factors are initialized from that state.
   int RunAD3(double lower_bound,
              vector<double> *posteriors,
              vector<double> *additional_posteriors,
              double *value,
-             double *upper_bound);
-
-  int RunBranchAndBound(double cumulative_value,
-                        vector<bool> &branched_variables,
-                        int depth,
+             double *upper_bound,
+             const AD3State *warm_start = NULL);
+
+  // Split the active part of the factor graph into connected components,
+  // larger components first. Variables not linked to any active factor
+  // are left out.
+  void FindComponents(const vector<int> &variable_degrees,
+                      vector<AD3Component> *components);
+
+  // Run the AD3 iterations on a single component, starting from the
+  // current lambdas_, maps_ and maps_av_ and from stepsize eta.
+  void RunAD3Component(double lower_bound,
+                       double extra_score,
+                       double eta,
+                       bool print_log,
+                       AD3Workspace *workspace,
+                       AD3Component *component,
+                       vector<double> *posteriors,
+                       vector<double> *additional_posteriors);
+
+  // If the component is a tree of dense and PAIR factors (with
+  // multi-variables as nodes), solve it exactly by max-sum dynamic
+  // programming and return true. Returns false (without changing
+  // anything) otherwise.
+  bool SolveTreeComponent(double extra_score,
+                          double eta,
+                          AD3Workspace *workspace,
+                          AD3Component *component,
+                          vector<double> *posteriors,
+                          vector<double> *additional_posteriors);
+
+  // Solve the subproblem defined by the current evidence. The value of
+  // its LP relaxation (before branching) is returned in relaxation_value.
+  int RunBranchAndBound(int depth,
+                        const AD3State *warm_start,
                         vector<double>* posteriors,
                         vector<double>* additional_posteriors,
                         double *value,
+                        double *relaxation_value,
                         double *best_lower_bound,
                         double *best_upper_bound);
 
@@ -449,12 +864,16 @@ class FactorGraph {
   vector<MultiVariable*> multi_variables_;
   vector<Factor*> factors_;
   vector<bool> owned_factors_;
+  vector<SharedLogPotentials*> shared_log_potentials_;
   int num_links_;
 
   // Verbosity level. 0 only displays error/warning messages,
   // 1 displays info messages, >1 displays additional info.
   int verbosity_;
 
+  // Number of threads for solving independent subproblems.
+  int num_threads_;
+
   // Parameters for AD3:
   int ad3_max_iterations_; // Maximum number of iterations.
   double ad3_eta_; // Initial penalty parameter of the augmented Lagrangian.
@@ -463,15 +882,60 @@ class FactorGraph {
   bool ad3_adapt_eta_;
   // Threshold for primal/dual residuals.
   double ad3_residual_threshold_;
+  // If true, each connected component is solved separately.
+  bool ad3_decompose_components_;
+  // If true, tree-structured components are solved exactly by dynamic
+  // programming instead of running AD3.
+  bool ad3_solve_trees_exactly_;
+  // Value of eta at the end of the last run of AD3.
+  double ad3_last_eta_;
+  // Upper bound and number of iterations of the last run of AD3, PSDD or
+  // MPLP.
+  double last_upper_bound_;
+  int last_num_iterations_;
+  // Branching strategy for the branch-and-bound.
+  int ad3_branching_strategy_;
+  // Number of candidates and number of AD3 iterations for strong branching.
+  int ad3_num_strong_branching_candidates_;
+  int ad3_max_iterations_strong_branching_;
+  // State set by SetWarmStartAD3 for the next run of AD3.
+  bool ad3_use_warm_start_;
+  AD3State ad3_warm_start_;
 
   // Parameters for PSDD:
   int psdd_max_iterations_; // Maximum number of iterations.
   double psdd_eta_; // Initial stepsize.
+  int psdd_stepsize_rule_; // Stepsize rule.
+
+  // Parameters for MPLP:
+  int mplp_max_iterations_; // Maximum number of iterations.
+  // Stop when the relative decrease of the dual objective falls below
+  // this threshold.
+  double mplp_dual_threshold_;
 
-  // Parameters for AD3 and PSDD:
+  // Parameters for AD3, PSDD and MPLP:
   vector<double> lambdas_;
   vector<double> maps_;
   vector<double> maps_av_;
+
+  // State of the branch-and-bound: evidence for variables and additional
+  // information (-1 means no evidence), active links and factors, and
+  // pseudo-costs (sum and count, for the zero and one branches of each
+  // variable).
+  vector<int> evidence_;
+  vector<bool> active_links_;
+  vector<bool> active_factors_;
+  vector<double> pseudo_costs_;
+  vector<int> num_pseudo_costs_;
+
+  // Buffers of PropagateEvidence, kept across the calls of the
+  // branch-and-bound: the offset of the additional information of each
+  // factor in the evidence (computed by each full propagation), and
+  // whether each factor is in the queue (all false between calls).
+  vector<int> evidence_offsets_;
+  vector<bool> factor_in_queue_;
 };
 
 } // namespace AD3
+
+#endif // FACTOR_GRAPH_H_
@@ -0,0 +1,111 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FACTOR_GRAPH_BINARY_H_
+#define FACTOR_GRAPH_BINARY_H_
+
+#include <stdint.h>
+
+namespace AD3 {
+
+// Layout of the binary format of factor graphs (see FactorGraphWriter and
+// FactorGraphReader::ReadGraphBinary).
+//
+// A file is a sequence of graphs. Each graph is a block which starts with
+// a BinaryGraphHeader, followed by the sections listed in
+// BinaryGraphSections. Every section is a plain array in the byte order of
+// the machine that wrote it, starting at an offset (from the start of the
+// block) which is a multiple of 8; the size of the block is also a multiple
+// of 8. A mapped file can therefore be read in place, without parsing.
+//
+// Factors are stored by type (see FactorTypes) and links. Their parameters
+// are kept in two pools, one of integers and one of reals, and their
+// additional log-potentials in a pool of tables, which dense factors can
+// share:
+//   BUDGET: integers = { budget }.
+//   KNAPSACK: reals = { budget, cost of each link }.
+//   PAIR: table = { edge log-potential }.
+//   DENSE: integers = { number of multi-variables, their ids };
+//   table = scores.
+//   SPARSE: integers = { number of multi-variables, their ids, states of
+//   each allowed configuration }; table = scores.
+// XOR, OR, OROUT and ATMOSTONE have no parameters (XOROUT, ANDOUT and
+// IMPLY are stored through the negated links).
+//
+// The state of AD3 (dual variables, local and global primal variables and
+// eta) is optional.
+static const char kBinaryGraphMagic[8] = { 'A', 'D', '3', 'G',
+                                           'R', 'A', 'P', 'H' };
+static const uint32_t kBinaryGraphVersion = 1;
+static const uint32_t kBinaryGraphByteOrder = 0x01020304;
+
+enum BinaryGraphFlags {
+  BINARY_GRAPH_SOLVER_STATE = 1
+};
+
+enum BinaryGraphSections {
+  // double[num_variables].
+  SECTION_VARIABLE_LOG_POTENTIALS = 0,
+  // int32[num_multi_variables + 1], int32[] (ids of the states).
+  SECTION_MULTI_VARIABLE_OFFSETS,
+  SECTION_MULTI_VARIABLE_STATES,
+  // int32[num_factors], int32[num_factors + 1].
+  SECTION_FACTOR_TYPES,
+  SECTION_FACTOR_LINK_OFFSETS,
+  // int32[num_links], uint8[num_links].
+  SECTION_LINK_VARIABLES,
+  SECTION_LINK_NEGATED,
+  // int32[num_factors + 1], int32[].
+  SECTION_FACTOR_INTEGER_OFFSETS,
+  SECTION_INTEGERS,
+  // int32[num_factors + 1], double[].
+  SECTION_FACTOR_REAL_OFFSETS,
+  SECTION_REALS,
+  // int32[num_factors] (-1 if none), int64[num_tables + 1], double[].
+  SECTION_FACTOR_TABLES,
+  SECTION_TABLE_OFFSETS,
+  SECTION_TABLE_VALUES,
+  // double[num_links], double[num_links], double[num_variables],
+  // double[1]; empty without BINARY_GRAPH_SOLVER_STATE.
+  SECTION_DUAL_VARIABLES,
+  SECTION_LOCAL_PRIMAL_VARIABLES,
+  SECTION_GLOBAL_PRIMAL_VARIABLES,
+  SECTION_ETA,
+  NUM_BINARY_GRAPH_SECTIONS
+};
+
+struct BinaryGraphHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  // Size of the block, including the header.
+  uint64_t size;
+  uint64_t flags;
+  int64_t num_variables;
+  int64_t num_multi_variables;
+  int64_t num_factors;
+  int64_t num_links;
+  int64_t num_tables;
+  // Offset and size (in bytes) of each section.
+  uint64_t section_offsets[NUM_BINARY_GRAPH_SECTIONS];
+  uint64_t section_sizes[NUM_BINARY_GRAPH_SECTIONS];
+};
+
+} // namespace AD3
+
+#endif // FACTOR_GRAPH_BINARY_H_
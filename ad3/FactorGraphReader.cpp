@@ -0,0 +1,1019 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <fstream>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "FactorGraphReader.h"
+#include "FactorGraphBinary.h"
+#include "Utils.h"
+
+namespace AD3 {
+
+// Parse an integer, as strtol would. Numbers outside the range of int
+// are rejected. The magnitude is accumulated as unsigned, since -INT_MIN
+// is not an int.
+bool ParseInt(const char *begin, const char *end, int *value) {
+  const char *p = begin;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    ++p;
+  }
+  if (p == end) return false;
+  unsigned int limit = negative?
+    static_cast<unsigned int>(INT_MAX) + 1u :
+    static_cast<unsigned int>(INT_MAX);
+  unsigned int result = 0;
+  for (; p < end; ++p) {
+    if (*p < '0' || *p > '9') return false;
+    unsigned int digit = *p - '0';
+    if (result > (limit - digit) / 10) return false;
+    result = 10 * result + digit;
+  }
+  if (!negative) {
+    *value = static_cast<int>(result);
+  } else {
+    *value = (result == limit)? INT_MIN : -static_cast<int>(result);
+  }
+  return true;
+}
+
+// Parse a double. Numbers with at most 15 significant digits and a decimal
+// exponent of at most 22 (in absolute value) are exactly the product or
+// quotient of two doubles, which is correctly rounded (Clinger's fast
+// path). The others are passed to strtod.
+bool ParseDouble(const char *begin, const char *end, double *value) {
+  static const double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const char *p = begin;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    ++p;
+  }
+
+  // Read the digits. Zeros after the last nonzero digit are kept pending,
+  // so that they do not count as significant digits.
+  double mantissa = 0.0;
+  int num_significant_digits = 0;
+  int num_pending_zeros = 0;
+  int exponent = 0;
+  int num_digits = 0;
+  bool fraction = false;
+  bool fast = true;
+  for (; p < end; ++p) {
+    if (*p == '.' && !fraction) {
+      fraction = true;
+      continue;
+    }
+    if (*p < '0' || *p > '9') break;
+    ++num_digits;
+    if (fraction) --exponent;
+    int digit = *p - '0';
+    if (digit == 0) {
+      if (num_significant_digits > 0) ++num_pending_zeros;
+      continue;
+    }
+    num_significant_digits += num_pending_zeros + 1;
+    if (num_significant_digits > 15) {
+      fast = false;
+      continue;
+    }
+    for (; num_pending_zeros > 0; --num_pending_zeros) mantissa *= 10.0;
+    mantissa = 10.0 * mantissa + digit;
+  }
+  exponent += num_pending_zeros;
+
+  // Read the exponent.
+  if (num_digits > 0 && p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool negative_exponent = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      negative_exponent = (*p == '-');
+      ++p;
+    }
+    if (p == end) fast = false;
+    int explicit_exponent = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+      if (explicit_exponent < 100000) {
+        explicit_exponent = 10 * explicit_exponent + (*p - '0');
+      }
+    }
+    exponent += negative_exponent? -explicit_exponent : explicit_exponent;
+  }
+
+  if (fast && num_digits > 0 && p == end) {
+    if (mantissa == 0.0) {
+      *value = negative? -0.0 : 0.0;
+      return true;
+    }
+    if (exponent >= -22 && exponent <= 22) {
+      double result = (exponent >= 0)?
+        mantissa * kPowersOfTen[exponent] :
+        mantissa / kPowersOfTen[-exponent];
+      *value = negative? -result : result;
+      return true;
+    }
+  }
+
+  // Slow path (includes inf, nan, and malformed numbers).
+  string token(begin, end);
+  char *token_end;
+  *value = strtod(token.c_str(), &token_end);
+  return token_end == token.c_str() + token.size() && !token.empty();
+}
+
+FactorGraphReader::FactorGraphReader() {
+  data_ = NULL;
+  size_ = 0;
+  mapped_ = false;
+  position_ = NULL;
+  end_ = NULL;
+  num_variables_ = 0;
+  num_factors_ = 0;
+  evidence_log_potential_ = 0.0;
+}
+
+bool FactorGraphReader::Open(const string &filename) {
+  Close();
+#if !defined(_WIN32)
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat status;
+  if (fstat(fd, &status) < 0) {
+    close(fd);
+    return false;
+  }
+  size_ = status.st_size;
+  if (size_ > 0) {
+    void *data = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(data);
+      mapped_ = true;
+    }
+  }
+  close(fd);
+#endif
+  if (!mapped_) {
+    // Read the whole file.
+    ifstream file(filename.c_str(), ios_base::in | ios_base::binary);
+    if (!file.is_open()) return false;
+    file.seekg(0, ios_base::end);
+    size_ = file.tellg();
+    file.seekg(0, ios_base::beg);
+    char *data = new char[size_ + 1];
+    file.read(data, size_);
+    data_ = data;
+  }
+  position_ = data_;
+  end_ = data_ + size_;
+  return true;
+}
+
+void FactorGraphReader::Close() {
+  if (data_) {
+#if !defined(_WIN32)
+    if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+    if (!mapped_) delete[] data_;
+  }
+  data_ = NULL;
+  size_ = 0;
+  mapped_ = false;
+  position_ = NULL;
+  end_ = NULL;
+  shared_tables_.clear();
+}
+
+void FactorGraphReader::SkipBlanks(bool newlines) {
+  while (position_ < end_) {
+    char c = *position_;
+    if (c == ' ' || c == '\t' || c == '\r') {
+      ++position_;
+    } else if (c == '#') {
+      // Skip the comment, up to the end of the line.
+      const char *newline = static_cast<const char*>(
+        memchr(position_, '\n', end_ - position_));
+      position_ = newline? newline : end_;
+    } else if (c == '\n' && newlines) {
+      ++position_;
+    } else {
+      break;
+    }
+  }
+}
+
+void FactorGraphReader::SkipLine() {
+  const char *newline = static_cast<const char*>(
+    memchr(position_, '\n', end_ - position_));
+  position_ = newline? newline + 1 : end_;
+}
+
+bool FactorGraphReader::NextToken(const char **begin, const char **end,
+                                  bool newlines) {
+  SkipBlanks(newlines);
+  if (position_ == end_ || *position_ == '\n') return false;
+  *begin = position_;
+  while (position_ < end_) {
+    char c = *position_;
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '#') break;
+    ++position_;
+  }
+  *end = position_;
+  return true;
+}
+
+bool FactorGraphReader::ReadInt(int *value, bool newlines) {
+  const char *begin, *end;
+  if (!NextToken(&begin, &end, newlines)) return false;
+  return ParseInt(begin, end, value);
+}
+
+bool FactorGraphReader::ReadDouble(double *value, bool newlines) {
+  const char *begin, *end;
+  if (!NextToken(&begin, &end, newlines)) return false;
+  return ParseDouble(begin, end, value);
+}
+
+SharedLogPotentials *FactorGraphReader::GetSharedLogPotentials(
+  const vector<double> &additional_log_potentials,
+  FactorGraph *factor_graph) {
+  SharedLogPotentialsMap::iterator it =
+    shared_tables_.find(&additional_log_potentials);
+  if (it != shared_tables_.end()) return it->second;
+  SharedLogPotentials *table =
+    factor_graph->CreateSharedLogPotentials(additional_log_potentials);
+  shared_tables_[&table->GetValues()] = table;
+  return table;
+}
+
+int FactorGraphReader::ReadGraph(FactorGraph *factor_graph) {
+  shared_tables_.clear();
+
+  // Read the number of variables and factors, skipping blank lines between
+  // graphs.
+  SkipBlanks(true);
+  if (position_ == end_) return -1;
+  if (!ReadInt(&num_variables_, true)) return -1;
+  SkipLine();
+  if (!ReadInt(&num_factors_, true)) return -1;
+  SkipLine();
+  factor_graph->ReserveVariables(num_variables_);
+  factor_graph->ReserveFactors(num_factors_);
+
+  // Read variable log-potentials.
+  vector<BinaryVariable*> variables(num_variables_);
+  for (int i = 0; i < num_variables_; ++i) {
+    double log_potential;
+    if (!ReadDouble(&log_potential, true)) return -1;
+    SkipLine();
+    BinaryVariable *variable = factor_graph->CreateBinaryVariable();
+    variable->SetLogPotential(log_potential);
+    variables[i] = variable;
+  }
+
+  // Read factors.
+  vector<BinaryVariable*> binary_variables;
+  vector<bool> negated;
+  vector<double> additional_log_potentials;
+  for (int i = 0; i < num_factors_; ++i) {
+    SkipBlanks(true);
+    const char *line = position_;
+    const char *type_begin, *type_end;
+    if (!NextToken(&type_begin, &type_end, false)) return -1;
+    string type(type_begin, type_end);
+
+    // Read linked variables.
+    int num_links;
+    if (!ReadInt(&num_links, false) || num_links < 0) return -1;
+    binary_variables.resize(num_links);
+    negated.assign(num_links, false);
+    for (int j = 0; j < num_links; ++j) {
+      int k;
+      if (!ReadInt(&k, false)) return -1;
+      if (k < 0) {
+        negated[j] = true;
+        k = -k;
+      }
+      if (k < 1 || k > num_variables_) {
+        cout << "Error: invalid variable " << k << " in factor "
+             << i << "." << endl;
+        return -1;
+      }
+      binary_variables[j] = variables[k - 1];
+    }
+
+    // Read the parameters of the factor.
+    if (type == "XOR") {
+      factor_graph->CreateFactorXOR(binary_variables, negated);
+    } else if (type == "XOROUT") {
+      factor_graph->CreateFactorXOROUT(binary_variables, negated);
+    } else if (type == "ATMOSTONE") {
+      factor_graph->CreateFactorAtMostOne(binary_variables, negated);
+    } else if (type == "OR") {
+      factor_graph->CreateFactorOR(binary_variables, negated);
+    } else if (type == "OROUT") {
+      if (binary_variables.size() == 2) {
+        // The OR of a single variable is that variable, as is its XOR.
+        factor_graph->CreateFactorXOROUT(binary_variables, negated);
+      } else {
+        factor_graph->CreateFactorOROUT(binary_variables, negated);
+      }
+    } else if (type == "ANDOUT") {
+      factor_graph->CreateFactorANDOUT(binary_variables, negated);
+    } else if (type == "BUDGET") {
+      int budget;
+      if (!ReadInt(&budget, false)) return -1;
+      factor_graph->CreateFactorBUDGET(binary_variables, negated, budget);
+    } else if (type == "KNAPSACK") {
+      // The costs of the variables, followed by the budget.
+      vector<double> costs(num_links);
+      for (int j = 0; j < num_links; ++j) {
+        if (!ReadDouble(&costs[j], false)) return -1;
+      }
+      double budget;
+      if (!ReadDouble(&budget, false)) return -1;
+      factor_graph->CreateFactorKNAPSACK(binary_variables, negated, costs,
+                                         budget);
+    } else if (type == "PAIR") {
+      if (num_links != 2) {
+        cout << "Error: PAIR factor must be attached to 2 variables." << endl;
+        return -1;
+      }
+      double log_potential;
+      if (!ReadDouble(&log_potential, false)) return -1;
+      factor_graph->CreateFactorPAIR(binary_variables, log_potential);
+    } else if (type == "DENSE") {
+      // Read the number of multi-variables and the number of states of
+      // each one; their states are the linked variables, in order.
+      int num_multi_variables;
+      if (!ReadInt(&num_multi_variables, false) ||
+          num_multi_variables <= 0) {
+        return -1;
+      }
+      vector<MultiVariable*> multi_variables(num_multi_variables);
+      int num_configurations = 1;
+      int total_states = 0;
+      for (int k = 0; k < num_multi_variables; ++k) {
+        int num_states;
+        if (!ReadInt(&num_states, false) || num_states <= 0 ||
+            total_states + num_states > num_links) {
+          return -1;
+        }
+        num_configurations *= num_states;
+        vector<BinaryVariable*> states(
+          binary_variables.begin() + total_states,
+          binary_variables.begin() + total_states + num_states);
+        total_states += num_states;
+        multi_variables[k] = factor_graph->CreateMultiVariable(states);
+      }
+      if (total_states != num_links) {
+        cout << "Error: the states of a DENSE factor must be its linked "
+             << "variables." << endl;
+        return -1;
+      }
+
+      // Read the additional log-potentials.
+      additional_log_potentials.resize(num_configurations);
+      for (int index = 0; index < num_configurations; ++index) {
+        if (!ReadDouble(&additional_log_potentials[index], false)) return -1;
+      }
+      factor_graph->CreateFactorDense(
+        multi_variables,
+        GetSharedLogPotentials(additional_log_potentials, factor_graph));
+    } else {
+      // Pass the whole line to the derived class.
+      position_ = line;
+      vector<string> fields;
+      const char *begin, *end;
+      while (NextToken(&begin, &end, false)) {
+        fields.push_back(string(begin, end));
+      }
+      if (!ReadCustomFactor(fields, binary_variables, negated,
+                            factor_graph)) {
+        cout << "Unknown factor type: " << type << endl;
+        return -1;
+      }
+    }
+    SkipLine();
+  }
+
+  return 0;
+}
+
+int FactorGraphReader::ReadGraphUAI(FactorGraph *factor_graph,
+                                    bool sparse_tables) {
+  shared_tables_.clear();
+
+  // Read header.
+  const char *begin, *end;
+  if (!NextToken(&begin, &end, true)) return -1;
+  if (string(begin, end) != "MARKOV") {
+    cout << "Wrong header: " << string(begin, end) << endl;
+    return -1;
+  }
+
+  // Read the multi-variables and their cardinalities.
+  int num_multi_variables;
+  if (!ReadInt(&num_multi_variables, true) || num_multi_variables < 0) {
+    return -1;
+  }
+  vector<int> cardinalities(num_multi_variables);
+  for (int i = 0; i < num_multi_variables; ++i) {
+    if (!ReadInt(&cardinalities[i], true) || cardinalities[i] <= 0) {
+      return -1;
+    }
+  }
+
+  // Observed multi-variables are not created.
+  if (evidence_.size() > num_multi_variables) {
+    cout << "Error: evidence for multi-variable " << evidence_.size() - 1
+         << ", but the graph only has " << num_multi_variables << "."
+         << endl;
+    return -1;
+  }
+  graph_evidence_ = evidence_;
+  graph_evidence_.resize(num_multi_variables, -1);
+  evidence_log_potential_ = 0.0;
+  int num_variables = 0;
+  int num_observed = 0;
+  for (int i = 0; i < num_multi_variables; ++i) {
+    if (graph_evidence_[i] >= cardinalities[i]) {
+      cout << "Error: evidence state " << graph_evidence_[i]
+           << " of multi-variable " << i << " is out of range." << endl;
+      return -1;
+    }
+    if (graph_evidence_[i] >= 0) {
+      ++num_observed;
+    } else {
+      num_variables += cardinalities[i];
+    }
+  }
+  factor_graph->ReserveVariables(num_variables);
+  factor_graph->ReserveMultiVariables(num_multi_variables - num_observed);
+  vector<MultiVariable*> multi_variables(num_multi_variables, NULL);
+  for (int i = 0; i < num_multi_variables; ++i) {
+    if (graph_evidence_[i] >= 0) continue;
+    multi_variables[i] = factor_graph->CreateMultiVariable(cardinalities[i]);
+  }
+
+  // Read the structure of the factors (which include unary factors; in our
+  // formalism these are just the log-potentials of a multi-variable).
+  int num_factors;
+  if (!ReadInt(&num_factors, true) || num_factors < 0) return -1;
+  vector<vector<int> > factor_multi_variables(num_factors);
+  int num_non_unary_factors = 0;
+  for (int i = 0; i < num_factors; ++i) {
+    int num_links;
+    if (!ReadInt(&num_links, true) || num_links <= 0) return -1;
+    factor_multi_variables[i].resize(num_links);
+    int num_links_observed = 0;
+    for (int j = 0; j < num_links; ++j) {
+      int k;
+      if (!ReadInt(&k, true) || k < 0 || k >= num_multi_variables) {
+        return -1;
+      }
+      factor_multi_variables[i][j] = k;
+      if (graph_evidence_[k] >= 0) ++num_links_observed;
+    }
+    if (num_links - num_links_observed > 1) ++num_non_unary_factors;
+  }
+  factor_graph->ReserveFactors(num_non_unary_factors);
+
+  // Read the tables. The scores in the UAI files are potentials (not
+  // log-potentials!).
+  vector<double> potentials;
+  vector<double> observed_potentials;
+  vector<double> additional_log_potentials;
+  vector<MultiVariable*> multi_variables_local;
+  vector<int> strides;
+  for (int i = 0; i < num_factors; ++i) {
+    const vector<int> &factor_multi_variables_local =
+      factor_multi_variables[i];
+    int num_configurations;
+    if (!ReadInt(&num_configurations, true) || num_configurations < 0) {
+      return -1;
+    }
+    int expected_num_configurations = 1;
+    for (int j = 0; j < factor_multi_variables_local.size(); ++j) {
+      expected_num_configurations *=
+        cardinalities[factor_multi_variables_local[j]];
+    }
+    if (num_configurations != expected_num_configurations) {
+      cout << "Error: wrong table size in factor " << i << "." << endl;
+      return -1;
+    }
+    potentials.resize(num_configurations);
+    for (int index = 0; index < num_configurations; ++index) {
+      if (!ReadDouble(&potentials[index], true)) return -1;
+    }
+
+    // Restrict the table to the observed states (the last multi-variable
+    // changes fastest).
+    int num_links = factor_multi_variables_local.size();
+    multi_variables_local.clear();
+    strides.resize(num_links);
+    int offset = 0;
+    int stride = 1;
+    for (int j = num_links - 1; j >= 0; --j) {
+      int k = factor_multi_variables_local[j];
+      strides[j] = stride;
+      if (graph_evidence_[k] >= 0) offset += graph_evidence_[k] * stride;
+      stride *= cardinalities[k];
+    }
+    for (int j = 0; j < num_links; ++j) {
+      int k = factor_multi_variables_local[j];
+      if (graph_evidence_[k] < 0) {
+        multi_variables_local.push_back(multi_variables[k]);
+      }
+    }
+    if (multi_variables_local.size() < num_links) {
+      int num_observed_configurations = 1;
+      for (int j = 0; j < multi_variables_local.size(); ++j) {
+        num_observed_configurations *=
+          multi_variables_local[j]->GetNumStates();
+      }
+      observed_potentials.resize(num_observed_configurations);
+      for (int index = 0; index < num_observed_configurations; ++index) {
+        int remainder = index;
+        int position = offset;
+        for (int j = num_links - 1; j >= 0; --j) {
+          int k = factor_multi_variables_local[j];
+          if (graph_evidence_[k] >= 0) continue;
+          position += (remainder % cardinalities[k]) * strides[j];
+          remainder /= cardinalities[k];
+        }
+        observed_potentials[index] = potentials[position];
+      }
+      potentials.swap(observed_potentials);
+      num_configurations = num_observed_configurations;
+    }
+    int num_nonzeros = 0;
+    for (int index = 0; index < num_configurations; ++index) {
+      if (potentials[index] != 0) ++num_nonzeros;
+    }
+
+    num_links = multi_variables_local.size();
+    if (num_links == 0) {
+      evidence_log_potential_ += LOG_STABLE(potentials[0]);
+    } else if (num_links == 1) {
+      // Several unary factors of the same multi-variable are multiplied.
+      MultiVariable *multi_variable = multi_variables_local[0];
+      for (int index = 0; index < num_configurations; ++index) {
+        multi_variable->SetLogPotential(
+          index,
+          multi_variable->GetLogPotential(index) +
+          LOG_STABLE(potentials[index]));
+      }
+    } else if (sparse_tables && num_nonzeros > 0 &&
+               2 * num_nonzeros <= num_configurations) {
+      // Keep only the allowed configurations. The states are decoded from
+      // the position in the table (the last multi-variable changes
+      // fastest).
+      vector<int> configurations(num_nonzeros * num_links);
+      additional_log_potentials.resize(num_nonzeros);
+      int k = 0;
+      for (int index = 0; index < num_configurations; ++index) {
+        if (potentials[index] == 0) continue;
+        int remainder = index;
+        for (int j = num_links - 1; j >= 0; --j) {
+          int num_states = multi_variables_local[j]->GetNumStates();
+          configurations[k * num_links + j] = remainder % num_states;
+          remainder /= num_states;
+        }
+        additional_log_potentials[k] = log(potentials[index]);
+        ++k;
+      }
+      factor_graph->CreateFactorSparse(multi_variables_local,
+                                       configurations,
+                                       additional_log_potentials);
+    } else {
+      additional_log_potentials.resize(num_configurations);
+      for (int index = 0; index < num_configurations; ++index) {
+        additional_log_potentials[index] = LOG_STABLE(potentials[index]);
+      }
+      factor_graph->CreateFactorDense(
+        multi_variables_local,
+        GetSharedLogPotentials(additional_log_potentials, factor_graph));
+    }
+  }
+
+  num_variables_ = num_multi_variables;
+  num_factors_ = num_factors;
+  return 0;
+}
+
+int FactorGraphReader::ReadEvidenceUAI(const string &filename) {
+  ifstream file(filename.c_str(), ios_base::in);
+  if (!file.is_open()) {
+    cout << "Error: Could not open " << filename << " for reading." << endl;
+    return -1;
+  }
+  vector<int> numbers;
+  int number;
+  while (file >> number) numbers.push_back(number);
+  if (!file.eof() || numbers.empty()) {
+    cout << "Error: malformed evidence file " << filename << "." << endl;
+    return -1;
+  }
+
+  // The older format starts with the number of samples, which makes the
+  // count of numbers even.
+  int start = 0;
+  if (numbers.size() % 2 == 0) {
+    if (numbers[0] != 1) {
+      cout << "Error: only evidence files with a single sample are "
+           << "supported." << endl;
+      return -1;
+    }
+    start = 1;
+  }
+  int num_observed = numbers[start];
+  if (num_observed < 0 || numbers.size() != start + 1 + 2 * num_observed) {
+    cout << "Error: malformed evidence file " << filename << "." << endl;
+    return -1;
+  }
+  evidence_.clear();
+  for (int k = 0; k < num_observed; ++k) {
+    int i = numbers[start + 1 + 2 * k];
+    int state = numbers[start + 2 + 2 * k];
+    if (i < 0 || state < 0) {
+      cout << "Error: malformed evidence file " << filename << "." << endl;
+      evidence_.clear();
+      return -1;
+    }
+    if (i >= evidence_.size()) evidence_.resize(i + 1, -1);
+    if (evidence_[i] >= 0 && evidence_[i] != state) {
+      cout << "Error: conflicting evidence for multi-variable " << i << "."
+           << endl;
+      evidence_.clear();
+      return -1;
+    }
+    evidence_[i] = state;
+  }
+  return 0;
+}
+
+// Pointer to a section of a graph in the binary format, and number of
+// elements. Returns NULL if the section is not a whole number of elements.
+template <typename T>
+static const T *GetBinarySection(const char *block,
+                                 const BinaryGraphHeader &header,
+                                 int section,
+                                 int64_t *num_elements) {
+  uint64_t size = header.section_sizes[section];
+  if (size % sizeof(T) != 0) return NULL;
+  *num_elements = size / sizeof(T);
+  return reinterpret_cast<const T*>(block + header.section_offsets[section]);
+}
+
+// Check that an array of offsets starts at zero, does not decrease, and
+// ends at the given size.
+template <typename T>
+static bool CheckOffsets(const T *offsets, int64_t num_offsets,
+                         int64_t size) {
+  if (num_offsets == 0 || offsets[0] != 0) return false;
+  for (int64_t k = 1; k < num_offsets; ++k) {
+    if (offsets[k] < offsets[k-1]) return false;
+  }
+  return offsets[num_offsets - 1] == size;
+}
+
+int FactorGraphReader::ReadGraphBinary(FactorGraph *factor_graph,
+                                       bool load_solver_state) {
+  if (position_ == end_) return -1;
+  const char *block = position_;
+  BinaryGraphHeader header;
+  if (end_ - block < static_cast<ptrdiff_t>(sizeof(header))) {
+    cout << "Error: truncated factor graph." << endl;
+    return -1;
+  }
+  memcpy(&header, block, sizeof(header));
+  if (memcmp(header.magic, kBinaryGraphMagic, sizeof(header.magic)) != 0) {
+    cout << "Error: not a factor graph in the binary format." << endl;
+    return -1;
+  }
+  if (header.byte_order != kBinaryGraphByteOrder) {
+    cout << "Error: factor graph written with a different byte order."
+         << endl;
+    return -1;
+  }
+  if (header.version != kBinaryGraphVersion) {
+    cout << "Error: unsupported version of the binary format: "
+         << header.version << endl;
+    return -1;
+  }
+  // The arrays are read in place, so they must be aligned.
+  if (header.size % 8 != 0 ||
+      header.size > static_cast<uint64_t>(end_ - block) ||
+      reinterpret_cast<size_t>(block) % 8 != 0) {
+    cout << "Error: truncated factor graph." << endl;
+    return -1;
+  }
+  for (int k = 0; k < NUM_BINARY_GRAPH_SECTIONS; ++k) {
+    if (header.section_offsets[k] % 8 != 0 ||
+        header.section_offsets[k] > header.size ||
+        header.section_sizes[k] > header.size - header.section_offsets[k]) {
+      cout << "Error: malformed factor graph." << endl;
+      return -1;
+    }
+  }
+  position_ = block + header.size;
+
+  int64_t num_variables = header.num_variables;
+  int64_t num_multi_variables = header.num_multi_variables;
+  int64_t num_factors = header.num_factors;
+  int64_t num_tables = header.num_tables;
+  int64_t size = 0, num_states = 0, num_integers = 0, num_reals = 0;
+  int64_t num_table_values = 0;
+  // Number of links, only known if the links section is well formed.
+  int64_t num_links = 0;
+  const double *variable_log_potentials = GetBinarySection<double>(
+    block, header, SECTION_VARIABLE_LOG_POTENTIALS, &size);
+  bool valid = variable_log_potentials && size == num_variables;
+  const int32_t *multi_variable_offsets = GetBinarySection<int32_t>(
+    block, header, SECTION_MULTI_VARIABLE_OFFSETS, &size);
+  valid = valid && multi_variable_offsets && size == num_multi_variables + 1;
+  const int32_t *multi_variable_states = GetBinarySection<int32_t>(
+    block, header, SECTION_MULTI_VARIABLE_STATES, &num_states);
+  valid = valid && multi_variable_states &&
+    CheckOffsets(multi_variable_offsets, num_multi_variables + 1,
+                 num_states);
+  const int32_t *factor_types = GetBinarySection<int32_t>(
+    block, header, SECTION_FACTOR_TYPES, &size);
+  valid = valid && factor_types && size == num_factors;
+  const int32_t *factor_link_offsets = GetBinarySection<int32_t>(
+    block, header, SECTION_FACTOR_LINK_OFFSETS, &size);
+  valid = valid && factor_link_offsets && size == num_factors + 1;
+  const int32_t *link_variables = GetBinarySection<int32_t>(
+    block, header, SECTION_LINK_VARIABLES, &num_links);
+  valid = valid && link_variables && num_links == header.num_links &&
+    CheckOffsets(factor_link_offsets, num_factors + 1, num_links);
+  const uint8_t *link_negated = GetBinarySection<uint8_t>(
+    block, header, SECTION_LINK_NEGATED, &size);
+  valid = valid && link_negated && size == num_links;
+  const int32_t *factor_integer_offsets = GetBinarySection<int32_t>(
+    block, header, SECTION_FACTOR_INTEGER_OFFSETS, &size);
+  valid = valid && factor_integer_offsets && size == num_factors + 1;
+  const int32_t *integers = GetBinarySection<int32_t>(
+    block, header, SECTION_INTEGERS, &num_integers);
+  valid = valid && integers &&
+    CheckOffsets(factor_integer_offsets, num_factors + 1, num_integers);
+  const int32_t *factor_real_offsets = GetBinarySection<int32_t>(
+    block, header, SECTION_FACTOR_REAL_OFFSETS, &size);
+  valid = valid && factor_real_offsets && size == num_factors + 1;
+  const double *reals = GetBinarySection<double>(
+    block, header, SECTION_REALS, &num_reals);
+  valid = valid && reals &&
+    CheckOffsets(factor_real_offsets, num_factors + 1, num_reals);
+  const int32_t *factor_tables = GetBinarySection<int32_t>(
+    block, header, SECTION_FACTOR_TABLES, &size);
+  valid = valid && factor_tables && size == num_factors;
+  const int64_t *table_offsets = GetBinarySection<int64_t>(
+    block, header, SECTION_TABLE_OFFSETS, &size);
+  valid = valid && table_offsets && size == num_tables + 1;
+  const double *table_values = GetBinarySection<double>(
+    block, header, SECTION_TABLE_VALUES, &num_table_values);
+  valid = valid && table_values &&
+    CheckOffsets(table_offsets, num_tables + 1, num_table_values);
+  if (!valid) {
+    cout << "Error: malformed factor graph." << endl;
+    return -1;
+  }
+
+  // Create the variables and multi-variables.
+  factor_graph->ReserveVariables(num_variables);
+  factor_graph->ReserveMultiVariables(num_multi_variables);
+  factor_graph->ReserveFactors(num_factors);
+  vector<BinaryVariable*> variables(num_variables);
+  for (int i = 0; i < num_variables; ++i) {
+    variables[i] = factor_graph->CreateBinaryVariable();
+    variables[i]->SetLogPotential(variable_log_potentials[i]);
+  }
+  vector<MultiVariable*> multi_variables(num_multi_variables);
+  vector<BinaryVariable*> states;
+  for (int i = 0; i < num_multi_variables; ++i) {
+    states.clear();
+    for (int k = multi_variable_offsets[i];
+         k < multi_variable_offsets[i+1]; ++k) {
+      if (multi_variable_states[k] < 0 ||
+          multi_variable_states[k] >= num_variables) {
+        cout << "Error: invalid variable in multi-variable " << i << "."
+             << endl;
+        return -1;
+      }
+      states.push_back(variables[multi_variable_states[k]]);
+    }
+    multi_variables[i] = factor_graph->CreateMultiVariable(states);
+  }
+
+  // Tables used by more than one dense factor are shared.
+  vector<int> num_table_factors(num_tables, 0);
+  for (int j = 0; j < num_factors; ++j) {
+    if (factor_tables[j] >= num_tables) {
+      cout << "Error: invalid table in factor " << j << "." << endl;
+      return -1;
+    }
+    if (factor_tables[j] >= 0) ++num_table_factors[factor_tables[j]];
+  }
+  vector<SharedLogPotentials*> shared_tables(num_tables);
+
+  // Create the factors.
+  vector<BinaryVariable*> binary_variables;
+  vector<bool> negated;
+  vector<MultiVariable*> multi_variables_local;
+  vector<int> configurations;
+  vector<double> costs;
+  vector<double> additional_log_potentials;
+  for (int j = 0; j < num_factors; ++j) {
+    int num_factor_links = factor_link_offsets[j+1] - factor_link_offsets[j];
+    binary_variables.resize(num_factor_links);
+    negated.resize(num_factor_links);
+    for (int i = 0; i < num_factor_links; ++i) {
+      int link = factor_link_offsets[j] + i;
+      if (link_variables[link] < 0 || link_variables[link] >= num_variables) {
+        cout << "Error: invalid variable in factor " << j << "." << endl;
+        return -1;
+      }
+      binary_variables[i] = variables[link_variables[link]];
+      negated[i] = link_negated[link] != 0;
+    }
+    const int32_t *factor_integers = integers + factor_integer_offsets[j];
+    int num_factor_integers =
+      factor_integer_offsets[j+1] - factor_integer_offsets[j];
+    const double *factor_reals = reals + factor_real_offsets[j];
+    int num_factor_reals = factor_real_offsets[j+1] - factor_real_offsets[j];
+    int table = factor_tables[j];
+    const double *table_begin = NULL;
+    const double *table_end = NULL;
+    if (table >= 0) {
+      table_begin = table_values + table_offsets[table];
+      table_end = table_values + table_offsets[table + 1];
+    }
+
+    int type = factor_types[j];
+    bool has_table = false;
+    valid = true;
+    if (type == FactorTypes::FACTOR_XOR) {
+      factor_graph->CreateFactorXOR(binary_variables, negated);
+    } else if (type == FactorTypes::FACTOR_OR) {
+      factor_graph->CreateFactorOR(binary_variables, negated);
+    } else if (type == FactorTypes::FACTOR_OROUT) {
+      factor_graph->CreateFactorOROUT(binary_variables, negated);
+    } else if (type == FactorTypes::FACTOR_ATMOSTONE) {
+      factor_graph->CreateFactorAtMostOne(binary_variables, negated);
+    } else if (type == FactorTypes::FACTOR_BUDGET) {
+      valid = (num_factor_integers == 1);
+      if (valid) {
+        factor_graph->CreateFactorBUDGET(binary_variables, negated,
+                                         factor_integers[0]);
+      }
+    } else if (type == FactorTypes::FACTOR_KNAPSACK) {
+      valid = (num_factor_reals == num_factor_links + 1);
+      if (valid) {
+        costs.assign(factor_reals + 1, factor_reals + num_factor_reals);
+        factor_graph->CreateFactorKNAPSACK(binary_variables, negated, costs,
+                                           factor_reals[0]);
+      }
+    } else if (type == FactorTypes::FACTOR_PAIR) {
+      has_table = true;
+      valid = (num_factor_links == 2 && table >= 0 &&
+               table_end - table_begin == 1);
+      if (valid) {
+        factor_graph->CreateFactorPAIR(binary_variables, *table_begin);
+      }
+    } else if (type == FactorTypes::FACTOR_MULTI_DENSE ||
+               type == FactorTypes::FACTOR_MULTI_SPARSE) {
+      has_table = true;
+      // Number of multi-variables, their ids, and (for sparse factors) the
+      // allowed configurations.
+      int num_factor_multi_variables =
+        (num_factor_integers > 0)? factor_integers[0] : 0;
+      valid = (num_factor_multi_variables > 0 &&
+               num_factor_integers > num_factor_multi_variables &&
+               table >= 0);
+      multi_variables_local.clear();
+      int num_configurations = 1;
+      int num_multi_states = 0;
+      for (int i = 0; valid && i < num_factor_multi_variables; ++i) {
+        int id = factor_integers[1 + i];
+        valid = (id >= 0 && id < num_multi_variables);
+        if (!valid) break;
+        multi_variables_local.push_back(multi_variables[id]);
+        num_configurations *= multi_variables[id]->GetNumStates();
+        num_multi_states += multi_variables[id]->GetNumStates();
+      }
+      // The links must be the states of the multi-variables.
+      valid = valid && (num_multi_states == num_factor_links);
+      if (valid && type == FactorTypes::FACTOR_MULTI_DENSE) {
+        valid = (num_factor_integers == 1 + num_factor_multi_variables &&
+                 table_end - table_begin == num_configurations);
+        if (valid && num_table_factors[table] > 1) {
+          if (!shared_tables[table]) {
+            additional_log_potentials.assign(table_begin, table_end);
+            shared_tables[table] = factor_graph->CreateSharedLogPotentials(
+              additional_log_potentials);
+          }
+          factor_graph->CreateFactorDense(multi_variables_local,
+                                          shared_tables[table]);
+        } else if (valid) {
+          additional_log_potentials.assign(table_begin, table_end);
+          factor_graph->CreateFactorDense(multi_variables_local,
+                                          additional_log_potentials);
+        }
+      } else if (valid) {
+        int num_allowed = table_end - table_begin;
+        configurations.assign(factor_integers + 1 +
+                              num_factor_multi_variables,
+                              factor_integers + num_factor_integers);
+        valid = (configurations.size() ==
+                 num_allowed * num_factor_multi_variables);
+        for (int k = 0; valid && k < configurations.size(); ++k) {
+          MultiVariable *multi_variable =
+            multi_variables_local[k % num_factor_multi_variables];
+          valid = (configurations[k] >= 0 &&
+                   configurations[k] < multi_variable->GetNumStates());
+        }
+        if (valid) {
+          additional_log_potentials.assign(table_begin, table_end);
+          factor_graph->CreateFactorSparse(multi_variables_local,
+                                           configurations,
+                                           additional_log_potentials);
+        }
+      }
+    } else {
+      cout << "Error: unknown factor type in the binary format: " << type
+           << endl;
+      return -1;
+    }
+    if (!valid || (!has_table && table >= 0)) {
+      cout << "Error: invalid parameters in factor " << j << "." << endl;
+      return -1;
+    }
+  }
+
+  // Restore the state of AD3. This is only possible if the graph was read
+  // into an empty graph (otherwise the links would not match).
+  if (load_solver_state && (header.flags & BINARY_GRAPH_SOLVER_STATE)) {
+    const double *lambdas = GetBinarySection<double>(
+      block, header, SECTION_DUAL_VARIABLES, &size);
+    // The dual and local primal variables are indexed by link.
+    valid = link_variables && lambdas && size == num_links;
+    const double *maps = GetBinarySection<double>(
+      block, header, SECTION_LOCAL_PRIMAL_VARIABLES, &size);
+    valid = valid && maps && size == num_links;
+    const double *maps_av = GetBinarySection<double>(
+      block, header, SECTION_GLOBAL_PRIMAL_VARIABLES, &size);
+    valid = valid && maps_av && size == num_variables;
+    const double *eta = GetBinarySection<double>(
+      block, header, SECTION_ETA, &size);
+    valid = valid && eta && size == 1;
+    if (!valid) {
+      cout << "Error: malformed state of AD3." << endl;
+      return -1;
+    }
+    if (factor_graph->GetNumVariables() == num_variables &&
+        factor_graph->GetNumLinks() == num_links) {
+      factor_graph->SetWarmStartAD3(vector<double>(lambdas,
+                                                   lambdas + num_links),
+                                    vector<double>(maps, maps + num_links),
+                                    vector<double>(maps_av,
+                                                   maps_av + num_variables),
+                                    eta[0]);
+    }
+  }
+
+  num_variables_ = num_variables;
+  num_factors_ = num_factors;
+  return 0;
+}
+
+} // namespace AD3
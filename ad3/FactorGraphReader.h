@@ -0,0 +1,167 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FACTOR_GRAPH_READER_H_
+#define FACTOR_GRAPH_READER_H_
+
+#include <map>
+#include <string>
+#include "FactorGraph.h"
+
+namespace AD3 {
+
+// Reader of factor graphs in the AD3 (.fg), UAI and binary formats. The
+// file is mapped to memory (or read at once where mmap is not available)
+// and tokenized in place: numbers are parsed directly from the mapped
+// bytes, without building strings, and the variables and factors are
+// allocated from the counts in the headers. A file may contain several
+// graphs, one after the other; each call to ReadGraph/ReadGraphUAI/
+// ReadGraphBinary reads the next one.
+//
+// The AD3 format has one factor per line. The built-in factor types are
+// XOR, XOROUT, ATMOSTONE, OR, OROUT, ANDOUT, BUDGET, KNAPSACK, PAIR and
+// DENSE; other types are passed to ReadCustomFactor, which derived
+// classes may override. Dense factors with the same table share it (see
+// FactorGraph::CreateSharedLogPotentials).
+class FactorGraphReader {
+ public:
+  FactorGraphReader();
+  virtual ~FactorGraphReader() { Close(); }
+
+  // Open a file. Returns false if it cannot be read.
+  bool Open(const string &filename);
+
+  // Close the file.
+  void Close();
+
+  // Read the next factor graph in the AD3 format. Returns 0 on success
+  // and -1 at the end of the file or if the graph is malformed.
+  int ReadGraph(FactorGraph *factor_graph);
+
+  // Read the next factor graph in the UAI format. If sparse_tables is true,
+  // factors whose tables have at least half of the entries equal to zero
+  // are created as sparse factors. If evidence was read (see
+  // ReadEvidenceUAI), the observed multi-variables are left out of the
+  // graph and the tables are restricted to their observed states. Returns 0
+  // on success and -1 at the end of the file or if the graph is malformed.
+  int ReadGraphUAI(FactorGraph *factor_graph, bool sparse_tables);
+
+  // Read an evidence file in the UAI format (the number of observed
+  // multi-variables followed by pairs of multi-variable and state; the
+  // older format, which starts with the number of samples, is also
+  // accepted if there is a single sample). The evidence is applied to the
+  // graphs read afterwards with ReadGraphUAI. Returns 0 on success and -1
+  // if the file cannot be read or is malformed.
+  int ReadEvidenceUAI(const string &filename);
+
+  // Observed state of each multi-variable of the last graph read with
+  // ReadGraphUAI (-1 if not observed). The multi-variables of the graph
+  // are the ones not observed, in the same order.
+  const vector<int> &GetEvidence() { return graph_evidence_; }
+
+  // Sum of the log-potentials of the factors whose multi-variables were
+  // all observed, in the last graph read with ReadGraphUAI. It is constant
+  // once the evidence is set, and must be added to the scores of the graph
+  // to get those of the original model.
+  double GetEvidenceLogPotential() { return evidence_log_potential_; }
+
+  // Read the next factor graph in the binary format (see
+  // FactorGraphBinary.h). The arrays are used in place, from the mapped
+  // file. If load_solver_state is true and the graph was saved with the
+  // state of AD3, the next run of AD3 starts from that state (see
+  // FactorGraph::SetWarmStartAD3). Returns 0 on success and -1 at the end
+  // of the file or if the graph is malformed.
+  int ReadGraphBinary(FactorGraph *factor_graph, bool load_solver_state);
+
+  // Number of variables (multi-variables for the UAI format) and factors
+  // in the last graph read.
+  int GetNumVariables() { return num_variables_; }
+  int GetNumFactors() { return num_factors_; }
+
+ protected:
+  // Create a factor of a type which is not built in. The fields are the
+  // tokens of the line, starting with the type, the number of links and
+  // the links; variables and negated are the variables of these links.
+  // Returns NULL if the type is unknown.
+  virtual Factor *ReadCustomFactor(const vector<string> &fields,
+                                   const vector<BinaryVariable*> &variables,
+                                   const vector<bool> &negated,
+                                   FactorGraph *factor_graph) {
+    return NULL;
+  }
+
+ private:
+  // Skip blanks (and comments, if newlines is true) until the next token.
+  // If newlines is false, stop at the end of the line.
+  void SkipBlanks(bool newlines);
+
+  // Move past the end of the current line.
+  void SkipLine();
+
+  // Read the next token of the current line (or of the file, for the
+  // UAI format). Return false if there is none.
+  bool NextToken(const char **begin, const char **end, bool newlines);
+
+  // Parse the next token as an integer or as a double.
+  bool ReadInt(int *value, bool newlines);
+  bool ReadDouble(double *value, bool newlines);
+
+  // Get a table of log-potentials shared by all the dense factors of the
+  // graph with the same table, creating it if needed.
+  SharedLogPotentials *GetSharedLogPotentials(
+    const vector<double> &additional_log_potentials,
+    FactorGraph *factor_graph);
+
+  // Tables of log-potentials of the graph being read, indexed by their
+  // contents.
+  struct CompareLogPotentials {
+    bool operator()(const vector<double> *first,
+                    const vector<double> *second) const {
+      return *first < *second;
+    }
+  };
+  typedef map<const vector<double>*, SharedLogPotentials*,
+              CompareLogPotentials> SharedLogPotentialsMap;
+
+  // Contents of the file.
+  const char *data_;
+  size_t size_;
+  bool mapped_;
+  // Current position and end of the contents.
+  const char *position_;
+  const char *end_;
+  // Sizes of the last graph read.
+  int num_variables_;
+  int num_factors_;
+  SharedLogPotentialsMap shared_tables_;
+  // Evidence read with ReadEvidenceUAI, indexed by multi-variable (-1 if
+  // not observed), and the evidence applied to the last graph.
+  vector<int> evidence_;
+  vector<int> graph_evidence_;
+  double evidence_log_potential_;
+};
+
+// Parse a number in the range [begin, end). These are locale-independent
+// and give the same values as strtol/strtod. Return false if the range is
+// not a number.
+extern bool ParseInt(const char *begin, const char *end, int *value);
+extern bool ParseDouble(const char *begin, const char *end, double *value);
+
+} // namespace AD3
+
+#endif // FACTOR_GRAPH_READER_H_
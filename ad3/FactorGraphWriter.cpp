@@ -0,0 +1,238 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <map>
+#include <string.h>
+#include "FactorGraphWriter.h"
+
+namespace AD3 {
+
+// Size of a section, rounded up to a multiple of 8 bytes.
+static uint64_t PaddedSize(uint64_t size) {
+  return (size + 7) & ~static_cast<uint64_t>(7);
+}
+
+// Address and size (in bytes) of the contents of a vector.
+template <typename T>
+static void SetSection(const vector<T> &values, int section,
+                       vector<const char*> *data,
+                       vector<uint64_t> *sizes) {
+  (*data)[section] = values.empty()? NULL :
+    reinterpret_cast<const char*>(&values[0]);
+  (*sizes)[section] = values.size() * sizeof(T);
+}
+
+bool FactorGraphWriter::Open(const string &filename) {
+  Close();
+  file_.open(filename.c_str(), ios_base::out | ios_base::binary);
+  return file_.is_open();
+}
+
+void FactorGraphWriter::Close() {
+  if (file_.is_open()) file_.close();
+  file_.clear();
+}
+
+int FactorGraphWriter::WriteGraphBinary(FactorGraph *factor_graph,
+                                        bool save_solver_state) {
+  int num_variables = factor_graph->GetNumVariables();
+  int num_multi_variables = factor_graph->GetNumMultiVariables();
+  int num_factors = factor_graph->GetNumFactors();
+  int num_links = factor_graph->GetNumLinks();
+
+  vector<double> variable_log_potentials(num_variables);
+  for (int i = 0; i < num_variables; ++i) {
+    variable_log_potentials[i] =
+      factor_graph->GetBinaryVariable(i)->GetLogPotential();
+  }
+
+  vector<int32_t> multi_variable_offsets(1, 0);
+  vector<int32_t> multi_variable_states;
+  multi_variable_offsets.reserve(num_multi_variables + 1);
+  for (int i = 0; i < num_multi_variables; ++i) {
+    MultiVariable *multi_variable = factor_graph->GetMultiVariable(i);
+    for (int k = 0; k < multi_variable->GetNumStates(); ++k) {
+      multi_variable_states.push_back(multi_variable->GetState(k)->GetId());
+    }
+    multi_variable_offsets.push_back(multi_variable_states.size());
+  }
+
+  vector<int32_t> factor_types(num_factors);
+  vector<int32_t> factor_link_offsets(1, 0);
+  vector<int32_t> link_variables;
+  vector<uint8_t> link_negated;
+  vector<int32_t> factor_integer_offsets(1, 0);
+  vector<int32_t> integers;
+  vector<int32_t> factor_real_offsets(1, 0);
+  vector<double> reals;
+  vector<int32_t> factor_tables(num_factors, -1);
+  vector<int64_t> table_offsets(1, 0);
+  vector<double> table_values;
+  factor_link_offsets.reserve(num_factors + 1);
+  factor_integer_offsets.reserve(num_factors + 1);
+  factor_real_offsets.reserve(num_factors + 1);
+  link_variables.reserve(num_links);
+  link_negated.reserve(num_links);
+
+  // Tables already written, indexed by their address (factors which share
+  // a table return the same vector).
+  map<const vector<double>*, int> tables;
+  for (int j = 0; j < num_factors; ++j) {
+    Factor *factor = factor_graph->GetFactor(j);
+    factor_types[j] = factor->type();
+    for (int i = 0; i < factor->Degree(); ++i) {
+      link_variables.push_back(factor->GetVariable(i)->GetId());
+      link_negated.push_back(factor->IsVariableNegated(i)? 1 : 0);
+    }
+    factor_link_offsets.push_back(link_variables.size());
+
+    bool has_table = false;
+    if (factor->type() == FactorTypes::FACTOR_XOR ||
+        factor->type() == FactorTypes::FACTOR_OR ||
+        factor->type() == FactorTypes::FACTOR_OROUT ||
+        factor->type() == FactorTypes::FACTOR_ATMOSTONE) {
+      // No parameters.
+    } else if (factor->type() == FactorTypes::FACTOR_BUDGET) {
+      integers.push_back(static_cast<FactorBUDGET*>(factor)->GetBudget());
+    } else if (factor->type() == FactorTypes::FACTOR_KNAPSACK) {
+      FactorKNAPSACK *factor_knapsack = static_cast<FactorKNAPSACK*>(factor);
+      reals.push_back(factor_knapsack->GetBudget());
+      for (int i = 0; i < factor->Degree(); ++i) {
+        reals.push_back(factor_knapsack->GetCost(i));
+      }
+    } else if (factor->type() == FactorTypes::FACTOR_PAIR) {
+      has_table = true;
+    } else if (factor->type() == FactorTypes::FACTOR_MULTI_DENSE) {
+      FactorDense *factor_dense = static_cast<FactorDense*>(factor);
+      integers.push_back(factor_dense->GetNumMultiVariables());
+      for (int i = 0; i < factor_dense->GetNumMultiVariables(); ++i) {
+        integers.push_back(factor_dense->GetMultiVariable(i)->GetId());
+      }
+      has_table = true;
+    } else if (factor->type() == FactorTypes::FACTOR_MULTI_SPARSE) {
+      FactorSparse *factor_sparse = static_cast<FactorSparse*>(factor);
+      int num_factor_multi_variables = factor_sparse->GetNumMultiVariables();
+      integers.push_back(num_factor_multi_variables);
+      for (int i = 0; i < num_factor_multi_variables; ++i) {
+        integers.push_back(factor_sparse->GetMultiVariable(i)->GetId());
+      }
+      for (int k = 0; k < factor_sparse->GetNumConfigurations(); ++k) {
+        for (int i = 0; i < num_factor_multi_variables; ++i) {
+          integers.push_back(factor_sparse->GetConfigurationState(k, i));
+        }
+      }
+      has_table = true;
+    } else {
+      cout << "Error: factor " << j << " has a type ("
+           << factor->type() << ") which cannot be written in the binary "
+           << "format." << endl;
+      return -1;
+    }
+    factor_integer_offsets.push_back(integers.size());
+    factor_real_offsets.push_back(reals.size());
+
+    if (has_table) {
+      const vector<double> &additional_log_potentials =
+        factor->GetAdditionalLogPotentials();
+      map<const vector<double>*, int>::iterator it =
+        tables.find(&additional_log_potentials);
+      if (it != tables.end()) {
+        factor_tables[j] = it->second;
+      } else {
+        factor_tables[j] = table_offsets.size() - 1;
+        tables[&additional_log_potentials] = factor_tables[j];
+        table_values.insert(table_values.end(),
+                            additional_log_potentials.begin(),
+                            additional_log_potentials.end());
+        table_offsets.push_back(table_values.size());
+      }
+    }
+  }
+
+  // The state of AD3 is only available after a run on this graph.
+  double eta = factor_graph->GetLastEtaAD3();
+  vector<double> eta_values;
+  bool has_solver_state = save_solver_state &&
+    factor_graph->GetDualVariables().size() == num_links &&
+    factor_graph->GetLocalPrimalVariables().size() == num_links &&
+    factor_graph->GetGlobalPrimalVariables().size() == num_variables;
+  if (has_solver_state) eta_values.push_back(eta);
+
+  vector<const char*> data(NUM_BINARY_GRAPH_SECTIONS, NULL);
+  vector<uint64_t> sizes(NUM_BINARY_GRAPH_SECTIONS, 0);
+  SetSection(variable_log_potentials, SECTION_VARIABLE_LOG_POTENTIALS,
+             &data, &sizes);
+  SetSection(multi_variable_offsets, SECTION_MULTI_VARIABLE_OFFSETS,
+             &data, &sizes);
+  SetSection(multi_variable_states, SECTION_MULTI_VARIABLE_STATES,
+             &data, &sizes);
+  SetSection(factor_types, SECTION_FACTOR_TYPES, &data, &sizes);
+  SetSection(factor_link_offsets, SECTION_FACTOR_LINK_OFFSETS,
+             &data, &sizes);
+  SetSection(link_variables, SECTION_LINK_VARIABLES, &data, &sizes);
+  SetSection(link_negated, SECTION_LINK_NEGATED, &data, &sizes);
+  SetSection(factor_integer_offsets, SECTION_FACTOR_INTEGER_OFFSETS,
+             &data, &sizes);
+  SetSection(integers, SECTION_INTEGERS, &data, &sizes);
+  SetSection(factor_real_offsets, SECTION_FACTOR_REAL_OFFSETS,
+             &data, &sizes);
+  SetSection(reals, SECTION_REALS, &data, &sizes);
+  SetSection(factor_tables, SECTION_FACTOR_TABLES, &data, &sizes);
+  SetSection(table_offsets, SECTION_TABLE_OFFSETS, &data, &sizes);
+  SetSection(table_values, SECTION_TABLE_VALUES, &data, &sizes);
+  if (has_solver_state) {
+    SetSection(factor_graph->GetDualVariables(), SECTION_DUAL_VARIABLES,
+               &data, &sizes);
+    SetSection(factor_graph->GetLocalPrimalVariables(),
+               SECTION_LOCAL_PRIMAL_VARIABLES, &data, &sizes);
+    SetSection(factor_graph->GetGlobalPrimalVariables(),
+               SECTION_GLOBAL_PRIMAL_VARIABLES, &data, &sizes);
+    SetSection(eta_values, SECTION_ETA, &data, &sizes);
+  }
+
+  BinaryGraphHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kBinaryGraphMagic, sizeof(header.magic));
+  header.version = kBinaryGraphVersion;
+  header.byte_order = kBinaryGraphByteOrder;
+  header.flags = has_solver_state? BINARY_GRAPH_SOLVER_STATE : 0;
+  header.num_variables = num_variables;
+  header.num_multi_variables = num_multi_variables;
+  header.num_factors = num_factors;
+  header.num_links = num_links;
+  header.num_tables = table_offsets.size() - 1;
+  uint64_t offset = PaddedSize(sizeof(header));
+  for (int k = 0; k < NUM_BINARY_GRAPH_SECTIONS; ++k) {
+    header.section_offsets[k] = offset;
+    header.section_sizes[k] = sizes[k];
+    offset += PaddedSize(sizes[k]);
+  }
+  header.size = offset;
+
+  static const char kPadding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file_.write(kPadding, PaddedSize(sizeof(header)) - sizeof(header));
+  for (int k = 0; k < NUM_BINARY_GRAPH_SECTIONS; ++k) {
+    if (sizes[k] == 0) continue;
+    file_.write(data[k], sizes[k]);
+    file_.write(kPadding, PaddedSize(sizes[k]) - sizes[k]);
+  }
+  return file_.good()? 0 : -1;
+}
+
+} // namespace AD3
@@ -0,0 +1,59 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FACTOR_GRAPH_WRITER_H_
+#define FACTOR_GRAPH_WRITER_H_
+
+#include <fstream>
+#include <string>
+#include "FactorGraph.h"
+#include "FactorGraphBinary.h"
+
+namespace AD3 {
+
+// Writer of factor graphs in the binary format (see FactorGraphBinary.h),
+// which is read back with FactorGraphReader::ReadGraphBinary. Several
+// graphs can be written to the same file, one after the other.
+//
+// Only the built-in factor types (logic, budget, knapsack, pair, dense and
+// sparse) can be written; graphs with other factors are rejected.
+class FactorGraphWriter {
+ public:
+  FactorGraphWriter() {}
+  virtual ~FactorGraphWriter() { Close(); }
+
+  // Open a file for writing. Returns false if it cannot be created.
+  bool Open(const string &filename);
+
+  // Close the file.
+  void Close();
+
+  // Write a factor graph. If save_solver_state is true, the dual variables,
+  // the local and global primal variables and eta from the last run of
+  // AD3 are also written (see FactorGraph::SetWarmStartAD3). Returns 0 on
+  // success and -1 if the graph has a factor that cannot be written or the
+  // file cannot be written.
+  int WriteGraphBinary(FactorGraph *factor_graph, bool save_solver_state);
+
+ private:
+  ofstream file_;
+};
+
+} // namespace AD3
+
+#endif // FACTOR_GRAPH_WRITER_H_
@@ -0,0 +1,115 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FACTOR_PAIR_DENSE
+#define FACTOR_PAIR_DENSE
+
+#include "FactorDense.h"
+
+namespace AD3 {
+
+// Dense factor linking two multi-variables, with K and L states.
+// The configurations are the cells (a,b) of the K x L table, and the QP is
+//   max_mu sum_ab mu_ab * score_ab - 0.5 * ||r||^2 - 0.5 * ||s||^2,
+// over the distributions mu on the table, where r and s are the row and
+// column sums of mu. It is solved with the active set method of
+// GenericFactor, but the scores, similarities and marginals of the cells
+// are computed in closed form: the similarity of two cells is the number
+// of coordinates they share, and only the rows and columns of the active
+// cells are touched in each iteration. The full table of additional
+// posteriors is only written once, before returning.
+class FactorPairDense : public FactorDense {
+ public:
+  FactorPairDense() {}
+  virtual ~FactorPairDense() { ClearActiveSet(); }
+
+  void Initialize(const vector<MultiVariable*> &multi_variables) {
+    assert(multi_variables.size() == 2);
+    FactorDense::Initialize(multi_variables);
+    num_states1_ = multi_variables[0]->GetNumStates();
+    num_states2_ = multi_variables[1]->GetNumStates();
+  }
+
+  // Compute the score of a cell.
+  void Evaluate(const vector<double> &variable_log_potentials,
+                const vector<double> &additional_log_potentials,
+                const Configuration configuration,
+                double *value) {
+    const vector<int> *states =
+      static_cast<const vector<int>*>(configuration);
+    int a = (*states)[0];
+    int b = (*states)[1];
+    *value = variable_log_potentials[a] +
+      variable_log_potentials[num_states1_ + b] +
+      additional_log_potentials[a * num_states2_ + b];
+  }
+
+ protected:
+  // Similarities between a cell and the active set.
+  void ComputeSimilarities(const Configuration &configuration,
+                           vector<double> *similarities) {
+    const vector<int> *states =
+      static_cast<const vector<int>*>(configuration);
+    int size = active_set_.size();
+    similarities->resize(size + 1);
+    for (int i = 0; i < size; ++i) {
+      const vector<int> *active_states =
+        static_cast<const vector<int>*>(active_set_[i]);
+      (*similarities)[i] =
+        static_cast<double>(((*active_states)[0] == (*states)[0]) +
+                            ((*active_states)[1] == (*states)[1]));
+    }
+    (*similarities)[size] = 2.0;
+  }
+
+  // Row and column marginals of a distribution over the active set.
+  void ComputeActiveSetVariableMarginals(const vector<double> &distribution,
+                                         vector<double> *variable_posteriors) {
+    variable_posteriors->assign(binary_variables_.size(), 0.0);
+    for (int i = 0; i < active_set_.size(); ++i) {
+      const vector<int> *states =
+        static_cast<const vector<int>*>(active_set_[i]);
+      (*variable_posteriors)[(*states)[0]] += distribution[i];
+      (*variable_posteriors)[num_states1_ + (*states)[1]] += distribution[i];
+    }
+  }
+
+  // Variable and additional posteriors of a distribution over the active
+  // set.
+  void ComputeActiveSetMarginals(const vector<double> &distribution,
+                                 vector<double> *variable_posteriors,
+                                 vector<double> *additional_posteriors) {
+    ComputeActiveSetVariableMarginals(distribution, variable_posteriors);
+    additional_posteriors->assign(GetAdditionalLogPotentials().size(), 0.0);
+    for (int i = 0; i < active_set_.size(); ++i) {
+      const vector<int> *states =
+        static_cast<const vector<int>*>(active_set_[i]);
+      (*additional_posteriors)[(*states)[0] * num_states2_ + (*states)[1]] +=
+        distribution[i];
+    }
+  }
+
+ private:
+  // Number of states of the two multi-variables.
+  int num_states1_;
+  int num_states2_;
+};
+
+} // namespace AD3
+
+#endif // FACTOR_PAIR_DENSE
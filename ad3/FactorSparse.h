@@ -0,0 +1,388 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FACTOR_SPARSE
+#define FACTOR_SPARSE
+
+#include "GenericFactor.h"
+#include "MultiVariable.h"
+
+namespace AD3 {
+
+// Factor linking several multi-variables where only a list of joint
+// configurations is allowed (e.g. a hard-constraint table that is mostly
+// zeros in probability space). Each allowed configuration has one
+// additional log-potential, in the order of the list; all the others are
+// impossible. Memory and the cost of Maximize scale with the number of
+// allowed configurations, not with the product of the number of states.
+// A configuration is the position of an allowed configuration in the list.
+class FactorSparse : public GenericFactor {
+ public:
+  FactorSparse() {}
+  virtual ~FactorSparse() { ClearActiveSet(); }
+
+  int type() { return FactorTypes::FACTOR_MULTI_SPARSE; }
+
+  // Print as a string.
+  void Print(ostream& stream) {
+    stream << "SPARSE";
+    Factor::Print(stream);
+
+    // Write the number of multi-variables.
+    int num_multi_variables = multi_variables_.size();
+    stream << " " << num_multi_variables;
+
+    // Write the number of states for each multi-variable.
+    for (int k = 0; k < num_multi_variables; ++k) {
+      stream << " " << multi_variables_[k]->GetNumStates();
+    }
+
+    // Write the allowed configurations, each followed by its additional
+    // log-potential.
+    int num_configurations = GetNumConfigurations();
+    stream << " " << num_configurations;
+    for (int index = 0; index < num_configurations; ++index) {
+      for (int k = 0; k < num_multi_variables; ++k) {
+        stream << " " << GetConfigurationState(index, k);
+      }
+      stream << " " << setprecision(9) << GetAdditionalLogPotentials()[index];
+    }
+
+    stream << endl;
+  }
+
+  // Find the most likely assignment by scanning the allowed configurations.
+  void Maximize(const vector<double> &variable_log_potentials,
+                const vector<double> &additional_log_potentials,
+                Configuration &configuration,
+                double *value) {
+    vector<int> *index = static_cast<vector<int>*>(configuration);
+    int num_multi_variables = multi_variables_.size();
+    int num_configurations = GetNumConfigurations();
+    const int *variable_indices = &variable_indices_[0];
+    int best = -1;
+    *value = -1e12;
+    for (int k = 0; k < num_configurations; ++k) {
+      double score = additional_log_potentials[k];
+      for (int i = 0; i < num_multi_variables; ++i) {
+        score += variable_log_potentials[variable_indices[i]];
+      }
+      if (best < 0 || score > *value) {
+        *value = score;
+        best = k;
+      }
+      variable_indices += num_multi_variables;
+    }
+    assert(best >= 0);
+    (*index)[0] = best;
+  }
+
+  // Compute the max-marginal differences. The best score for each state
+  // of each multi-variable is obtained in a single pass over the allowed
+  // configurations; states which are not part of any of them keep a
+  // score of -1e100.
+  void ComputeMaxMarginalDifferences(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *max_marginal_differences) {
+    vector<double> best_scores(variable_log_potentials.size(), -1e100);
+    int num_multi_variables = multi_variables_.size();
+    for (int k = 0; k < GetNumConfigurations(); ++k) {
+      const int *variable_indices =
+        &variable_indices_[k * num_multi_variables];
+      double score = additional_log_potentials[k];
+      for (int i = 0; i < num_multi_variables; ++i) {
+        score += variable_log_potentials[variable_indices[i]];
+      }
+      for (int i = 0; i < num_multi_variables; ++i) {
+        if (score > best_scores[variable_indices[i]]) {
+          best_scores[variable_indices[i]] = score;
+        }
+      }
+    }
+
+    max_marginal_differences->resize(variable_log_potentials.size());
+    for (int i = 0; i < num_multi_variables; ++i) {
+      int num_states = multi_variables_[i]->GetNumStates();
+      int offset = GetVariableIndex(i, 0);
+      // Find the best and second best states.
+      int first = -1;
+      int second = -1;
+      for (int state = 0; state < num_states; ++state) {
+        double score = best_scores[offset + state];
+        if (first < 0 || score > best_scores[offset + first]) {
+          second = first;
+          first = state;
+        } else if (second < 0 || score > best_scores[offset + second]) {
+          second = state;
+        }
+      }
+      for (int state = 0; state < num_states; ++state) {
+        int other = (state == first)? second : first;
+        (*max_marginal_differences)[offset + state] = (other < 0)? 1e100 :
+          best_scores[offset + state] - best_scores[offset + other];
+      }
+    }
+  }
+
+  // Compute the score of a given assignment.
+  void Evaluate(const vector<double> &variable_log_potentials,
+                const vector<double> &additional_log_potentials,
+                const Configuration configuration,
+                double *value) {
+    const vector<int> *index =
+        static_cast<const vector<int>*>(configuration);
+    int k = (*index)[0];
+    int num_multi_variables = multi_variables_.size();
+    const int *variable_indices = &variable_indices_[k * num_multi_variables];
+    *value = additional_log_potentials[k];
+    for (int i = 0; i < num_multi_variables; ++i) {
+      *value += variable_log_potentials[variable_indices[i]];
+    }
+  }
+
+  // Given a configuration with a probability (weight),
+  // increment the vectors of variable and additional posteriors.
+  void UpdateMarginalsFromConfiguration(
+    const Configuration &configuration,
+    double weight,
+    vector<double> *variable_posteriors,
+    vector<double> *additional_posteriors) {
+    const vector<int> *index =
+        static_cast<const vector<int>*>(configuration);
+    int k = (*index)[0];
+    int num_multi_variables = multi_variables_.size();
+    const int *variable_indices = &variable_indices_[k * num_multi_variables];
+    for (int i = 0; i < num_multi_variables; ++i) {
+      (*variable_posteriors)[variable_indices[i]] += weight;
+    }
+    (*additional_posteriors)[k] += weight;
+  }
+
+  // The support of a configuration is one variable per multi-variable,
+  // in increasing order.
+  void ComputeVariableSupport(const Configuration &configuration,
+                              vector<pair<int, double> > *support) {
+    const vector<int> *index =
+        static_cast<const vector<int>*>(configuration);
+    int num_multi_variables = multi_variables_.size();
+    const int *variable_indices =
+      &variable_indices_[(*index)[0] * num_multi_variables];
+    support->resize(num_multi_variables);
+    for (int i = 0; i < num_multi_variables; ++i) {
+      (*support)[i] = make_pair(variable_indices[i], 1.0);
+    }
+  }
+
+  // Count how many common values two configurations have.
+  int CountCommonValues(const Configuration &configuration1,
+                        const Configuration &configuration2) {
+    const vector<int> *index1 =
+        static_cast<const vector<int>*>(configuration1);
+    const vector<int> *index2 =
+        static_cast<const vector<int>*>(configuration2);
+    int num_multi_variables = multi_variables_.size();
+    const int *variable_indices1 =
+      &variable_indices_[(*index1)[0] * num_multi_variables];
+    const int *variable_indices2 =
+      &variable_indices_[(*index2)[0] * num_multi_variables];
+    int count = 0;
+    for (int i = 0; i < num_multi_variables; ++i) {
+      if (variable_indices1[i] == variable_indices2[i]) ++count;
+    }
+    return count;
+  }
+
+  // Check if two configurations are the same.
+  bool SameConfiguration(
+    const Configuration &configuration1,
+    const Configuration &configuration2) {
+    const vector<int> *index1 =
+        static_cast<const vector<int>*>(configuration1);
+    const vector<int> *index2 =
+        static_cast<const vector<int>*>(configuration2);
+    return (*index1)[0] == (*index2)[0];
+  }
+
+  // Hash a configuration by its position in the list, which is unique.
+  bool HashConfiguration(const Configuration &configuration,
+                         unsigned int *hash) {
+    const vector<int> *index =
+        static_cast<const vector<int>*>(configuration);
+    *hash = static_cast<unsigned int>((*index)[0]);
+    return true;
+  }
+
+  // Delete configuration.
+  void DeleteConfiguration(
+    Configuration configuration) {
+    vector<int> *index = static_cast<vector<int>*>(configuration);
+    delete index;
+  }
+
+  Configuration CreateConfiguration() {
+    vector<int>* index = new vector<int>(1, -1);
+    return static_cast<Configuration>(index);
+  }
+
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *index =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*index));
+  }
+
+  // Filter the allowed configurations by the evidence: states which are
+  // not part of any consistent configuration are set to 0, and states
+  // shared by all of them are set to 1. The factor is kept active (and
+  // its links too), so that its additional posteriors are still given by
+  // the solver; the additional evidence only records which
+  // configurations were ruled out.
+  bool SupportsEvidence() { return true; }
+
+  int AddEvidence(vector<bool> *active_links,
+                  vector<int> *evidence,
+                  vector<int> *additional_evidence) {
+    int num_multi_variables = multi_variables_.size();
+    int num_configurations = GetNumConfigurations();
+    additional_evidence->assign(num_configurations, -1);
+
+    // A configuration is consistent if none of its states has evidence 0
+    // and no other state of its multi-variables has evidence 1.
+    vector<int> num_active(num_multi_variables, 0);
+    for (int i = 0; i < num_multi_variables; ++i) {
+      for (int state = 0; state < multi_variables_[i]->GetNumStates();
+           ++state) {
+        if ((*evidence)[GetVariableIndex(i, state)] == 1) ++num_active[i];
+      }
+      if (num_active[i] > 1) return -1;
+    }
+
+    // For each multi-variable, the state it takes in all the consistent
+    // configurations, or -1 if they disagree.
+    vector<int> common_indices(num_multi_variables, -2);
+    vector<bool> used(evidence->size(), false);
+    int num_consistent = 0;
+    int last_consistent = -1;
+    for (int k = 0; k < num_configurations; ++k) {
+      const int *variable_indices =
+        &variable_indices_[k * num_multi_variables];
+      bool consistent = true;
+      for (int i = 0; i < num_multi_variables; ++i) {
+        int value = (*evidence)[variable_indices[i]];
+        if (value == 0 || (value < 0 && num_active[i] > 0)) {
+          consistent = false;
+          break;
+        }
+      }
+      if (!consistent) {
+        (*additional_evidence)[k] = 0;
+        continue;
+      }
+      ++num_consistent;
+      last_consistent = k;
+      for (int i = 0; i < num_multi_variables; ++i) {
+        used[variable_indices[i]] = true;
+        if (common_indices[i] == -2) {
+          common_indices[i] = variable_indices[i];
+        } else if (common_indices[i] != variable_indices[i]) {
+          common_indices[i] = -1;
+        }
+      }
+    }
+    if (num_consistent == 0) return -1;
+    if (num_consistent == 1) (*additional_evidence)[last_consistent] = 1;
+
+    bool changed = false;
+    for (int j = 0; j < evidence->size(); ++j) {
+      if (used[j] || (*evidence)[j] == 0) continue;
+      assert((*evidence)[j] < 0);
+      (*evidence)[j] = 0;
+      changed = true;
+    }
+    for (int i = 0; i < num_multi_variables; ++i) {
+      int j = common_indices[i];
+      if (j < 0 || (*evidence)[j] == 1) continue;
+      assert((*evidence)[j] < 0);
+      (*evidence)[j] = 1;
+      changed = true;
+    }
+    return changed? 1 : 0;
+  }
+
+ public:
+  // Initialize the factor and build internal structure.
+  // configurations contains the states of the allowed configurations, one
+  // after the other (so its size is the number of allowed configurations
+  // times the number of multi-variables); the additional log-potentials
+  // must follow the same order.
+  void Initialize(const vector<MultiVariable*> &multi_variables,
+                  const vector<int> &configurations) {
+    multi_variables_ = multi_variables;
+    int num_multi_variables = multi_variables_.size();
+    assert(num_multi_variables > 0);
+    assert(configurations.size() % num_multi_variables == 0);
+
+    // Build offsets.
+    variable_offsets_.resize(num_multi_variables);
+    variable_offsets_[0] = multi_variables_[0]->GetNumStates();
+    for (int i = 1; i < num_multi_variables; ++i) {
+      variable_offsets_[i] = variable_offsets_[i-1] +
+        multi_variables_[i]->GetNumStates();
+    }
+
+    // Store the allowed configurations as indices of the variables.
+    variable_indices_.resize(configurations.size());
+    for (int j = 0; j < configurations.size(); ++j) {
+      int i = j % num_multi_variables;
+      assert(configurations[j] >= 0 &&
+             configurations[j] < multi_variables_[i]->GetNumStates());
+      variable_indices_[j] = GetVariableIndex(i, configurations[j]);
+    }
+  }
+
+  int GetNumMultiVariables() { return multi_variables_.size(); }
+  MultiVariable *GetMultiVariable(int i) { return multi_variables_[i]; }
+
+  // Number of allowed configurations.
+  int GetNumConfigurations() {
+    return variable_indices_.size() / multi_variables_.size();
+  }
+
+  // State of the i-th multi-variable in the k-th allowed configuration.
+  int GetConfigurationState(int k, int i) {
+    return variable_indices_[k * multi_variables_.size() + i] -
+      GetVariableIndex(i, 0);
+  }
+
+  int GetVariableIndex(int i, int state) {
+    return (i == 0)? state : variable_offsets_[i-1] + state;
+  }
+
+ private:
+  // Multi-variables linked to this factor.
+  vector<MultiVariable*> multi_variables_;
+  // Offsets of the variables in the pool of values.
+  vector<int> variable_offsets_;
+  // Indices of the variables of each allowed configuration, one
+  // configuration after the other.
+  vector<int> variable_indices_;
+};
+
+} // namespace AD3
+
+#endif // FACTOR_SPARSE
@@ -18,305 +18,532 @@
 
 #include "GenericFactor.h"
 #include "Utils.h"
-#define EIGEN
-#ifdef EIGEN
-#include <../Eigen/Eigenvalues>
-#else
-#include "lapacke/lapacke.h"
-#endif
 #include <math.h>
 #include <limits>
 
 namespace AD3 {
 
 #ifdef PRINT_INVERSION_STATS
-static int num_inversions_from_scratch = 0;
-static int num_inversions_incremental = 0;
-static int num_eigenvalue_computations = 0;
+static int num_cholesky_insertions = 0;
+static int num_cholesky_removals = 0;
+static int num_singular_insertions = 0;
+
+static void PrintCholeskyStats() {
+  if (0 == (num_cholesky_insertions + num_cholesky_removals) % 10000) {
+    cout << "Number of Cholesky insertions: "
+         << num_cholesky_insertions << endl;
+    cout << "Number of Cholesky removals: "
+         << num_cholesky_removals << endl;
+    cout << "Number of singular insertions: "
+         << num_singular_insertions << endl;
+  }
+}
 #endif
 
+// Shift added to the similarity matrix M before factorizing it.
+// On the constraint 1'*z = 1, replacing M by M + c*11' only shifts tau by
+// c, and M + c*11' is positive definite whenever the KKT matrix is
+// nonsingular (even if M itself is singular).
+static const double kSimilarityShift = 1.0;
+
+// Number of incremental updates of the scores of the active set before
+// evaluating them from scratch.
+static const int kMaxIncrementalScoreUpdates = 100;
+
 void GenericFactor::ClearActiveSet() {
   for (int j = 0; j < active_set_.size(); ++j) {
     DeleteConfiguration(active_set_[j]);
   }
   active_set_.clear();
+  active_set_hashes_.clear();
+  hash_buckets_.clear();
+  active_set_scores_.clear();
+  active_set_supports_.clear();
+  similarities_.clear();
+  cholesky_.clear();
+  ones_solution_.clear();
+  if (map_configuration_) {
+    DeleteConfiguration(map_configuration_);
+    map_configuration_ = NULL;
+  }
 }
 
-bool GenericFactor::InvertAfterInsertion(
-    const vector<Configuration> &active_set,
-    const Configuration &inserted_element) {
-#ifdef PRINT_INVERSION_STATS
-  ++num_inversions_incremental;
-  if (0 == num_inversions_incremental % 10000) {
-    cout << "Number of incremental inversions: "
-         << num_inversions_incremental << endl;
-    cout << "Number of standard inversions: "
-         << num_inversions_from_scratch << endl;
-    cout << "Number of eigenvalue computations: "
-         << num_eigenvalue_computations << endl;
+// Remove the score, support, and similarities of a configuration
+// of the active set, and update the factorization.
+void GenericFactor::RemoveFromActiveSet(int removed_index) {
+  // The Frank-Wolfe solver keeps neither similarities nor factorization.
+  if (qp_solver_ == QP_SOLVER_ACTIVE_SET) {
+    UpdateCholeskyAfterRemoval(active_set_, removed_index);
+
+    // Drop the row and column of the packed similarities.
+    int size = active_set_.size();
+    int t = removed_index * (removed_index + 1) / 2;
+    for (int i = removed_index + 1; i < size; ++i) {
+      const double *row = &similarities_[i * (i+1) / 2];
+      for (int k = 0; k <= i; ++k) {
+        if (k == removed_index) continue;
+        similarities_[t] = row[k];
+        ++t;
+      }
+    }
+    similarities_.resize(t);
   }
-#endif
-
-  vector<double> inverse_A = inverse_A_;
-  int size_A = active_set.size() + 1;
-  vector<double> r(size_A);
 
-  r[0] = 1.0;
-  for (int i = 0; i < active_set.size(); ++i) {
-    // Count how many variable values the new assignment
-    // have in common with the i-th assignment.
-    int num_common_values = CountCommonValues(active_set[i], inserted_element);
-    r[i+1] = static_cast<double>(num_common_values);
+  bool hashed = active_set_hashes_.size() == active_set_.size();
+  if (hashed) {
+    active_set_hashes_.erase(active_set_hashes_.begin() + removed_index);
+  }
+  DeleteConfiguration(active_set_[removed_index]);
+  active_set_.erase(active_set_.begin() + removed_index);
+  // The configurations after the removed one moved down by one.
+  if (hashed) RebuildHashBuckets();
+  if (active_set_scores_.size() > removed_index) {
+    active_set_scores_.erase(active_set_scores_.begin() + removed_index);
   }
+  if (active_set_supports_.size() > removed_index) {
+    active_set_supports_.erase(active_set_supports_.begin() + removed_index);
+  }
+}
 
-  double r0 = static_cast<double>(CountCommonValues(
-      inserted_element, inserted_element));
-  double s = r0;
-  for (int i = 0; i < size_A; ++i) {
-    if (r[i] == 0.0) continue;
-    s -= r[i] * r[i] * inverse_A[i * size_A + i];
-    for (int j = i+1; j < size_A; ++j) {
-      if (r[j] == 0.0) continue;
-      s -= 2 * r[i] * r[j] * inverse_A[i * size_A + j];
+// Append a configuration to the active set, given its similarities
+// (computed by ComputeSimilarities) and its score. Assumes the
+// factorization was already updated.
+void GenericFactor::AppendToActiveSet(const Configuration &configuration,
+                                      const vector<double> &similarities,
+                                      double score) {
+  similarities_.insert(similarities_.end(),
+                       similarities.begin(), similarities.end());
+  unsigned int hash;
+  if (active_set_hashes_.size() == active_set_.size() &&
+      HashConfiguration(configuration, &hash)) {
+    active_set_hashes_.push_back(hash);
+    if (2 * active_set_hashes_.size() > hash_buckets_.size()) {
+      RebuildHashBuckets();
+    } else {
+      hash_buckets_[hash & (hash_buckets_.size() - 1)].push_back(
+        active_set_.size());
     }
   }
+  active_set_.push_back(configuration);
+  active_set_scores_.push_back(score);
+  active_set_supports_.push_back(vector<pair<int, double> >());
+  ComputeVariableSupport(configuration, &active_set_supports_.back());
+  // The active set now owns the configuration passed to Maximize. This
+  // is done last, since configuration may refer to map_configuration_.
+  if (configuration == map_configuration_) map_configuration_ = NULL;
+}
 
-  if (NEARLY_ZERO_TOL(s, 1e-9)) {
-    if (verbosity_ > 2) {
-      cout << "Warning: updated matrix will become singular after insertion."
-           << endl;
-    }
-    return false;
+// Distribute the positions of the configurations of the active set in a
+// number of buckets which is a power of two, at least twice the size of
+// the active set, according to their hashes.
+void GenericFactor::RebuildHashBuckets() {
+  int num_buckets = 16;
+  while (num_buckets < 2 * active_set_hashes_.size()) num_buckets *= 2;
+  hash_buckets_.resize(num_buckets);
+  for (int b = 0; b < num_buckets; ++b) {
+    hash_buckets_[b].clear();
+  }
+  for (int j = 0; j < active_set_hashes_.size(); ++j) {
+    hash_buckets_[active_set_hashes_[j] & (num_buckets - 1)].push_back(j);
   }
+}
 
-  double invs = 1.0 / s;
-  vector<double> d(size_A, 0.0);
-  for (int i = 0; i < size_A; ++i) {
-    if (r[i] == 0.0) continue;
-    for (int j = 0; j < size_A; ++j) {
-      d[j] += inverse_A[i * size_A + j] * r[i];
+// Return the position of a configuration in the active set, or -1 if it
+// is not there. Factors that implement HashConfiguration only compare the
+// configurations in the bucket of its hash; the hashes are computed again
+// if they are out of date (e.g. after restoring a saved active set).
+int GenericFactor::FindInActiveSet(const Configuration &configuration) {
+  unsigned int hash;
+  if (HashConfiguration(configuration, &hash)) {
+    if (active_set_hashes_.size() != active_set_.size() ||
+        hash_buckets_.empty()) {
+      active_set_hashes_.resize(active_set_.size());
+      for (int j = 0; j < active_set_.size(); ++j) {
+        HashConfiguration(active_set_[j], &active_set_hashes_[j]);
+      }
+      RebuildHashBuckets();
     }
+    const vector<int> &bucket = hash_buckets_[hash &
+                                              (hash_buckets_.size() - 1)];
+    for (int k = 0; k < bucket.size(); ++k) {
+      int j = bucket[k];
+      if (active_set_hashes_[j] == hash &&
+          SameConfiguration(active_set_[j], configuration)) {
+        return j;
+      }
+    }
+    return -1;
   }
 
-  int size_A_after = size_A + 1;
-  inverse_A_.resize(size_A_after * size_A_after);
-  for (int i = 0; i < size_A; ++i) {
-    for (int j = 0; j < size_A; ++j) {
-      inverse_A_[i * size_A_after + j] = inverse_A[i * size_A + j] +
-          invs * d[i] * d[j];
-    }
-    inverse_A_[i * size_A_after + size_A] = -invs * d[i];
-    inverse_A_[size_A * size_A_after + i] = -invs * d[i];
+  for (int j = 0; j < active_set_.size(); ++j) {
+    if (SameConfiguration(active_set_[j], configuration)) return j;
   }
-  inverse_A_[size_A * size_A_after + size_A] = invs;
+  return -1;
+}
 
-  return true;
+Configuration GenericFactor::GetMapConfiguration() {
+  if (!MaximizeOverwritesConfiguration()) return CreateConfiguration();
+  if (!map_configuration_) map_configuration_ = CreateConfiguration();
+  return map_configuration_;
 }
 
-void GenericFactor::InvertAfterRemoval(const vector<Configuration> &active_set,
-                                       int removed_index) {
-#ifdef PRINT_INVERSION_STATS
-  ++num_inversions_incremental;
-  if (0 == num_inversions_incremental % 10000) {
-    cout << "Number of incremental inversions: "
-         << num_inversions_incremental << endl;
-    cout << "Number of standard inversions: "
-         << num_inversions_from_scratch << endl;
-    cout << "Number of eigenvalue computations: "
-         << num_eigenvalue_computations << endl;
+void GenericFactor::DiscardMapConfiguration(Configuration configuration) {
+  if (configuration != map_configuration_) {
+    DeleteConfiguration(configuration);
   }
-#endif
+}
 
-  vector<double> inverse_A = inverse_A_;
-  int size_A = active_set.size() + 1;
-  vector<double> r(size_A);
-
-  ++removed_index; // Index in A has an offset of 1.
-  double invs = inverse_A[removed_index * size_A + removed_index];
-  assert(!NEARLY_ZERO_TOL(invs, 1e-12)); // TODO: Make this tolerance depend on the scale of the data.
-  double s = 1.0 / invs;
-  vector<double> d(size_A - 1, 0.0);
-  int k = 0;
-  for (int i = 0; i < size_A; ++i) {
-    if (i == removed_index) continue;
-    d[k] = -s * inverse_A[removed_index * size_A + i];
-    ++k;
-  }
-
-  int size_A_after = size_A - 1;
-  inverse_A_.resize(size_A_after * size_A_after);
-  k = 0;
-  for (int i = 0; i < size_A; ++i) {
-    if (i == removed_index) continue;
-    int l = 0;
-    for (int j = 0; j < size_A; ++j) {
-      if (j == removed_index) continue;
-      inverse_A_[k * size_A_after + l] = inverse_A[i * size_A + j] -
-          invs * d[k] * d[l];
-      ++l;
-    }
-    ++k;
+// Compute the similarities (number of common values) between a
+// configuration and each configuration in the active set, followed by
+// the similarity of the configuration with itself.
+void GenericFactor::ComputeSimilarities(const Configuration &configuration,
+                                        vector<double> *similarities) {
+  int size = active_set_.size();
+  similarities->resize(size + 1);
+  for (int i = 0; i < size; ++i) {
+    (*similarities)[i] = static_cast<double>(
+        CountCommonValues(active_set_[i], configuration));
   }
+  (*similarities)[size] = static_cast<double>(
+      CountCommonValues(configuration, configuration));
 }
 
-// Compute Mnz'*Mnz
-void GenericFactor::ComputeActiveSetSimilarities(
-    const vector<Configuration> &active_set,
-    vector<double> *similarities) {
-  int size = active_set.size();
+// The buffers are released on return, so that the factor does not keep a
+// copy of the size of its additional log-potentials.
+void GenericFactor::ComputeVariableSupport(
+    const Configuration &configuration,
+    vector<pair<int, double> > *support) {
+  vector<double> variable_posteriors(binary_variables_.size(), 0.0);
+  vector<double> additional_posteriors(GetAdditionalLogPotentials().size(),
+                                       0.0);
+  UpdateMarginalsFromConfiguration(configuration, 1.0,
+                                   &variable_posteriors,
+                                   &additional_posteriors);
+  support->clear();
+  for (int i = 0; i < variable_posteriors.size(); ++i) {
+    if (variable_posteriors[i] != 0.0) {
+      support->push_back(make_pair(i, variable_posteriors[i]));
+    }
+  }
+}
 
-  // Compute similarity matrix.
-  similarities->resize(size * size);
-  (*similarities)[0] = 0.0;
-  for (int i = 0; i < active_set.size(); ++i) {
-    (*similarities)[i*size + i] = static_cast<double>(
-        CountCommonValues(active_set[i], active_set[i]));
-    for (int j = i+1; j < active_set.size(); ++j) {
-      // Count how many variable values the i-th and j-th
-      // assignments have in common.
-      int num_common_values = CountCommonValues(active_set[i], active_set[j]);
-      (*similarities)[i*size + j] = num_common_values;
-      (*similarities)[j*size + i] = num_common_values;
+// Compute the variable marginals of a distribution over the active set
+// from the supports of its configurations. This only overwrites the
+// variable posteriors.
+void GenericFactor::ComputeVariableMarginalsFromSupports(
+    const vector<double> &distribution,
+    vector<double> *variable_posteriors) {
+  variable_posteriors->assign(binary_variables_.size(), 0.0);
+  for (int j = 0; j < active_set_.size(); ++j) {
+    const vector<pair<int, double> > &support = active_set_supports_[j];
+    double weight = distribution[j];
+    for (int k = 0; k < support.size(); ++k) {
+      (*variable_posteriors)[support[k].first] += weight * support[k].second;
     }
   }
 }
 
-// Compute eigendecomposition of M'*M.
-// Remark: overwrite similarities with the eigenvectors.
-void GenericFactor::EigenDecompose(vector<double> *similarities,
-                            vector<double> *eigenvalues) {
-#ifdef PRINT_INVERSION_STATS
-  ++num_eigenvalue_computations;
-  if (0 == num_eigenvalue_computations % 10000) {
-    cout << "Number of incremental inversions: "
-         << num_inversions_incremental << endl;
-    cout << "Number of standard inversions: "
-         << num_inversions_from_scratch << endl;
-    cout << "Number of eigenvalue computations: "
-         << num_eigenvalue_computations << endl;
+// Bring the scores of the active set up to date with new potentials.
+// If only the variable log-potentials changed, the scores are updated
+// through the supports of the configurations. Otherwise (or when the
+// scores are not available, e.g. after restoring a saved active set)
+// they are evaluated from scratch. The additional log-potentials are
+// known to be unchanged only if they are the cached ones (as in
+// SolveQPCached), with the same version; those passed by other callers
+// are always evaluated from scratch.
+void GenericFactor::UpdateActiveSetScores(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials) {
+  int size = active_set_.size();
+  int additional_version =
+    (&additional_log_potentials == &GetCachedAdditionalLogPotentials())?
+    GetCachedAdditionalVersion() : -1;
+  bool evaluate = active_set_scores_.size() != size ||
+    active_set_supports_.size() != size ||
+    scored_variable_log_potentials_.size() !=
+    variable_log_potentials.size() ||
+    additional_version < 0 ||
+    additional_version != scored_additional_version_;
+
+  if (!evaluate) {
+    // Find the variable log-potentials that changed.
+    int num_changed = 0;
+    score_differences_.resize(variable_log_potentials.size());
+    for (int i = 0; i < variable_log_potentials.size(); ++i) {
+      score_differences_[i] = variable_log_potentials[i] -
+        scored_variable_log_potentials_[i];
+      if (score_differences_[i] != 0.0) ++num_changed;
+    }
+    if (num_changed == 0) return;
+    // Evaluate from scratch once in a while, so that rounding errors do
+    // not accumulate.
+    ++num_score_updates_;
+    if (num_score_updates_ >= kMaxIncrementalScoreUpdates) evaluate = true;
   }
-#endif
 
-  int size = static_cast<int>(sqrt(static_cast<double>(similarities->size())));
-#ifdef EIGEN
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
-  Eigen::MatrixXd sim(size, size);
-  int t = 0;
-  for (int i = 0; i < size; ++i) {
+  if (evaluate) {
+    active_set_scores_.resize(size);
+    if (active_set_supports_.size() != size) {
+      active_set_supports_.resize(size);
+      for (int j = 0; j < size; ++j) {
+        ComputeVariableSupport(active_set_[j], &active_set_supports_[j]);
+      }
+    }
     for (int j = 0; j < size; ++j) {
-      sim(i, j) = (*similarities)[t];
-      ++t;
+      Evaluate(variable_log_potentials,
+               additional_log_potentials,
+               active_set_[j],
+               &active_set_scores_[j]);
+    }
+    scored_additional_version_ = additional_version;
+    num_score_updates_ = 0;
+  } else {
+    for (int j = 0; j < size; ++j) {
+      const vector<pair<int, double> > &support = active_set_supports_[j];
+      double difference = 0.0;
+      for (int k = 0; k < support.size(); ++k) {
+        difference += support[k].second * score_differences_[support[k].first];
+      }
+      active_set_scores_[j] += difference;
     }
   }
-  es.compute(sim);
-  const Eigen::VectorXd &eigvals = es.eigenvalues();
-  eigenvalues->resize(size);
-  for (int i = 0; i < size; ++i) {
-    (*eigenvalues)[i] = eigvals[i];
+  scored_variable_log_potentials_ = variable_log_potentials;
+}
+
+bool GenericFactor::SaveActiveSet(ActiveSetState *state) {
+  state->active_set.clear();
+  for (int j = 0; j < active_set_.size(); ++j) {
+    Configuration configuration = CopyConfiguration(active_set_[j]);
+    if (!configuration) {
+      DeleteActiveSet(state);
+      return false;
+    }
+    state->active_set.push_back(configuration);
   }
-  const Eigen::MatrixXd &eigvectors = es.eigenvectors().transpose();
-  t = 0;
-  for (int i = 0; i < size; ++i) {
-    for (int j = 0; j < size; ++j) {
-      (*similarities)[t] = eigvectors(i, j);
-      ++t;
+  state->distribution = distribution_;
+  state->cholesky = cholesky_;
+  state->similarities = similarities_;
+  return true;
+}
+
+void GenericFactor::RestoreActiveSet(const ActiveSetState &state) {
+  ClearActiveSet();
+  for (int j = 0; j < state.active_set.size(); ++j) {
+    active_set_.push_back(CopyConfiguration(state.active_set[j]));
+  }
+  distribution_ = state.distribution;
+  // The scores are evaluated again in the next call to SolveQP.
+  cholesky_ = state.cholesky;
+  similarities_ = state.similarities;
+}
+
+void GenericFactor::DeleteActiveSet(ActiveSetState *state) {
+  for (int j = 0; j < state->active_set.size(); ++j) {
+    DeleteConfiguration(state->active_set[j]);
+  }
+  state->active_set.clear();
+  state->distribution.clear();
+  state->cholesky.clear();
+  state->similarities.clear();
+}
+
+vector<double> GenericFactor::GetQPInvA() {
+  assert(qp_solver_ == QP_SOLVER_ACTIVE_SET);
+  int size_A = active_set_.size() + 1;
+  vector<double> inverse_A(size_A * size_A);
+  vector<double> b(size_A, 0.0);
+  vector<double> z;
+  double tau;
+  for (int j = 0; j < size_A; ++j) {
+    b[j] = 1.0;
+    SolveKKTSystem(b, &z, &tau);
+    b[j] = 0.0;
+    // A is symmetric, so its inverse can be filled by columns.
+    inverse_A[j] = tau;
+    for (int i = 0; i < z.size(); ++i) {
+      inverse_A[(i+1) * size_A + j] = z[i];
     }
   }
-#else
-  lapack_int info;
-  eigenvalues->resize(size);
-  info = LAPACKE_dsyev(LAPACK_COL_MAJOR, 'V', 'U',
-                       size,
-                       &(*similarities)[0],
-                       size,
-                       &(*eigenvalues)[0]);
-#endif
+  return inverse_A;
 }
 
-// Compute inverse of A from scratch.
-// Uses eigendecomposition of M'*M.
-void GenericFactor::Invert(const vector<double> &eigenvalues,
-                           const vector<double> &eigenvectors) {
+bool GenericFactor::UpdateCholeskyAfterInsertion(
+    const vector<double> &similarities,
+    vector<double> *coefficients) {
 #ifdef PRINT_INVERSION_STATS
-  ++num_inversions_from_scratch;
-  if (0 == num_inversions_from_scratch % 10000) {
-    cout << "Number of incremental inversions: "
-         << num_inversions_incremental << endl;
-    cout << "Number of standard inversions: "
-         << num_inversions_from_scratch << endl;
-    cout << "Number of eigenvalue computations: "
-         << num_eigenvalue_computations << endl;
-  }
+  ++num_cholesky_insertions;
+  PrintCholeskyStats();
 #endif
-  int size = eigenvalues.size();
-  int size_A = size + 1;
-  inverse_A_.assign(size_A * size_A, 0.0);
+
+  // Solve L*l = g, where g are the (shifted) similarities between the
+  // active set and the new configuration. The new row l is computed in
+  // place at the end of the factor.
+  int size = similarities.size() - 1;
+  int offset = cholesky_.size();
+  cholesky_.resize(offset + size + 1);
+  double *l = &cholesky_[offset];
+  double squared_norm = 0.0;
   for (int i = 0; i < size; ++i) {
-    double s = 1.0 / eigenvalues[i];
-    const double *v = &eigenvectors[0] + i * size;
-    for (int j = 0; j < size; ++j) {
-      for (int k = j; k < size; ++k) {
-        inverse_A_[(1+j)*size_A + (1+k)] += s * v[j] * v[k];
+    double value = similarities[i] + kSimilarityShift;
+    const double *row = &cholesky_[i * (i+1) / 2];
+    for (int k = 0; k < i; ++k) {
+      value -= row[k] * l[k];
+    }
+    l[i] = value / row[i];
+    squared_norm += l[i] * l[i];
+  }
+
+  // The Schur complement of the new diagonal element.
+  double s = similarities[size] + kSimilarityShift - squared_norm;
+
+  if (s <= 1e-9) {
+    if (verbosity_ > 2) {
+      cout << "Warning: updated matrix will become singular after insertion."
+           << endl;
+    }
+#ifdef PRINT_INVERSION_STATS
+    ++num_singular_insertions;
+#endif
+    if (coefficients) {
+      // Solve L'*coefficients = l.
+      coefficients->assign(l, l + size);
+      for (int i = size - 1; i >= 0; --i) {
+        const double *row = &cholesky_[i * (i+1) / 2];
+        (*coefficients)[i] /= row[i];
+        for (int k = 0; k < i; ++k) {
+          (*coefficients)[k] -= row[k] * (*coefficients)[i];
+        }
       }
     }
+    cholesky_.resize(offset);
+    return false;
   }
-  double s = 0.0;
-  vector<double> d(size, 0.0);
-  for (int j = 1; j <= size; ++j) {
-    s -= inverse_A_[j*size_A + j];
-    d[j-1] += inverse_A_[j*size_A + j];
-    for (int k = j+1; k <= size; ++k) {
-      inverse_A_[k*size_A + j] = inverse_A_[j*size_A + k];
-      s -= 2*inverse_A_[j*size_A + k];
-      d[j-1] += inverse_A_[j*size_A + k];
-      d[k-1] += inverse_A_[j*size_A + k];
+
+  l[size] = sqrt(s);
+  ones_solution_.clear();
+  return true;
+}
+
+void GenericFactor::UpdateCholeskyAfterRemoval(
+    const vector<Configuration> &active_set,
+    int removed_index) {
+#ifdef PRINT_INVERSION_STATS
+  ++num_cholesky_removals;
+  PrintCholeskyStats();
+#endif
+
+  // Without the removed row, L is still a factor of the reduced matrix,
+  // but each row below it has one element above the diagonal. These are
+  // zeroed by Givens rotations of consecutive columns.
+  int size = active_set.size();
+  for (int j = removed_index; j < size - 1; ++j) {
+    double *row = &cholesky_[(j+1) * (j+2) / 2];
+    double a = row[j];
+    double b = row[j+1];
+    double h = sqrt(a * a + b * b);
+    assert(h > 0.0);
+    double c = a / h;
+    double s = b / h;
+    row[j] = h;
+    row[j+1] = 0.0;
+    for (int i = j + 2; i < size; ++i) {
+      row = &cholesky_[i * (i+1) / 2];
+      double x = row[j];
+      double y = row[j+1];
+      row[j] = c * x + s * y;
+      row[j+1] = -s * x + c * y;
     }
   }
 
-  double invs = 1.0 / s;
-  inverse_A_[0] = invs;
-  for (int j = 1; j <= size; ++j) {
-    inverse_A_[j*size_A] = -invs * d[j-1];
-    inverse_A_[j] = inverse_A_[j*size_A];
-    inverse_A_[j*size_A + j] += invs * d[j-1] * d[j-1];
-    for (int k = j+1; k <= size; ++k) {
-      inverse_A_[j*size_A + k] += invs * d[j-1] * d[k-1];
-      inverse_A_[k*size_A + j] = inverse_A_[j*size_A + k];
+  // Pack the remaining rows (the last column is now zero).
+  int t = removed_index * (removed_index + 1) / 2;
+  for (int i = removed_index + 1; i < size; ++i) {
+    const double *row = &cholesky_[i * (i+1) / 2];
+    for (int k = 0; k < i; ++k) {
+      cholesky_[t] = row[k];
+      ++t;
     }
   }
+  cholesky_.resize(t);
+  ones_solution_.clear();
 }
 
-// Checks if M'*M is singular.
-// If so, asserts that the null space is 1-dimensional
-// and returns a basis of the null space.
-bool GenericFactor::IsSingular(vector<double> &eigenvalues,
-                        vector<double> &eigenvectors,
-                        vector<double> *null_space_basis) {
-  int size = eigenvalues.size();
-  int zero_eigenvalue = -1;
+// Solve L*L'*x = x by forward and backward substitution. Both go through
+// the rows of L, so that memory is accessed contiguously.
+void GenericFactor::SolveWithCholesky(vector<double> *x) {
+  int size = x->size();
   for (int i = 0; i < size; ++i) {
-    if (eigenvalues[i] < 1e-12) {
-      if (zero_eigenvalue >= 0) {
-        cout << eigenvalues[i] << " " << eigenvalues[zero_eigenvalue] << endl;
-        assert(false);
-      }
-      zero_eigenvalue = i;
+    const double *row = &cholesky_[i * (i+1) / 2];
+    double value = (*x)[i];
+    for (int k = 0; k < i; ++k) {
+      value -= row[k] * (*x)[k];
     }
+    (*x)[i] = value / row[i];
   }
-  if (zero_eigenvalue < 0) return false;
-  if (null_space_basis) {
-    null_space_basis->assign(eigenvectors.begin() +
-                             zero_eigenvalue * size,
-                             eigenvectors.begin() +
-                             (1 + zero_eigenvalue) * size);
+  for (int i = size - 1; i >= 0; --i) {
+    const double *row = &cholesky_[i * (i+1) / 2];
+    (*x)[i] /= row[i];
+    double value = (*x)[i];
+    for (int k = 0; k < i; ++k) {
+      (*x)[k] -= row[k] * value;
+    }
   }
-  return true;
+}
+
+// The KKT system is 1'*z = b[0], tau*1 + M*z = b[1:]. With G = M + c*11',
+// it becomes G*z = b[1:] - (tau - c*b[0])*1, which is solved for the two
+// right hand sides b[1:] and 1.
+void GenericFactor::SolveKKTSystem(const vector<double> &b,
+                                   vector<double> *z,
+                                   double *tau) {
+  int size = active_set_.size();
+  // The solution for the right hand side 1 only depends on the
+  // factorization, and is kept until it changes.
+  if (ones_solution_.size() != size) {
+    ones_solution_.assign(size, 1.0);
+    SolveWithCholesky(&ones_solution_);
+    sum_ones_solution_ = 0.0;
+    for (int i = 0; i < size; ++i) {
+      sum_ones_solution_ += ones_solution_[i];
+    }
+  }
+
+  z->assign(b.begin() + 1, b.end());
+  SolveWithCholesky(z);
+  double sum_z = 0.0;
+  for (int i = 0; i < size; ++i) {
+    sum_z += (*z)[i];
+  }
+
+  double shifted_tau = (sum_z - b[0]) / sum_ones_solution_;
+  for (int i = 0; i < size; ++i) {
+    (*z)[i] -= shifted_tau * ones_solution_[i];
+  }
+  *tau = shifted_tau + kSimilarityShift * b[0];
 }
 
 void GenericFactor::SolveQP(const vector<double> &variable_log_potentials,
                             const vector<double> &additional_log_potentials,
                             vector<double> *variable_posteriors,
                             vector<double> *additional_posteriors) {
+  if (qp_solver_ == QP_SOLVER_FRANK_WOLFE) {
+    SolveQPFrankWolfe(variable_log_potentials,
+                      additional_log_potentials,
+                      variable_posteriors,
+                      additional_posteriors);
+    return;
+  }
+
+  // Update the scores of the cached active set.
+  UpdateActiveSetScores(variable_log_potentials, additional_log_potentials);
+
+  // The vectors below are kept across calls, so that the loop does not
+  // allocate memory.
+  vector<double> &similarities = scratch_similarities_;
+  vector<double> &coefficients = scratch_coefficients_;
+  vector<double> &b = scratch_b_;
+  vector<double> &z = scratch_z_;
+  vector<double> &scores = scratch_scores_;
 
   // Initialize the active set.
   if (active_set_.size() == 0) {
@@ -325,77 +552,59 @@ void GenericFactor::SolveQP(const vector<double> &variable_log_potentials,
     distribution_.clear();
     // Initialize by solving the LP, discarding the quadratic
     // term.
-    Configuration configuration = CreateConfiguration();
+    Configuration configuration = GetMapConfiguration();
     double value;
     Maximize(variable_log_potentials,
              additional_log_potentials,
              configuration,
              &value);
-    active_set_.push_back(configuration);
-    distribution_.push_back(1.0);
+    double score;
+    Evaluate(variable_log_potentials,
+             additional_log_potentials,
+             configuration,
+             &score);
 
-    // Initialize inv(A) as [-M,1;1,0].
-    inverse_A_.resize(4);
-    inverse_A_[0] = static_cast<double>(
-        -CountCommonValues(configuration, configuration));
-    inverse_A_[1] = 1;
-    inverse_A_[2] = 1;
-    inverse_A_[3] = 0;
+    // Initialize the Cholesky factor as sqrt(M + 1).
+    ComputeSimilarities(configuration, &similarities);
+    bool singular = !UpdateCholeskyAfterInsertion(similarities, NULL);
+    assert(!singular);
+    AppendToActiveSet(configuration, similarities, score);
+    distribution_.push_back(1.0);
   }
 
   bool changed_active_set = true;
-  vector<double> z;
   int num_max_iterations = num_max_iterations_QP_;
   double tau = 0;
   for (int iter = 0; iter < num_max_iterations; ++iter) {
     bool same_as_before = true;
     bool unbounded = false;
     if (changed_active_set) {
-      // Recompute vector b.
-      vector<double> b(active_set_.size() + 1, 0.0);
+      // Recompute vector b from the cached scores.
+      b.resize(active_set_.size() + 1);
       b[0] = 1.0;
       for (int i = 0; i < active_set_.size(); ++i) {
-        const Configuration &configuration = active_set_[i];
-        double score;
-        Evaluate(variable_log_potentials,
-                 additional_log_potentials,
-                 configuration,
-                 &score);
-        b[i+1] = score;
+        b[i+1] = active_set_scores_[i];
       }
 
       // Solve the system Az = b.
-      z.resize(active_set_.size());
-      int size_A = active_set_.size() + 1;
-      for (int i = 0; i < active_set_.size(); ++i) {
-        z[i] = 0.0;
-        for (int j = 0; j < size_A; ++j) {
-          z[i] += inverse_A_[(i+1) * size_A + j] * b[j];
-        }
-      }
-      tau = 0.0;
-      for (int j = 0; j < size_A; ++j) {
-        tau += inverse_A_[j] * b[j];
-      }
+      SolveKKTSystem(b, &z, &tau);
 
       same_as_before = false;
     }
 
     if (same_as_before) {
       // Compute the variable marginals from the full distribution
-      // stored in z.
-      ComputeMarginalsFromSparseDistribution(active_set_,
-                                             z,
-                                             variable_posteriors,
-                                             additional_posteriors);
+      // stored in z. The additional posteriors are only computed before
+      // returning.
+      ComputeActiveSetVariableMarginals(z, variable_posteriors);
 
       // Get the most violated constraint
       // (by calling the black box that computes the MAP).
-      vector<double> scores = variable_log_potentials;
+      scores.resize(variable_log_potentials.size());
       for (int i = 0; i < scores.size(); ++i) {
-        scores[i] -= (*variable_posteriors)[i];
+        scores[i] = variable_log_potentials[i] - (*variable_posteriors)[i];
       }
-      Configuration configuration = CreateConfiguration();
+      Configuration configuration = GetMapConfiguration();
       double value;
       Maximize(scores,
                additional_log_potentials,
@@ -405,137 +614,98 @@ void GenericFactor::SolveQP(const vector<double> &variable_log_potentials,
       double very_small_threshold = 1e-9;
       if (value <= tau + very_small_threshold) { // value <= tau.
         // We have found the solution;
-        // the distribution, active set, and inv(A) are cached for the next round.
+        // the distribution, active set, and factorization are cached for
+        // the next round.
         if (verbosity_ > 2) {
             cout << "Converged." << endl;
         }
-        DeleteConfiguration(configuration);
+        DiscardMapConfiguration(configuration);
+        ComputeActiveSetMarginals(z,
+                                  variable_posteriors,
+                                  additional_posteriors);
         return;
       } else {
-        for (int k = 0; k < active_set_.size(); ++k) {
-          // This is expensive and should just be a sanity check.
-          // However, in practice, numerical issues force an already existing
-          // configuration to try to be added. Therefore, we always check
-          // if a configuration already exists before inserting it.
-          // If it does, that means the active set method converged to a
-          // solution (but numerical issues had prevented us to see it.)
-          if (SameConfiguration(active_set_[k], configuration)) {
-            if (verbosity_ > 2) {
-              cout << "Warning: value - tau = "
-                   << value - tau << " " << value << " " << tau
-                   << endl;
-            }
-            // We have found the solution;
-            // the distribution, active set, and inv(A)
-            // are cached for the next round.
-            DeleteConfiguration(configuration);
-
-            // Just in case, clean the cache.
-            // This may prevent eventual numerical problems in the future.
-            if (clear_cache_) {
-              for (int j = 0; j < active_set_.size(); ++j) {
-                if (j == k) continue; // This configuration was deleted already.
-                DeleteConfiguration(active_set_[j]);
-              }
-              active_set_.clear();
-              inverse_A_.clear();
-              distribution_.clear();
-            }
-
-            // Return.
-            return;
+        // This should just be a sanity check.
+        // However, in practice, numerical issues force an already existing
+        // configuration to try to be added. Therefore, we always check
+        // if a configuration already exists before inserting it.
+        // If it does, that means the active set method converged to a
+        // solution (but numerical issues had prevented us to see it.)
+        // Factors that hash their configurations make this check cheap.
+        if (FindInActiveSet(configuration) >= 0) {
+          if (verbosity_ > 2) {
+            cout << "Warning: value - tau = "
+                 << value - tau << " " << value << " " << tau
+                 << endl;
           }
+          // We have found the solution;
+          // the distribution, active set, and factorization
+          // are cached for the next round.
+          DiscardMapConfiguration(configuration);
+          ComputeActiveSetMarginals(z,
+                                    variable_posteriors,
+                                    additional_posteriors);
+
+          // Just in case, clean the cache.
+          // This may prevent eventual numerical problems in the future.
+          if (clear_cache_) {
+            ClearActiveSet();
+            distribution_.clear();
+          }
+
+          // Return.
+          return;
         }
         z.push_back(0.0);
         distribution_ = z;
 
-        // Update inv(A).
-        bool singular = !InvertAfterInsertion(active_set_, configuration);
+        // Update the factorization.
+        ComputeSimilarities(configuration, &similarities);
+        bool singular = !UpdateCholeskyAfterInsertion(similarities,
+                                                      &coefficients);
         if (singular) {
           // If adding a new configuration causes the matrix to be singular,
-          // don't just add it. Instead, look for a configuration in the null
-          // space and remove it before inserting the new one.
+          // don't just add it. Instead, remove a configuration of the affine
+          // combination of the active set that equals the new one (these
+          // coefficients come for free from the factorization).
           // Right now, if more than one such configuration exists, we just
           // remove the first one we find. There's a chance this could cause
           // some cyclic behaviour. If that is the case, we should randomize
           // this choice.
-          // Note: This step is expensive and requires an eigendecomposition.
-          // TODO: I think there is a graph interpretation for this problem.
-          // Maybe some specialized graph algorithm is cheaper than doing
-          // the eigendecomposition.
-          vector<double> similarities(active_set_.size() * active_set_.size());
-          ComputeActiveSetSimilarities(active_set_, &similarities);
-          vector<double> padded_similarities((active_set_.size()+2) *
-                                             (active_set_.size()+2), 1.0);
-          for (int i = 0; i < active_set_.size(); ++i) {
-            for (int j = 0; j < active_set_.size(); ++j) {
-              padded_similarities[(i+1)*(active_set_.size()+2) + (j+1)] =
-                  similarities[i*active_set_.size() + j];
-            }
-          }
-          padded_similarities[0] = 0.0;
-          for (int i = 0; i < active_set_.size(); ++i) {
-            double value = static_cast<double>(
-                CountCommonValues(configuration, active_set_[i]));
-            padded_similarities[(i+1)*(active_set_.size()+2) +
-                                (active_set_.size()+1)] = value;
-            padded_similarities[(active_set_.size()+1)*(active_set_.size()+2) +
-                                (i+1)] = value;
-          }
-          double value = static_cast<double>(
-              CountCommonValues(configuration, configuration));
-          padded_similarities[(active_set_.size()+1)*(active_set_.size()+2) +
-                              (active_set_.size()+1)] = value;
-
-          vector<double> eigenvalues(active_set_.size()+2);
-          EigenDecompose(&padded_similarities, &eigenvalues);
-          int zero_eigenvalue = -1;
-          for (int i = 0; i < active_set_.size()+2; ++i) {
-            if (NEARLY_EQ_TOL(eigenvalues[i], 0.0, 1e-9)) {
-              if (zero_eigenvalue >= 0) {
-                // If this happens, something failed. Maybe a numerical problem
-                // may cause this. In that case, just give up, clean the cache
-                // and return. Hopefully the next iteration will fix it.
-                cout << "Multiple zero eigenvalues: "
-                     << eigenvalues[zero_eigenvalue] << " and "
-                     << eigenvalues[i] << endl;
-                cout << "Warning: Giving up." << endl;
-                // Clean the cache.
-                for (int j = 0; j < active_set_.size(); ++j) {
-                  DeleteConfiguration(active_set_[j]);
-                }
-                active_set_.clear();
-                inverse_A_.clear();
-                distribution_.clear();
-                return;
-              }
-              zero_eigenvalue = i;
-            }
-          }
-          assert(zero_eigenvalue >= 0);
-          vector<int> configurations_to_remove;
-          for (int j = 1; j < active_set_.size()+1; ++j) {
-            double value = padded_similarities[zero_eigenvalue*(active_set_.size()+2) + j];
-            if (!NEARLY_EQ_TOL(value, 0.0, 1e-9)) {
-              configurations_to_remove.push_back(j-1);
+          int j = -1;
+          int num_configurations_to_remove = 0;
+          for (int k = 0; k < active_set_.size(); ++k) {
+            if (!NEARLY_EQ_TOL(coefficients[k], 0.0, 1e-9)) {
+              if (j < 0) j = k;
+              ++num_configurations_to_remove;
             }
           }
           if (verbosity_ > 2) {
-            cout << "Pick a configuration to remove (" << configurations_to_remove.size()
+            cout << "Pick a configuration to remove (" << num_configurations_to_remove
                  << " out of " << active_set_.size() << ")." << endl;
           }
 
-          assert(configurations_to_remove.size() >= 1);
-          int j = configurations_to_remove[0];
-
-          // Update inv(A).
-          InvertAfterRemoval(active_set_, j);
+          if (j < 0) {
+            // If this happens, something failed. Maybe a numerical problem
+            // may cause this. In that case, just give up, clean the cache
+            // and return. Hopefully the next iteration will fix it.
+            cout << "Warning: Giving up." << endl;
+            DiscardMapConfiguration(configuration);
+            ComputeActiveSetMarginals(z,
+                                      variable_posteriors,
+                                      additional_posteriors);
+            ClearActiveSet();
+            distribution_.clear();
+            return;
+          }
 
-          // Remove blocking constraint from the active set.
-          DeleteConfiguration(active_set_[j]); // Delete configutation.
-          active_set_.erase(active_set_.begin() + j);
+          // Remove the configuration from the active set (this also
+          // updates the factorization).
+          RemoveFromActiveSet(j);
+          distribution_.erase(distribution_.begin() + j);
 
-          singular = !InvertAfterInsertion(active_set_, configuration);
+          similarities.erase(similarities.begin() + j);
+          singular = !UpdateCholeskyAfterInsertion(similarities, NULL);
           assert(!singular);
         }
 
@@ -544,7 +714,12 @@ void GenericFactor::SolveQP(const vector<double> &variable_log_potentials,
           cout << "Inserted one element to the active set (iteration "
                << iter << ")." << endl;
         }
-        active_set_.push_back(configuration);
+        double score;
+        Evaluate(variable_log_potentials,
+                 additional_log_potentials,
+                 configuration,
+                 &score);
+        AppendToActiveSet(configuration, similarities, score);
         changed_active_set = true;
       }
     } else {
@@ -589,17 +764,14 @@ void GenericFactor::SolveQP(const vector<double> &variable_log_potentials,
           }
         }
 
-        // Update inv(A).
-        InvertAfterRemoval(active_set_, blocking);
-
-        // Remove blocking constraint from the active set.
+        // Remove blocking constraint from the active set (this also
+        // updates the factorization).
         if (verbosity_ > 2) {
           cout << "Removed one element to the active set (iteration "
                << iter << ")." << endl;
         }
 
-        DeleteConfiguration(active_set_[blocking]); // Delete configutation.
-        active_set_.erase(active_set_.begin() + blocking);
+        RemoveFromActiveSet(blocking);
 
         z.erase(z.begin() + blocking);
         distribution_.erase(distribution_.begin() + blocking);
@@ -619,10 +791,184 @@ void GenericFactor::SolveQP(const vector<double> &variable_log_potentials,
   // Return the best existing solution by computing the variable marginals
   // from the full distribution stored in z.
   //assert(false);
-  ComputeMarginalsFromSparseDistribution(active_set_,
-                                         z,
-                                         variable_posteriors,
-                                         additional_posteriors);
+  ComputeActiveSetMarginals(z,
+                            variable_posteriors,
+                            additional_posteriors);
+}
+
+// Pairwise Frank-Wolfe for the same QP as the active set method,
+//   max_p sum_j p_j * score_j - 0.5 * ||mu||^2, with mu = sum_j p_j * u_j,
+// where u_j are the variable marginals of configuration j. The gradient
+// with respect to p_j is score_j - u_j'*mu. Each iteration calls Maximize
+// to find the configuration with the largest gradient (the Frank-Wolfe
+// vertex), takes the configuration in the active set with the smallest
+// gradient (the away vertex), and moves probability mass from the latter
+// to the former with an exact line search. Configurations whose mass
+// goes to zero leave the active set. Only the supports of the
+// configurations are used, so the cost per iteration is linear in the
+// size of the active set. The active set and distribution are cached
+// for the next call, as in the active set method.
+void GenericFactor::SolveQPFrankWolfe(
+    const vector<double> &variable_log_potentials,
+    const vector<double> &additional_log_potentials,
+    vector<double> *variable_posteriors,
+    vector<double> *additional_posteriors) {
+  // Update the scores of the cached active set.
+  UpdateActiveSetScores(variable_log_potentials, additional_log_potentials);
+
+  vector<double> no_similarities;
+
+  // Initialize the active set by solving the LP.
+  if (active_set_.size() == 0) {
+    distribution_.clear();
+    Configuration configuration = GetMapConfiguration();
+    double value;
+    Maximize(variable_log_potentials,
+             additional_log_potentials,
+             configuration,
+             &value);
+    double score;
+    Evaluate(variable_log_potentials,
+             additional_log_potentials,
+             configuration,
+             &score);
+    AppendToActiveSet(configuration, no_similarities, score);
+    distribution_.push_back(1.0);
+  }
+
+  // The variable marginals mu are kept up to date through the supports.
+  ComputeVariableMarginalsFromSupports(distribution_, variable_posteriors);
+  vector<double> &marginals = *variable_posteriors;
+  vector<double> &scores = scratch_scores_;
+  scores.resize(variable_log_potentials.size());
+  double very_small_threshold = 1e-9;
+  int iter;
+  for (iter = 0; iter < num_max_iterations_QP_; ++iter) {
+    // Gradients of the active set; pick the away vertex.
+    int away = -1;
+    double away_gradient = 0.0;
+    double average_gradient = 0.0;
+    for (int j = 0; j < active_set_.size(); ++j) {
+      const vector<pair<int, double> > &support = active_set_supports_[j];
+      double gradient = active_set_scores_[j];
+      for (int k = 0; k < support.size(); ++k) {
+        gradient -= support[k].second * marginals[support[k].first];
+      }
+      average_gradient += distribution_[j] * gradient;
+      if (away < 0 || gradient < away_gradient) {
+        away = j;
+        away_gradient = gradient;
+      }
+    }
+
+    // Get the Frank-Wolfe vertex (by calling the black box that computes
+    // the MAP).
+    for (int i = 0; i < scores.size(); ++i) {
+      scores[i] = variable_log_potentials[i] - marginals[i];
+    }
+    Configuration configuration = GetMapConfiguration();
+    double value;
+    Maximize(scores,
+             additional_log_potentials,
+             configuration,
+             &value);
+
+    // The duality gap is the gradient of the Frank-Wolfe vertex minus
+    // the average gradient.
+    if (value - average_gradient <= very_small_threshold) {
+      if (verbosity_ > 2) {
+        cout << "Converged." << endl;
+      }
+      DiscardMapConfiguration(configuration);
+      break;
+    }
+
+    int toward = FindInActiveSet(configuration);
+    if (toward == away) {
+      // Only possible because of numerical issues.
+      DiscardMapConfiguration(configuration);
+      break;
+    }
+    if (toward >= 0) {
+      DiscardMapConfiguration(configuration);
+    } else {
+      if (verbosity_ > 2) {
+        cout << "Inserted one element to the active set (iteration "
+             << iter << ")." << endl;
+      }
+      double score;
+      Evaluate(variable_log_potentials,
+               additional_log_potentials,
+               configuration,
+               &score);
+      AppendToActiveSet(configuration, no_similarities, score);
+      distribution_.push_back(0.0);
+      toward = active_set_.size() - 1;
+    }
+
+    // Exact line search along u_toward - u_away: the step maximizes
+    // gamma * (value - away_gradient) -
+    //   0.5 * gamma^2 * ||u_toward - u_away||^2,
+    // and at most all the mass of the away vertex can be moved.
+    const vector<pair<int, double> > &support_toward =
+      active_set_supports_[toward];
+    const vector<pair<int, double> > &support_away =
+      active_set_supports_[away];
+    double curvature = 0.0;
+    int k = 0;
+    int l = 0;
+    while (k < support_toward.size() || l < support_away.size()) {
+      double difference;
+      if (l == support_away.size() ||
+          (k < support_toward.size() &&
+           support_toward[k].first < support_away[l].first)) {
+        difference = support_toward[k].second;
+        ++k;
+      } else if (k == support_toward.size() ||
+                 support_away[l].first < support_toward[k].first) {
+        difference = -support_away[l].second;
+        ++l;
+      } else {
+        difference = support_toward[k].second - support_away[l].second;
+        ++k;
+        ++l;
+      }
+      curvature += difference * difference;
+    }
+    double gamma = distribution_[away];
+    if (curvature > 0.0 && (value - away_gradient) / curvature < gamma) {
+      gamma = (value - away_gradient) / curvature;
+    }
+
+    for (k = 0; k < support_toward.size(); ++k) {
+      marginals[support_toward[k].first] += gamma * support_toward[k].second;
+    }
+    for (l = 0; l < support_away.size(); ++l) {
+      marginals[support_away[l].first] -= gamma * support_away[l].second;
+    }
+    distribution_[toward] += gamma;
+    if (gamma < distribution_[away]) {
+      distribution_[away] -= gamma;
+    } else {
+      // Drop step.
+      if (verbosity_ > 2) {
+        cout << "Removed one element to the active set (iteration "
+             << iter << ")." << endl;
+      }
+      RemoveFromActiveSet(away);
+      distribution_.erase(distribution_.begin() + away);
+    }
+  }
+
+  if (verbosity_ > 2 && iter == num_max_iterations_QP_) {
+    cout << "Maximum number of iterations reached." << endl;
+  }
+
+  // Recompute the marginals from the distribution, which also gives the
+  // additional posteriors.
+  ComputeActiveSetMarginals(distribution_,
+                            variable_posteriors,
+                            additional_posteriors);
 }
 
 /* Get the correspondence between configurations & variable/additionals */
@@ -26,6 +26,27 @@ namespace AD3 {
 // This must be implemented by the user-defined factor.
 typedef void *Configuration;
 
+// State of the active set method: the active set, the distribution
+// over it, the similarities between its configurations, and the Cholesky
+// factor of the (shifted) similarity matrix. Saved to warm-start the QP
+// solver (e.g. in the subproblems of branch-and-bound).
+struct ActiveSetState {
+  vector<Configuration> active_set;
+  vector<double> distribution;
+  vector<double> similarities;
+  vector<double> cholesky;
+};
+
+// Algorithms to solve the QP of a generic factor.
+enum GenericQPSolver {
+  // Active set method (exact after convergence; keeps a factorization
+  // of the similarity matrix of the active set).
+  QP_SOLVER_ACTIVE_SET = 0,
+  // Pairwise Frank-Wolfe (only calls Maximize; cheaper iterations and
+  // linear memory in the active set, but less accurate per call).
+  QP_SOLVER_FRANK_WOLFE
+};
+
 // Base class for a generic factor.
 // Specialized factors should be derived from this class.
 class GenericFactor : public Factor {
@@ -34,6 +55,10 @@ class GenericFactor : public Factor {
     verbosity_ = 2;
     num_max_iterations_QP_ = 10;
     clear_cache_ = true;
+    num_score_updates_ = 0;
+    scored_additional_version_ = -1;
+    qp_solver_ = QP_SOLVER_ACTIVE_SET;
+    map_configuration_ = NULL;
   }
 
   // Note: every class that derives from GenericFactor must
@@ -49,16 +74,107 @@ class GenericFactor : public Factor {
   /* Functions needed for gradient computation */
   void SetQPMaxIter(int it) { num_max_iterations_QP_ = it; }
   void SetClearCache(bool val) { clear_cache_ = val; }
+  // Choose the QP solver (see GenericQPSolver). The cached active set is
+  // discarded when the solver changes.
+  void SetQPSolver(int solver) {
+    if (solver == qp_solver_) return;
+    ClearActiveSet();
+    distribution_.clear();
+    qp_solver_ = solver;
+  }
   vector<Configuration> GetQPActiveSet() const { return active_set_; }
   vector<double> GetQPDistribution() const { return distribution_; }
-  vector<double> GetQPInvA() const { return inverse_A_; }
+  // Inverse of the KKT matrix A = [0,1';1,M] of the active set, computed
+  // from the Cholesky factor (row-major, size (|active set|+1)^2).
+  // Only available with the active set solver.
+  vector<double> GetQPInvA();
 
   /* Get the correspondence between configurations & variable/additionals */
   void GetCorrespondence(vector<double> *variable_m, vector<double> *additional_m);
 
+  // Save the current active set into state (configurations are copied).
+  // Returns false if the factor does not implement CopyConfiguration.
+  bool SaveActiveSet(ActiveSetState *state);
+
+  // Restore a saved active set. The configurations are copied again,
+  // so the same state can be restored several times.
+  void RestoreActiveSet(const ActiveSetState &state);
+
+  // Delete the configurations of a saved active set.
+  void DeleteActiveSet(ActiveSetState *state);
+
  protected:
   void ClearActiveSet();
 
+  // Hash a vector of values (e.g. the states of a configuration),
+  // starting at position start.
+  static unsigned int HashValues(const vector<int> &values, int start) {
+    unsigned int hash = 2166136261u;
+    for (int i = start; i < values.size(); ++i) {
+      hash = (hash ^ static_cast<unsigned int>(values[i])) * 16777619u;
+    }
+    return hash;
+  }
+
+  // Remove a configuration from the active set, along with its cached
+  // score, support, and similarities.
+  void RemoveFromActiveSet(int removed_index);
+
+  // Append a configuration to the active set, along with its
+  // similarities and score.
+  void AppendToActiveSet(const Configuration &configuration,
+                         const vector<double> &similarities,
+                         double score);
+
+  void RebuildHashBuckets();
+
+  int FindInActiveSet(const Configuration &configuration);
+
+  // Get a configuration to pass to Maximize in the QP solvers. The same
+  // one is reused until it is appended to the active set, unless the
+  // factor opts out (see MaximizeOverwritesConfiguration).
+  Configuration GetMapConfiguration();
+
+  // Delete a configuration obtained with GetMapConfiguration which is
+  // not inserted in the active set (if it is not the reused one).
+  void DiscardMapConfiguration(Configuration configuration);
+
+  // The functions below are used by the QP solvers; factors whose
+  // configurations have a simple structure may override them (the scores
+  // of the configurations are given by Evaluate).
+  // Compute the similarities (number of common values) between a
+  // configuration and each configuration in the active set, followed by
+  // the similarity of the configuration with itself.
+  virtual void ComputeSimilarities(const Configuration &configuration,
+                                   vector<double> *similarities);
+
+  // Compute the variable marginals of a distribution over the active set,
+  // in each iteration of the active set method.
+  virtual void ComputeActiveSetVariableMarginals(
+    const vector<double> &distribution,
+    vector<double> *variable_posteriors) {
+    ComputeVariableMarginalsFromSupports(distribution, variable_posteriors);
+  }
+
+  // Compute the variable and additional posteriors of a distribution over
+  // the active set, once before the QP solvers return.
+  virtual void ComputeActiveSetMarginals(
+    const vector<double> &distribution,
+    vector<double> *variable_posteriors,
+    vector<double> *additional_posteriors) {
+    ComputeMarginalsFromSparseDistribution(active_set_,
+                                           distribution,
+                                           variable_posteriors,
+                                           additional_posteriors);
+  }
+
+  void ComputeVariableMarginalsFromSupports(
+    const vector<double> &distribution,
+    vector<double> *variable_posteriors);
+
+  void UpdateActiveSetScores(const vector<double> &variable_log_potentials,
+                             const vector<double> &additional_log_potentials);
+
   // Compute posterior marginals from a sparse distribution,
   // expressed as a set of configurations (active_set) and
   // a probability/weight for each configuration (stored in
@@ -69,7 +185,7 @@ class GenericFactor : public Factor {
     vector<double> *variable_posteriors,
     vector<double> *additional_posteriors) {
     variable_posteriors->assign(binary_variables_.size(), 0.0);
-    additional_posteriors->assign(additional_log_potentials_.size(), 0.0);
+    additional_posteriors->assign(GetAdditionalLogPotentials().size(), 0.0);
     for (int i = 0; i < active_set.size(); ++i) {
       UpdateMarginalsFromConfiguration(active_set[i],
                                        distribution[i],
@@ -78,24 +194,33 @@ class GenericFactor : public Factor {
     }
   }
 
-  bool InvertAfterInsertion(const vector<Configuration> &active_set,
-                            const Configuration &inserted_element);
-
-  void InvertAfterRemoval(const vector<Configuration> &active_set,
-                          int removed_index);
+  // Append a row to the Cholesky factor for a configuration to be inserted
+  // at the end of the active set, given its similarities. Returns false if
+  // the KKT matrix would become singular; in that case the factor is left
+  // unchanged and, if coefficients is not NULL, it gets the coefficients
+  // of the affine combination of the active set that equals the inserted
+  // configuration.
+  bool UpdateCholeskyAfterInsertion(const vector<double> &similarities,
+                                    vector<double> *coefficients);
 
-  void ComputeActiveSetSimilarities(const vector<Configuration> &active_set,
-                                    vector<double> *similarities);
+  // Remove a row from the Cholesky factor (before removing the
+  // corresponding configuration from the active set).
+  void UpdateCholeskyAfterRemoval(const vector<Configuration> &active_set,
+                                  int removed_index);
 
-  void EigenDecompose(vector<double> *similarities,
-                      vector<double> *eigenvalues);
+  // Solve L*L'*x = x, where L is the Cholesky factor.
+  void SolveWithCholesky(vector<double> *x);
 
-  void Invert(const vector<double> &eigenvalues,
-              const vector<double> &eigenvectors);
+  // Solve the KKT system A*[tau; z] = b, where A = [0,1';1,M].
+  void SolveKKTSystem(const vector<double> &b,
+                      vector<double> *z,
+                      double *tau);
 
-  bool IsSingular(vector<double> &eigenvalues,
-                  vector<double> &eigenvectors,
-                  vector<double> *null_space_basis);
+  // Solve the QP with the pairwise Frank-Wolfe algorithm.
+  void SolveQPFrankWolfe(const vector<double> &variable_log_potentials,
+                         const vector<double> &additional_log_potentials,
+                         vector<double> *variable_posteriors,
+                         vector<double> *additional_posteriors);
 
  public:
   // Compute the score of a given assignment.
@@ -125,6 +250,14 @@ class GenericFactor : public Factor {
     const Configuration &configuration1,
     const Configuration &configuration2) = 0;
 
+  // Compute the support of a configuration: the nonzero entries of its
+  // variable marginals, sorted by variable index. The default goes through
+  // UpdateMarginalsFromConfiguration with temporary buffers (including one
+  // for the additional posteriors); factors that know which variables a
+  // configuration sets should override this.
+  virtual void ComputeVariableSupport(const Configuration &configuration,
+                                      vector<pair<int, double> > *support);
+
   // Check if two configurations are the same.
   virtual bool SameConfiguration(
     const Configuration &configuration1,
@@ -133,10 +266,32 @@ class GenericFactor : public Factor {
   // Create configuration.
   virtual Configuration CreateConfiguration() = 0;
 
+  // Whether Maximize overwrites the configuration it is given, so that
+  // the QP solvers can pass it the same configuration on every call.
+  // Factors whose Maximize appends to the configuration instead (e.g.
+  // pushes back the selected elements) must return false.
+  virtual bool MaximizeOverwritesConfiguration() { return true; }
+
   // Delete configuration.
   virtual void DeleteConfiguration(
     Configuration configuration) = 0;
 
+  // Hash a configuration, so that looking it up in the active set does
+  // not need to compare it with every configuration there. Equal
+  // configurations (as given by SameConfiguration) must have the same
+  // hash. Factors that do not override this return false.
+  virtual bool HashConfiguration(const Configuration &configuration,
+                                 unsigned int *hash) {
+    return false;
+  }
+
+  // Copy configuration. Only needed for warm-starting; factors that
+  // do not override this return NULL and their active set is not saved.
+  virtual Configuration CopyConfiguration(
+    const Configuration &configuration) {
+    return NULL;
+  }
+
   // Compute the MAP (local subproblem in the projected subgradient algorithm).
   // The user-defined factor may override this.
   virtual void SolveMAP(const vector<double> &variable_log_potentials,
@@ -159,7 +314,7 @@ class GenericFactor : public Factor {
   }
 
   // Solve the QP (local subproblem in the AD3 algorithm).
-  // By default, used the active set method.
+  // By default, used the active set method (see SetQPSolver).
   // The user-defined factor may override this.
   virtual void SolveQP(const vector<double> &variable_log_potentials,
                        const vector<double> &additional_log_potentials,
@@ -168,9 +323,46 @@ class GenericFactor : public Factor {
 
  protected:
   vector<Configuration> active_set_;
+  // Hash of each configuration in the active set (empty if the factor
+  // does not hash configurations), and the positions in the active set of
+  // the configurations in each bucket (hash modulo the number of buckets).
+  vector<unsigned int> active_set_hashes_;
+  vector<vector<int> > hash_buckets_;
   vector<double> distribution_;
-  vector<double> inverse_A_;
+  // Lower-triangular Cholesky factor L of M + 11', where M is the matrix
+  // of similarities (common values) between the configurations in the
+  // active set. Rows are packed contiguously: row i starts at i*(i+1)/2.
+  // M + 11' is positive definite iff the KKT matrix is nonsingular.
+  vector<double> cholesky_;
+  // Solution of (M + 11')*w = 1 and its sum (cleared when the
+  // factorization changes).
+  vector<double> ones_solution_;
+  double sum_ones_solution_;
+  // Similarities between the configurations of the active set, packed
+  // like the Cholesky factor (including the diagonal).
+  vector<double> similarities_;
+  // Score of each configuration in the active set, and the potentials
+  // they correspond to (the additional ones are the cached ones, with the
+  // given version, or -1 if they were passed by the caller).
+  vector<double> active_set_scores_;
+  vector<double> scored_variable_log_potentials_;
+  int scored_additional_version_;
+  int num_score_updates_; // Incremental updates since the last evaluation.
+  // Nonzero variable marginals of each configuration in the active set,
+  // used to update the scores when the variable log-potentials change.
+  vector<vector<pair<int, double> > > active_set_supports_;
+  // Scratch vectors, kept to avoid allocating memory in SolveQP.
+  vector<double> score_differences_;
+  vector<double> scratch_similarities_;
+  vector<double> scratch_coefficients_;
+  vector<double> scratch_b_;
+  vector<double> scratch_z_;
+  vector<double> scratch_scores_;
+  // Configuration passed to Maximize by the QP solvers (NULL if none);
+  // it is moved to the active set when appended, and a new one is created.
+  Configuration map_configuration_;
   int num_max_iterations_QP_; // Initialize to 10.
+  int qp_solver_; // Initialize to QP_SOLVER_ACTIVE_SET.
   int verbosity_; // Verbosity level.
 
   bool clear_cache_;
@@ -0,0 +1,364 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+// Benchmark of the solvers on a set of factor graph files (by default, the
+// instances in data/). Each file is loaded and solved with each algorithm
+// a number of times, with fixed settings, and one line of tab-separated
+// fields is written per file and algorithm (see kBenchmarkColumns). Every
+// run takes place in a child process, so that its peak memory is measured
+// on its own and a failure does not stop the benchmark.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include "ad3/FactorGraph.h"
+#include "ad3/Utils.h"
+#include "ExampleFactorGraphReader.h"
+
+using namespace std;
+using namespace AD3;
+
+// Version of the output format; it changes whenever a column is added,
+// removed or changes meaning.
+static const int kBenchmarkFormatVersion = 2;
+
+static const char *kBenchmarkColumns =
+  "instance\talgorithm\tgraphs\trepetitions\tload_sec\tsolve_sec\t"
+  "iterations\titerations_per_sec\tvalue\tupper_bound\tgap\t"
+  "integer_graphs\tpeak_rss_kb\tstatus";
+// The upper bound is the one proved by each algorithm: the dual value for
+// ad3 and psdd. For exact, it is the value itself when branch-and-bound
+// proves the solution optimal (or the graph infeasible); otherwise it is
+// the bound of the LP relaxation at the root, since the bounds of the
+// open subproblems are not kept. Version 1 always gave the root bound.
+
+// Results of loading and solving all the graphs of a file once.
+struct BenchmarkRun {
+  int num_graphs;
+  double load_time;
+  double solve_time;
+  long long num_iterations;
+  double value;
+  double upper_bound;
+  int num_integer_graphs;
+  long peak_rss;
+};
+
+// Time elapsed between two instants, in seconds.
+static double ElapsedSeconds(const timeval &start, const timeval &end) {
+  return (end.tv_sec - start.tv_sec) +
+    (end.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+// Peak resident set size of the process (in KB).
+static long GetPeakMemory() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Median of a list of times.
+static double Median(vector<double> values) {
+  sort(values.begin(), values.end());
+  int n = values.size();
+  if (n == 0) return 0.0;
+  if (n % 2 == 1) return values[n / 2];
+  return 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+// Format of a file, given by its extension ("uai" or "ad3").
+static string GetFormat(const string &filename) {
+  size_t dot = filename.rfind('.');
+  if (dot != string::npos && filename.substr(dot) == ".uai") return "uai";
+  return "ad3";
+}
+
+// Load all the graphs of a file and solve them with an algorithm ("ad3",
+// "psdd" or "exact"). Returns false if the file cannot be read.
+static bool RunBenchmark(const string &filename,
+                         const string &algorithm,
+                         int max_iterations,
+                         BenchmarkRun *run) {
+  // The messages of the custom factors are not wanted: a stream which was
+  // never opened discards them.
+  ofstream no_log;
+  ExampleFactorGraphReader reader;
+  reader.SetLog(&no_log);
+  if (!reader.Open(filename)) return false;
+  string format = GetFormat(filename);
+  vector<FactorGraph*> factor_graphs;
+  timeval start, end;
+  gettimeofday(&start, NULL);
+  while (true) {
+    FactorGraph *factor_graph = new FactorGraph;
+    int status = (format == "uai")?
+      reader.ReadGraphUAI(factor_graph, false) :
+      reader.ReadGraph(factor_graph);
+    if (status < 0) {
+      delete factor_graph;
+      break;
+    }
+    if (format == "uai") factor_graph->FixMultiVariablesWithoutFactors();
+    factor_graphs.push_back(factor_graph);
+  }
+  gettimeofday(&end, NULL);
+  reader.Close();
+  run->num_graphs = factor_graphs.size();
+  run->load_time = ElapsedSeconds(start, end);
+
+  run->solve_time = 0.0;
+  run->num_iterations = 0;
+  run->value = 0.0;
+  run->upper_bound = 0.0;
+  run->num_integer_graphs = 0;
+  vector<double> posteriors;
+  vector<double> additional_posteriors;
+  for (int k = 0; k < factor_graphs.size(); ++k) {
+    FactorGraph *factor_graph = factor_graphs[k];
+    double value = 0.0;
+    int status;
+    gettimeofday(&start, NULL);
+    if (algorithm == "psdd") {
+      factor_graph->SetEtaPSDD(0.1);
+      factor_graph->SetMaxIterationsPSDD(max_iterations);
+      status = factor_graph->SolveLPMAPWithPSDD(&posteriors,
+                                                &additional_posteriors,
+                                                &value);
+    } else {
+      factor_graph->SetEtaAD3(0.1);
+      factor_graph->AdaptEtaAD3(true);
+      factor_graph->SetMaxIterationsAD3(max_iterations);
+      factor_graph->SetResidualThresholdAD3(1e-6);
+      if (algorithm == "exact") {
+        status = factor_graph->SolveExactMAPWithAD3(&posteriors,
+                                                    &additional_posteriors,
+                                                    &value);
+      } else {
+        status = factor_graph->SolveLPMAPWithAD3(&posteriors,
+                                                 &additional_posteriors,
+                                                 &value);
+      }
+    }
+    gettimeofday(&end, NULL);
+    run->solve_time += ElapsedSeconds(start, end);
+    run->num_iterations += factor_graph->GetLastNumIterations();
+    run->value += value;
+    if (algorithm == "exact" &&
+        (status == STATUS_OPTIMAL_INTEGER || status == STATUS_INFEASIBLE)) {
+      run->upper_bound += value;
+    } else {
+      run->upper_bound += factor_graph->GetLastUpperBound();
+    }
+    if (status == STATUS_OPTIMAL_INTEGER) ++run->num_integer_graphs;
+  }
+  run->peak_rss = GetPeakMemory();
+
+  for (int k = 0; k < factor_graphs.size(); ++k) {
+    delete factor_graphs[k];
+  }
+  return true;
+}
+
+// Run the benchmark of a file in a child process. Returns false if the
+// file cannot be read or the child fails.
+static bool RunBenchmarkProcess(const string &filename,
+                                const string &algorithm,
+                                int max_iterations,
+                                BenchmarkRun *run) {
+  int fds[2];
+  if (pipe(fds) < 0) return false;
+  cout.flush();
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    bool loaded = RunBenchmark(filename, algorithm, max_iterations, run);
+    int status = -1;
+    if (loaded && write(fds[1], run, sizeof(*run)) == sizeof(*run)) {
+      status = 0;
+    }
+    close(fds[1]);
+    _exit(status == 0? 0 : 1);
+  }
+  close(fds[1]);
+  ssize_t size = 0;
+  ssize_t count;
+  char *buffer = reinterpret_cast<char*>(run);
+  while (size < static_cast<ssize_t>(sizeof(*run)) &&
+         (count = read(fds[0], buffer + size, sizeof(*run) - size)) > 0) {
+    size += count;
+  }
+  close(fds[0]);
+  int status;
+  waitpid(pid, &status, 0);
+  return size == sizeof(*run) && WIFEXITED(status) &&
+    WEXITSTATUS(status) == 0;
+}
+
+// Files with the extensions .fg and .uai in a directory, sorted by name.
+static bool ListInstances(const string &directory,
+                          vector<string> *filenames) {
+  DIR *dir = opendir(directory.c_str());
+  if (!dir) return false;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL) {
+    string name = entry->d_name;
+    size_t dot = name.rfind('.');
+    if (dot == string::npos) continue;
+    string extension = name.substr(dot);
+    if (extension != ".fg" && extension != ".uai") continue;
+    filenames->push_back(directory + "/" + name);
+  }
+  closedir(dir);
+  sort(filenames->begin(), filenames->end());
+  return true;
+}
+
+int main(int argc, char** argv) {
+  string message = "Usage: ad3_benchmark (--data_dir=[DIR] " \
+    "--instances=[FILE,...] --algorithms=[ad3,psdd,exact] " \
+    "--repetitions=[NUM] --max_iterations=[NUM] --file_output=[OUT])";
+
+  string data_dir = "data";
+  string instances = "";
+  string algorithms = "ad3,psdd,exact";
+  int repetitions = 3;
+  int max_iterations = 1000;
+  string filename_output = "";
+
+  for (int i = 1; i < argc; ++i) {
+    vector<string> pair;
+    StringSplit(argv[i], "=", &pair);
+    if (pair.size() != 2 || pair[0].substr(0,2) != "--") {
+      cout << message << endl;
+      return -1;
+    }
+    string param_name = pair[0].substr(2);
+    string param_value = pair[1];
+    if (param_name == "data_dir") {
+      data_dir = param_value;
+    } else if (param_name == "instances") {
+      instances = param_value;
+    } else if (param_name == "algorithms") {
+      algorithms = param_value;
+    } else if (param_name == "repetitions") {
+      repetitions = atoi(param_value.c_str());
+    } else if (param_name == "max_iterations") {
+      max_iterations = atoi(param_value.c_str());
+    } else if (param_name == "file_output") {
+      filename_output = param_value;
+    } else {
+      cout << "Unknown flag: " << param_name << endl;
+      cout << message << endl;
+      return -1;
+    }
+  }
+  if (repetitions < 1 || max_iterations < 1) {
+    cout << message << endl;
+    return -1;
+  }
+
+  vector<string> algorithm_names;
+  StringSplit(algorithms, ",", &algorithm_names);
+  for (int j = 0; j < algorithm_names.size(); ++j) {
+    if (algorithm_names[j] != "ad3" && algorithm_names[j] != "psdd" &&
+        algorithm_names[j] != "exact") {
+      cout << "Unknown algorithm: " << algorithm_names[j] << endl;
+      return -1;
+    }
+  }
+
+  vector<string> filenames;
+  if (instances != "") {
+    StringSplit(instances, ",", &filenames);
+  } else if (!ListInstances(data_dir, &filenames)) {
+    cout << "Error: Could not open directory " << data_dir << "." << endl;
+    return -1;
+  }
+
+  ofstream file_output;
+  if (filename_output != "") {
+    file_output.open(filename_output.c_str(), ios_base::out);
+    if (!file_output.is_open()) {
+      cout << "Error: Could not open " << filename_output << " for writing."
+           << endl;
+      return -1;
+    }
+  }
+  ostream &output = (filename_output != "")? file_output : cout;
+  output << "# ad3_benchmark " << kBenchmarkFormatVersion
+         << "\trepetitions=" << repetitions
+         << "\tmax_iterations=" << max_iterations << endl;
+  output << kBenchmarkColumns << endl;
+
+  for (int i = 0; i < filenames.size(); ++i) {
+    for (int j = 0; j < algorithm_names.size(); ++j) {
+      const string &algorithm = algorithm_names[j];
+      vector<double> load_times(repetitions);
+      vector<double> solve_times(repetitions);
+      BenchmarkRun run;
+      memset(&run, 0, sizeof(run));
+      long peak_rss = 0;
+      bool success = true;
+      for (int r = 0; r < repetitions && success; ++r) {
+        success = RunBenchmarkProcess(filenames[i], algorithm,
+                                      max_iterations, &run);
+        load_times[r] = run.load_time;
+        solve_times[r] = run.solve_time;
+        if (run.peak_rss > peak_rss) peak_rss = run.peak_rss;
+      }
+      if (!success) {
+        // The file could not be read or the solver crashed.
+        output << filenames[i] << "\t" << algorithm << "\t"
+               << "0\t0\t0\t0\t0\t0\t0\t0\t0\t0\t0\tfailed" << endl;
+        continue;
+      }
+
+      // The iterations and values do not change across repetitions.
+      double solve_time = Median(solve_times);
+      double iterations_per_second = (solve_time > 0.0)?
+        run.num_iterations / solve_time : 0.0;
+      output << filenames[i] << "\t" << algorithm << "\t"
+             << run.num_graphs << "\t" << repetitions << "\t"
+             << fixed << setprecision(6)
+             << Median(load_times) << "\t" << solve_time << "\t"
+             << run.num_iterations << "\t"
+             << setprecision(1) << iterations_per_second << "\t"
+             << scientific << setprecision(9)
+             << run.value << "\t" << run.upper_bound << "\t"
+             << run.upper_bound - run.value << "\t"
+             << run.num_integer_graphs << "\t" << peak_rss << "\tok"
+             << endl;
+      output.unsetf(ios_base::floatfield);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,544 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+// Benchmark of the local subproblems of each factor type. A factor of each
+// type and size is created alone in a graph, and SolveMAP and SolveQP are
+// called repeatedly on random log-potentials; one line of tab-separated
+// fields is written per factor and size (see kBenchmarkColumns), with the
+// time per call. The sizes are set by the degree (for the logic factors),
+// the number of labels (for the dense factors) and the length (for the
+// sequences and trees).
+//
+// The log-potentials are drawn once, with a fixed seed, for a number of
+// instances which are then solved in turn. Generic factors keep their
+// active set from one call to the next, as they do within AD3.
+
+#include <stdlib.h>
+#include <sys/time.h>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include "ad3/FactorGraph.h"
+#include "ad3/Utils.h"
+#include "FactorSequence.h"
+#include "FactorTree.h"
+#include "FactorHeadAutomaton.h"
+#include "FactorSequenceCompressor.h"
+#include "FactorSequenceBudget.h"
+#include "FactorCompressionBudget.h"
+#include "FactorGeneralTree.h"
+#include "FactorGeneralTreeCounts.h"
+#include "FactorBinaryTree.h"
+#include "FactorBinaryTreeCounts.h"
+
+using namespace std;
+using namespace AD3;
+
+// Version of the output format; it changes whenever a column is added,
+// removed or changes meaning.
+static const int kBenchmarkFormatVersion = 1;
+
+static const char *kBenchmarkColumns =
+  "factor\tdegree\tlabels\tlength\tadditionals\tmap_calls\tmap_usec\t"
+  "qp_calls\tqp_usec";
+
+// Factor types, in the order in which they are benchmarked by default.
+static const char *kFactorTypes =
+  "xor,atmostone,or,orout,budget,knapsack,pair,dense,dense3,sequence,"
+  "tree,head_automaton,sequence_compressor,sequence_budget,"
+  "compression_budget,binary_tree,binary_tree_counts,general_tree,"
+  "general_tree_counts";
+
+// Which of the sizes (degree, labels and length) apply to a factor type.
+struct FactorSizes {
+  bool degree;
+  bool labels;
+  bool length;
+};
+
+// Time elapsed between two instants, in seconds.
+static double ElapsedSeconds(const timeval &start, const timeval &end) {
+  return (end.tv_sec - start.tv_sec) +
+    (end.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+// Median of a list of times.
+static double Median(vector<double> values) {
+  sort(values.begin(), values.end());
+  int n = values.size();
+  if (n == 0) return 0.0;
+  if (n % 2 == 1) return values[n / 2];
+  return 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+// Random number in [-scale, scale].
+static double RandomScore(double scale) {
+  return scale * (2.0 * static_cast<double>(rand()) /
+                  static_cast<double>(RAND_MAX) - 1.0);
+}
+
+static void RandomScores(int size, double scale, vector<double> *scores) {
+  scores->resize(size);
+  for (int i = 0; i < size; ++i) {
+    (*scores)[i] = RandomScore(scale);
+  }
+}
+
+// Random tree with length nodes, rooted at node 0, where the parent of
+// each node comes before it.
+static void RandomParents(int length, vector<int> *parents) {
+  parents->resize(length);
+  (*parents)[0] = -1;
+  for (int i = 1; i < length; ++i) {
+    (*parents)[i] = rand() % i;
+  }
+}
+
+// Create binary variables in a graph.
+static void CreateBinaryVariables(int num_variables,
+                                  FactorGraph *factor_graph,
+                                  vector<BinaryVariable*> *variables) {
+  variables->resize(num_variables);
+  for (int i = 0; i < num_variables; ++i) {
+    (*variables)[i] = factor_graph->CreateBinaryVariable();
+  }
+}
+
+// Number of additional log-potentials of a chain of positions with the
+// given number of states, with start and stop symbols.
+static int CountSequenceEdges(const vector<int> &num_states) {
+  int length = num_states.size();
+  int num_edges = 0;
+  for (int i = 0; i <= length; ++i) {
+    int num_previous_states = (i > 0)? num_states[i - 1] : 1;
+    int num_current_states = (i < length)? num_states[i] : 1;
+    num_edges += num_previous_states * num_current_states;
+  }
+  return num_edges;
+}
+
+// Number of additional log-potentials of the edges of a tree.
+static int CountTreeEdges(const vector<int> &parents,
+                          const vector<int> &num_states) {
+  int num_edges = 0;
+  for (int i = 1; i < parents.size(); ++i) {
+    num_edges += num_states[parents[i]] * num_states[i];
+  }
+  return num_edges;
+}
+
+// Siblings (0, m, s) of a head automaton with length positions.
+static void CreateSiblings(int length, vector<Sibling*> *siblings) {
+  for (int m = 0; m < length; ++m) {
+    for (int s = m+1; s <= length; ++s) {
+      siblings->push_back(new Sibling(0, m, s));
+    }
+  }
+}
+
+static void DeleteSiblings(vector<Sibling*> *siblings) {
+  for (int r = 0; r < siblings->size(); ++r) {
+    delete (*siblings)[r];
+  }
+  siblings->clear();
+}
+
+// Sizes which apply to a factor type. Returns false if the type is unknown.
+static bool GetFactorSizes(const string &type, FactorSizes *sizes) {
+  sizes->degree = false;
+  sizes->labels = false;
+  sizes->length = false;
+  if (type == "xor" || type == "atmostone" || type == "or" ||
+      type == "orout" || type == "budget" || type == "knapsack") {
+    sizes->degree = true;
+  } else if (type == "pair") {
+    // Always two variables.
+  } else if (type == "dense" || type == "dense3") {
+    sizes->labels = true;
+  } else if (type == "sequence" || type == "sequence_budget" ||
+             type == "general_tree" || type == "general_tree_counts") {
+    sizes->labels = true;
+    sizes->length = true;
+  } else if (type == "tree" || type == "head_automaton" ||
+             type == "sequence_compressor" ||
+             type == "compression_budget" || type == "binary_tree" ||
+             type == "binary_tree_counts") {
+    sizes->length = true;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Create a factor of a type in a graph, with the given sizes (those which
+// do not apply to the type are ignored). Budgets are set to half of the
+// degree or length, and tree factors get a random tree.
+static Factor *CreateFactor(const string &type, int degree, int num_labels,
+                            int length, FactorGraph *factor_graph) {
+  vector<BinaryVariable*> variables;
+  vector<double> additional_log_potentials;
+  Factor *factor = NULL;
+  if (type == "xor" || type == "atmostone" || type == "or" ||
+      type == "orout" || type == "budget" || type == "knapsack") {
+    CreateBinaryVariables(degree, factor_graph, &variables);
+    if (type == "xor") {
+      factor = factor_graph->CreateFactorXOR(variables);
+    } else if (type == "atmostone") {
+      factor = factor_graph->CreateFactorAtMostOne(variables);
+    } else if (type == "or") {
+      factor = factor_graph->CreateFactorOR(variables);
+    } else if (type == "orout") {
+      factor = factor_graph->CreateFactorOROUT(variables);
+    } else if (type == "budget") {
+      factor = factor_graph->CreateFactorBUDGET(variables, degree / 2);
+    } else {
+      vector<double> costs(degree);
+      double total_cost = 0.0;
+      for (int i = 0; i < degree; ++i) {
+        costs[i] = 0.5 * (RandomScore(1.0) + 1.0);
+        total_cost += costs[i];
+      }
+      factor = factor_graph->CreateFactorKNAPSACK(variables, costs,
+                                                  0.5 * total_cost);
+    }
+  } else if (type == "pair") {
+    CreateBinaryVariables(2, factor_graph, &variables);
+    factor = factor_graph->CreateFactorPAIR(variables, RandomScore(1.0));
+  } else if (type == "dense" || type == "dense3") {
+    int num_multi_variables = (type == "dense")? 2 : 3;
+    vector<MultiVariable*> multi_variables(num_multi_variables);
+    int num_configurations = 1;
+    for (int i = 0; i < num_multi_variables; ++i) {
+      multi_variables[i] = factor_graph->CreateMultiVariable(num_labels);
+      num_configurations *= num_labels;
+    }
+    RandomScores(num_configurations, 1.0, &additional_log_potentials);
+    factor = factor_graph->CreateFactorDense(multi_variables,
+                                             additional_log_potentials);
+  } else if (type == "sequence" || type == "sequence_budget") {
+    vector<int> num_states(length, num_labels);
+    CreateBinaryVariables(length * num_labels, factor_graph, &variables);
+    RandomScores(CountSequenceEdges(num_states), 1.0,
+                 &additional_log_potentials);
+    if (type == "sequence") {
+      factor = new FactorSequence;
+      factor_graph->DeclareFactor(factor, variables, true);
+      static_cast<FactorSequence*>(factor)->Initialize(num_states);
+    } else {
+      factor = new FactorSequenceBudget;
+      factor_graph->DeclareFactor(factor, variables, true);
+      static_cast<FactorSequenceBudget*>(factor)->
+        Initialize(num_states, length / 2);
+    }
+    factor->SetAdditionalLogPotentials(additional_log_potentials);
+  } else if (type == "tree") {
+    // One arc per head and modifier, where the root (0) is not a modifier.
+    vector<Arc*> arcs;
+    for (int m = 1; m < length; ++m) {
+      for (int h = 0; h < length; ++h) {
+        if (h != m) arcs.push_back(new Arc(h, m));
+      }
+    }
+    CreateBinaryVariables(arcs.size(), factor_graph, &variables);
+    factor = new FactorTree;
+    factor_graph->DeclareFactor(factor, variables, true);
+    static_cast<FactorTree*>(factor)->Initialize(length, arcs);
+    for (int r = 0; r < arcs.size(); ++r) {
+      delete arcs[r];
+    }
+  } else if (type == "head_automaton" || type == "sequence_compressor") {
+    // A head automaton has one variable per modifier, and the head is
+    // one of the positions; a sequence compressor has one per position.
+    int num_variables = (type == "head_automaton")? length - 1 : length;
+    vector<Sibling*> siblings;
+    CreateSiblings(length, &siblings);
+    CreateBinaryVariables(num_variables, factor_graph, &variables);
+    RandomScores(siblings.size(), 1.0, &additional_log_potentials);
+    if (type == "head_automaton") {
+      factor = new FactorHeadAutomaton;
+      factor_graph->DeclareFactor(factor, variables, true);
+      static_cast<FactorHeadAutomaton*>(factor)->Initialize(length, siblings);
+    } else {
+      factor = new FactorSequenceCompressor;
+      factor_graph->DeclareFactor(factor, variables, true);
+      static_cast<FactorSequenceCompressor*>(factor)->
+        Initialize(length, siblings);
+    }
+    DeleteSiblings(&siblings);
+    factor->SetAdditionalLogPotentials(additional_log_potentials);
+  } else if (type == "compression_budget") {
+    // No bigram variables: all the edges are additional log-potentials.
+    vector<int> num_states(length, 2);
+    vector<bool> counts_for_budget(length, true);
+    vector<int> bigram_positions;
+    CreateBinaryVariables(length, factor_graph, &variables);
+    RandomScores(CountSequenceEdges(num_states), 1.0,
+                 &additional_log_potentials);
+    factor = new FactorCompressionBudget;
+    factor_graph->DeclareFactor(factor, variables, true);
+    static_cast<FactorCompressionBudget*>(factor)->
+      Initialize(length, length / 2, counts_for_budget, bigram_positions);
+    factor->SetAdditionalLogPotentials(additional_log_potentials);
+  } else if (type == "binary_tree" || type == "binary_tree_counts") {
+    vector<int> parents;
+    RandomParents(length, &parents);
+    vector<int> num_states(length, 2);
+    int num_additionals = CountTreeEdges(parents, num_states);
+    CreateBinaryVariables(length, factor_graph, &variables);
+    if (type == "binary_tree") {
+      factor = new FactorBinaryTree;
+      factor_graph->DeclareFactor(factor, variables, true);
+      static_cast<FactorBinaryTree*>(factor)->Initialize(parents);
+    } else {
+      // Only the root has count scores, one per number of nodes selected.
+      vector<bool> counts_for_budget(length, true);
+      num_additionals += length + 1;
+      factor = new FactorBinaryTreeCounts;
+      factor_graph->DeclareFactor(factor, variables, true);
+      static_cast<FactorBinaryTreeCounts*>(factor)->
+        Initialize(parents, counts_for_budget);
+    }
+    RandomScores(num_additionals, 1.0, &additional_log_potentials);
+    factor->SetAdditionalLogPotentials(additional_log_potentials);
+  } else if (type == "general_tree" || type == "general_tree_counts") {
+    vector<int> parents;
+    RandomParents(length, &parents);
+    vector<int> num_states(length, num_labels);
+    int num_variables = length * num_labels;
+    // The counts add one variable per number of nodes in the counting
+    // state.
+    if (type == "general_tree_counts") num_variables += length + 1;
+    CreateBinaryVariables(num_variables, factor_graph, &variables);
+    RandomScores(CountTreeEdges(parents, num_states), 1.0,
+                 &additional_log_potentials);
+    if (type == "general_tree") {
+      factor = new FactorGeneralTree;
+      factor_graph->DeclareFactor(factor, variables, true);
+      static_cast<FactorGeneralTree*>(factor)->Initialize(parents,
+                                                           num_states);
+    } else {
+      factor = new FactorGeneralTreeCounts;
+      factor_graph->DeclareFactor(factor, variables, true);
+      static_cast<FactorGeneralTreeCounts*>(factor)->Initialize(parents,
+                                                                num_states);
+    }
+    factor->SetAdditionalLogPotentials(additional_log_potentials);
+  }
+  return factor;
+}
+
+// Time per call (in microseconds) of SolveMAP (if map is true) or SolveQP,
+// cycling through the instances until at least min_time seconds have
+// passed, and at least once per instance.
+static double TimeCalls(Factor *factor, bool map,
+                        const vector<vector<double> > &variable_instances,
+                        const vector<vector<double> > &additional_instances,
+                        double min_time,
+                        int *num_calls) {
+  int num_instances = variable_instances.size();
+  vector<double> variable_posteriors(factor->Degree());
+  vector<double> additional_posteriors(
+    factor->GetAdditionalLogPotentials().size());
+  double value;
+  timeval start, end;
+  double elapsed = 0.0;
+  int calls = 0;
+  int batch = num_instances;
+  gettimeofday(&start, NULL);
+  while (true) {
+    for (int k = 0; k < batch; ++k) {
+      int instance = (calls + k) % num_instances;
+      if (map) {
+        factor->SolveMAP(variable_instances[instance],
+                         additional_instances[instance],
+                         &variable_posteriors, &additional_posteriors,
+                         &value);
+      } else {
+        factor->SolveQP(variable_instances[instance],
+                        additional_instances[instance],
+                        &variable_posteriors, &additional_posteriors);
+      }
+    }
+    calls += batch;
+    gettimeofday(&end, NULL);
+    elapsed = ElapsedSeconds(start, end);
+    if (elapsed >= min_time) break;
+    // Fewer calls to gettimeofday for the faster factors.
+    if (batch < 1000000) batch *= 2;
+  }
+  *num_calls = calls;
+  return 1000000.0 * elapsed / calls;
+}
+
+int main(int argc, char** argv) {
+  string message = "Usage: ad3_factor_benchmark (--factors=[TYPE,...] " \
+    "--degrees=[NUM,...] --labels=[NUM,...] --lengths=[NUM,...] " \
+    "--instances=[NUM] --min_time=[SEC] --repetitions=[NUM] " \
+    "--seed=[NUM] --file_output=[OUT])";
+
+  string factors = kFactorTypes;
+  string degrees = "4,16,64";
+  string labels = "2,8,32";
+  string lengths = "5,10,20";
+  int num_instances = 16;
+  double min_time = 0.1;
+  int repetitions = 3;
+  int seed = 1;
+  string filename_output = "";
+
+  for (int i = 1; i < argc; ++i) {
+    vector<string> pair;
+    StringSplit(argv[i], "=", &pair);
+    if (pair.size() != 2 || pair[0].substr(0,2) != "--") {
+      cout << message << endl;
+      return -1;
+    }
+    string param_name = pair[0].substr(2);
+    string param_value = pair[1];
+    if (param_name == "factors") {
+      factors = param_value;
+    } else if (param_name == "degrees") {
+      degrees = param_value;
+    } else if (param_name == "labels") {
+      labels = param_value;
+    } else if (param_name == "lengths") {
+      lengths = param_value;
+    } else if (param_name == "instances") {
+      num_instances = atoi(param_value.c_str());
+    } else if (param_name == "min_time") {
+      min_time = atof(param_value.c_str());
+    } else if (param_name == "repetitions") {
+      repetitions = atoi(param_value.c_str());
+    } else if (param_name == "seed") {
+      seed = atoi(param_value.c_str());
+    } else if (param_name == "file_output") {
+      filename_output = param_value;
+    } else {
+      cout << "Unknown flag: " << param_name << endl;
+      cout << message << endl;
+      return -1;
+    }
+  }
+  if (num_instances < 1 || repetitions < 1 || min_time < 0.0) {
+    cout << message << endl;
+    return -1;
+  }
+
+  vector<string> factor_types;
+  StringSplit(factors, ",", &factor_types);
+  for (int j = 0; j < factor_types.size(); ++j) {
+    FactorSizes sizes;
+    if (!GetFactorSizes(factor_types[j], &sizes)) {
+      cout << "Unknown factor: " << factor_types[j] << endl;
+      return -1;
+    }
+  }
+
+  // The sizes must be at least 2 (a tree of length 1 has no arcs).
+  vector<int> degree_values;
+  vector<int> label_values;
+  vector<int> length_values;
+  const string *size_flags[3] = { &degrees, &labels, &lengths };
+  vector<int> *size_values[3] = { &degree_values, &label_values,
+                                  &length_values };
+  for (int k = 0; k < 3; ++k) {
+    vector<string> fields;
+    StringSplit(*size_flags[k], ",", &fields);
+    for (int i = 0; i < fields.size(); ++i) {
+      int value = atoi(fields[i].c_str());
+      if (value < 2) {
+        cout << "Invalid size: " << fields[i] << endl;
+        return -1;
+      }
+      size_values[k]->push_back(value);
+    }
+    if (size_values[k]->empty()) {
+      cout << message << endl;
+      return -1;
+    }
+  }
+
+  ofstream file_output;
+  if (filename_output != "") {
+    file_output.open(filename_output.c_str(), ios_base::out);
+    if (!file_output.is_open()) {
+      cout << "Error: Could not open " << filename_output << " for writing."
+           << endl;
+      return -1;
+    }
+  }
+  ostream &output = (filename_output != "")? file_output : cout;
+  output << "# ad3_factor_benchmark " << kBenchmarkFormatVersion
+         << "\tinstances=" << num_instances
+         << "\tmin_time=" << min_time
+         << "\trepetitions=" << repetitions
+         << "\tseed=" << seed << endl;
+  output << kBenchmarkColumns << endl;
+
+  for (int j = 0; j < factor_types.size(); ++j) {
+    const string &type = factor_types[j];
+    FactorSizes sizes;
+    GetFactorSizes(type, &sizes);
+    // Sizes which do not apply to the type take a single value (0).
+    vector<int> type_degrees = sizes.degree? degree_values : vector<int>(1);
+    vector<int> type_labels = sizes.labels? label_values : vector<int>(1);
+    vector<int> type_lengths = sizes.length? length_values : vector<int>(1);
+    for (int a = 0; a < type_degrees.size(); ++a) {
+      for (int b = 0; b < type_labels.size(); ++b) {
+        for (int c = 0; c < type_lengths.size(); ++c) {
+          // Each factor and size has its own draws, so that adding or
+          // removing a factor does not change the others.
+          srand(seed);
+          FactorGraph factor_graph;
+          Factor *factor = CreateFactor(type, type_degrees[a],
+                                        type_labels[b], type_lengths[c],
+                                        &factor_graph);
+          int num_additionals = factor->GetAdditionalLogPotentials().size();
+          vector<vector<double> > variable_instances(num_instances);
+          vector<vector<double> > additional_instances(num_instances);
+          for (int k = 0; k < num_instances; ++k) {
+            RandomScores(factor->Degree(), 1.0, &variable_instances[k]);
+            RandomScores(num_additionals, 1.0, &additional_instances[k]);
+          }
+
+          vector<double> map_times(repetitions);
+          vector<double> qp_times(repetitions);
+          int num_map_calls = 0;
+          int num_qp_calls = 0;
+          for (int r = 0; r < repetitions; ++r) {
+            int calls;
+            map_times[r] = TimeCalls(factor, true, variable_instances,
+                                     additional_instances, min_time, &calls);
+            num_map_calls += calls;
+            qp_times[r] = TimeCalls(factor, false, variable_instances,
+                                    additional_instances, min_time, &calls);
+            num_qp_calls += calls;
+          }
+          output << type << "\t" << factor->Degree() << "\t"
+                 << type_labels[b] << "\t" << type_lengths[c] << "\t"
+                 << num_additionals << "\t" << num_map_calls << "\t"
+                 << fixed << setprecision(3) << Median(map_times) << "\t"
+                 << num_qp_calls << "\t" << Median(qp_times) << endl;
+          output.unsetf(ios_base::floatfield);
+        }
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,219 @@
+// Copyright (c) 2012 Andre Martins
+// All Rights Reserved.
+//
+// This file is part of AD3 2.1.
+//
+// AD3 2.1 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// AD3 2.1 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
+
+// Generator of synthetic factor graphs (see GraphGenerator.h), which writes
+// grids, random logic graphs, dependency parsing graphs or summarization
+// graphs of a given size to a file in the AD3 or UAI format.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <iostream>
+#include "ad3/Utils.h"
+#include "GraphGenerator.h"
+
+using namespace std;
+using namespace AD3;
+
+int main(int argc, char** argv) {
+  string message = "Usage: ad3_generate " \
+    "--family=[grid|logic|parsing|summarization] --file_output=[OUT] " \
+    "(--format=[ad3(*)|uai] --graphs=[NUM] --seed=[NUM] " \
+    "--rows=[NUM] --columns=[NUM] --labels=[NUM] " \
+    "--potts=[true(*)|false] --alpha=[NUM] " \
+    "--variables=[NUM] --factors=[NUM] --degree=[NUM] " \
+    "--length=[NUM] --sentences=[NUM] --budget=[NUM])";
+
+  string family = "";
+  string filename_output = "";
+  string format = "ad3";
+  int num_graphs = 1;
+  int seed = 1;
+  // Grids.
+  int num_rows = 100;
+  int num_columns = 100;
+  int num_labels = 5;
+  bool potts = true;
+  double alpha = 0.5;
+  // Logic graphs.
+  int num_variables = 1000;
+  int num_factors = 1000;
+  int degree = 3;
+  // Parsing and summarization graphs.
+  int length = 40;
+  int num_sentences = 20;
+  int budget = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    vector<string> pair;
+    StringSplit(argv[i], "=", &pair);
+    if (pair.size() != 2 || pair[0].substr(0,2) != "--") {
+      cout << message << endl;
+      return -1;
+    }
+    string param_name = pair[0].substr(2);
+    string param_value = pair[1];
+    if (param_name == "family") {
+      family = param_value;
+    } else if (param_name == "file_output") {
+      filename_output = param_value;
+    } else if (param_name == "format") {
+      format = param_value;
+    } else if (param_name == "graphs") {
+      num_graphs = atoi(param_value.c_str());
+    } else if (param_name == "seed") {
+      seed = atoi(param_value.c_str());
+    } else if (param_name == "rows") {
+      num_rows = atoi(param_value.c_str());
+    } else if (param_name == "columns") {
+      num_columns = atoi(param_value.c_str());
+    } else if (param_name == "labels") {
+      num_labels = atoi(param_value.c_str());
+    } else if (param_name == "potts") {
+      if (param_value == "true") {
+        potts = true;
+      } else if (param_value == "false") {
+        potts = false;
+      } else {
+        cout << "Unknown value for flag potts: " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
+    } else if (param_name == "alpha") {
+      alpha = atof(param_value.c_str());
+    } else if (param_name == "variables") {
+      num_variables = atoi(param_value.c_str());
+    } else if (param_name == "factors") {
+      num_factors = atoi(param_value.c_str());
+    } else if (param_name == "degree") {
+      degree = atoi(param_value.c_str());
+    } else if (param_name == "length") {
+      length = atoi(param_value.c_str());
+    } else if (param_name == "sentences") {
+      num_sentences = atoi(param_value.c_str());
+    } else if (param_name == "budget") {
+      budget = atoi(param_value.c_str());
+    } else {
+      cout << "Unknown flag: " << param_name << endl;
+      cout << message << endl;
+      return -1;
+    }
+  }
+  if (filename_output == "" || num_graphs < 1 ||
+      (format != "ad3" && format != "uai")) {
+    cout << message << endl;
+    return -1;
+  }
+
+  GraphGenerator *generator = NULL;
+  if (family == "grid") {
+    if (num_rows < 1 || num_columns < 1 || num_labels < 1) {
+      cout << "Error: the grid must have at least one row, column and label."
+           << endl;
+      return -1;
+    }
+    generator = new GridGraphGenerator(num_rows, num_columns, num_labels,
+                                       potts, alpha);
+  } else if (family == "logic") {
+    if (num_variables < 1 || num_factors < 0 || degree < 2 ||
+        degree > num_variables) {
+      cout << "Error: the degree must be at least 2 and at most the number "
+           << "of variables." << endl;
+      return -1;
+    }
+    if (format == "uai" && degree > 20) {
+      cout << "Error: the degree must be at most 20 in the UAI format."
+           << endl;
+      return -1;
+    }
+    generator = new LogicGraphGenerator(num_variables, num_factors, degree);
+  } else if (family == "parsing") {
+    if (length < 2) {
+      cout << "Error: the length must be at least 2." << endl;
+      return -1;
+    }
+    generator = new ParsingGraphGenerator(length);
+  } else if (family == "summarization") {
+    if (num_sentences < 1 || length < 1 || budget < 0) {
+      cout << "Error: there must be at least one sentence and one word."
+           << endl;
+      return -1;
+    }
+    // By default, a quarter of the words can be kept.
+    if (budget == 0) {
+      budget = static_cast<int>(
+        static_cast<int64_t>(num_sentences) * length / 4);
+    }
+    generator = new SummarizationGraphGenerator(num_sentences, length,
+                                                budget);
+  } else {
+    cout << "Unknown value for flag family: " << family << endl;
+    cout << message << endl;
+    return -1;
+  }
+  generator->SetSeed(seed);
+
+  // The readers index variables and factors with int.
+  if (generator->GetNumVariables() > INT_MAX ||
+      generator->GetNumFactors() > INT_MAX) {
+    cout << "Error: the graph has too many variables or factors." << endl;
+    delete generator;
+    return -1;
+  }
+  if (format == "uai" && (!generator->SupportsUAI() || num_graphs > 1)) {
+    cout << "Error: only a single grid or logic graph can be written in the "
+         << "UAI format." << endl;
+    delete generator;
+    return -1;
+  }
+
+  FILE *file = fopen(filename_output.c_str(), "w");
+  if (!file) {
+    cout << "Error: Could not open " << filename_output << " for writing."
+         << endl;
+    delete generator;
+    return -1;
+  }
+  setvbuf(file, NULL, _IOFBF, 1 << 20);
+  int status = 0;
+  for (int k = 0; k < num_graphs && status == 0; ++k) {
+    // Graphs are separated by empty lines.
+    if (k > 0) fprintf(file, "\n");
+    if (format == "uai") {
+      status = generator->WriteGraphUAI(k, file);
+    } else {
+      status = generator->WriteGraph(k, file);
+    }
+  }
+  if (fclose(file) != 0) status = -1;
+  if (status != 0) {
+    cout << "Error: Could not write " << filename_output << "." << endl;
+    delete generator;
+    return -1;
+  }
+
+  cout << "Wrote " << num_graphs << " graph(s) to " << filename_output;
+  if (format == "ad3") {
+    cout << ": " << generator->GetNumVariables() << " variables, "
+         << generator->GetNumFactors() << " factors and "
+         << generator->GetNumLinks() << " links per graph";
+  }
+  cout << "." << endl;
+  delete generator;
+  return 0;
+}
@@ -17,30 +17,34 @@
 // along with AD3 2.1.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 #include <iostream>
 #include <sstream>
 #include <fstream>
 #include <assert.h>
+#include <deque>
+#include <map>
+#include <pthread.h>
 #include "ad3/FactorGraph.h"
+#include "ad3/FactorGraphReader.h"
+#include "ad3/FactorGraphWriter.h"
 #include "ad3/Utils.h"
-#include "FactorDense.h"
-#include "FactorSequence.h"
-#include "FactorTree.h"
-#include "FactorHeadAutomaton.h"
-#include "FactorGrandparentHeadAutomaton.h"
-#include "FactorSequenceCompressor.h"
-#include "FactorSequenceBudget.h"
-#include "FactorCompressionBudget.h"
-#include "FactorGeneralTree.h"
-#include "FactorGeneralTreeCounts.h"
-#include "FactorBinaryTree.h"
-#include "FactorBinaryTreeCounts.h"
+#include "ExampleFactorGraphReader.h"
 
 using namespace std;
 using namespace AD3;
 
 #define BUFFERSIZE 1024
 
+// Formats of the posteriors file.
+enum {
+  POSTERIORS_TEXT = 0,
+  POSTERIORS_FLOAT64,
+  POSTERIORS_FLOAT32
+};
+
 int RunAll(const string &format,
            const string &filename_graph,
            const string &algorithm,
@@ -50,21 +54,36 @@ int RunAll(const string &format,
            double residual_threshold,
            bool convert_to_binary,
            bool exact,
-           const string &filename_posteriors);
-
-int LoadGraph(ifstream &file_graph, 
-              FactorGraph *factor_graph);
-
-int LoadGraphUAI(ifstream &file_graph, 
-                 FactorGraph *factor_graph);
+           int branching_strategy,
+           int stepsize_rule,
+           bool decompose_components,
+           int num_threads,
+           int num_graph_threads,
+           int qp_solver,
+           bool sparse_tables,
+           const string &filename_binary,
+           const string &filename_posteriors,
+           int posteriors_format,
+           bool map_labels,
+           const string &filename_evidence,
+           const string &filename_uai_map);
 
 int main(int argc, char** argv) {
-  string message = "Usage: ad3_multi --format=[ad3(*)|uai] " \
+  string message = "Usage: ad3_multi --format=[ad3(*)|uai|binary] " \
     "--file_graphs=[IN] --file_posteriors=[OUT] " \
     "--algorithm=[ad3(*)|psdd|mplp] " \
     "(--max_iterations=[NUM] --eta=[NUM] --adapt_eta=[true(*)|false] " \
     "--residual_threshold=[NUM] --convert_to_binary=[true|false(*)] " \
-    "--exact=[true|false(*)])";
+    "--exact=[true|false(*)] " \
+    "--branching=[most_fractional(*)|pseudo_cost|strong|groups] " \
+    "--stepsize=[sqrt(*)|adaptive|polyak] " \
+    "--components=[true(*)|false] --threads=[NUM] " \
+    "--graph_threads=[NUM] " \
+    "--qp_solver=[active_set(*)|frank_wolfe] " \
+    "--sparse_tables=[true|false(*)] --file_binary=[OUT] " \
+    "--posteriors_format=[text(*)|float64|float32] " \
+    "--map_labels=[true|false(*)] --file_evidence=[IN] " \
+    "--file_uai_map=[OUT])";
   if (argc == 1) {
     cout << message << endl;
     return 0;
@@ -80,6 +99,18 @@ int main(int argc, char** argv) {
   bool adapt_eta = true;
   bool convert_to_binary = false;
   bool exact = false;
+  int branching_strategy = BRANCHING_MOST_FRACTIONAL;
+  int stepsize_rule = PSDD_STEPSIZE_SQRT;
+  bool decompose_components = true;
+  int num_threads = 1;
+  int num_graph_threads = 1;
+  int qp_solver = QP_SOLVER_ACTIVE_SET;
+  bool sparse_tables = false;
+  string filename_binary = "";
+  int posteriors_format = POSTERIORS_TEXT;
+  bool map_labels = false;
+  string filename_evidence = "";
+  string filename_uai_map = "";
   
   for (int i = 1; i < argc; ++i) {
     vector<string> pair;
@@ -98,6 +129,12 @@ int main(int argc, char** argv) {
       filename_graph = param_value;
     } else if (param_name == "file_posteriors") {
       filename_posteriors = param_value;
+    } else if (param_name == "file_binary") {
+      filename_binary = param_value;
+    } else if (param_name == "file_evidence") {
+      filename_evidence = param_value;
+    } else if (param_name == "file_uai_map") {
+      filename_uai_map = param_value;
     } else if (param_name == "max_iterations") {
       niters = atoi(param_value.c_str());
     } else if (param_name == "eta") {
@@ -136,6 +173,101 @@ int main(int argc, char** argv) {
         cout << message << endl;
         return -1;
       }
+    } else if (param_name == "branching") {
+      if (param_value == "most_fractional") {
+        branching_strategy = BRANCHING_MOST_FRACTIONAL;
+      } else if (param_value == "pseudo_cost") {
+        branching_strategy = BRANCHING_PSEUDO_COST;
+      } else if (param_value == "strong") {
+        branching_strategy = BRANCHING_STRONG;
+      } else if (param_value == "groups") {
+        branching_strategy = BRANCHING_GROUPS;
+      } else {
+        cout << "Unknown value for flag " << param_name
+             << ": " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
+    } else if (param_name == "stepsize") {
+      if (param_value == "sqrt") {
+        stepsize_rule = PSDD_STEPSIZE_SQRT;
+      } else if (param_value == "adaptive") {
+        stepsize_rule = PSDD_STEPSIZE_ADAPTIVE;
+      } else if (param_value == "polyak") {
+        stepsize_rule = PSDD_STEPSIZE_POLYAK;
+      } else {
+        cout << "Unknown value for flag " << param_name
+             << ": " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
+    } else if (param_name == "components") {
+      if (param_value == "false") {
+        decompose_components = false;
+      } else if (param_value == "true") {
+        decompose_components = true;
+      } else {
+        cout << "Unknown value for flag " << param_name
+             << ": " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
+    } else if (param_name == "threads") {
+      num_threads = atoi(param_value.c_str());
+    } else if (param_name == "graph_threads") {
+      num_graph_threads = atoi(param_value.c_str());
+      if (num_graph_threads < 1) {
+        cout << "Unknown value for flag " << param_name
+             << ": " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
+    } else if (param_name == "qp_solver") {
+      if (param_value == "active_set") {
+        qp_solver = QP_SOLVER_ACTIVE_SET;
+      } else if (param_value == "frank_wolfe") {
+        qp_solver = QP_SOLVER_FRANK_WOLFE;
+      } else {
+        cout << "Unknown value for flag " << param_name
+             << ": " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
+    } else if (param_name == "sparse_tables") {
+      if (param_value == "false") {
+        sparse_tables = false;
+      } else if (param_value == "true") {
+        sparse_tables = true;
+      } else {
+        cout << "Unknown value for flag " << param_name
+             << ": " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
+    } else if (param_name == "posteriors_format") {
+      if (param_value == "text") {
+        posteriors_format = POSTERIORS_TEXT;
+      } else if (param_value == "float64") {
+        posteriors_format = POSTERIORS_FLOAT64;
+      } else if (param_value == "float32") {
+        posteriors_format = POSTERIORS_FLOAT32;
+      } else {
+        cout << "Unknown value for flag " << param_name
+             << ": " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
+    } else if (param_name == "map_labels") {
+      if (param_value == "false") {
+        map_labels = false;
+      } else if (param_value == "true") {
+        map_labels = true;
+      } else {
+        cout << "Unknown value for flag " << param_name
+             << ": " << param_value << endl;
+        cout << message << endl;
+        return -1;
+      }
     } else {
       cout << "Unknown flag: " << param_name << endl;
       cout << message << endl;
@@ -148,6 +280,19 @@ int main(int argc, char** argv) {
     return -1;
   }
 
+  if ((filename_evidence != "" || filename_uai_map != "") &&
+      format != "uai") {
+    cout << "Error: flags --file_evidence and --file_uai_map can only be set "
+         << "with --format=uai." << endl;
+    return -1;
+  }
+
+  if (filename_uai_map != "" && convert_to_binary) {
+    cout << "Error: flag --file_uai_map cannot be set with "
+         << "--convert_to_binary=true." << endl;
+    return -1;
+  }
+
   RunAll(format,
          filename_graph,
          algorithm,
@@ -157,670 +302,737 @@ int main(int argc, char** argv) {
          residual_threshold,
          convert_to_binary,
          exact,
-         filename_posteriors);
+         branching_strategy,
+         stepsize_rule,
+         decompose_components,
+         num_threads,
+         num_graph_threads,
+         qp_solver,
+         sparse_tables,
+         filename_binary,
+         filename_posteriors,
+         posteriors_format,
+         map_labels,
+         filename_evidence,
+         filename_uai_map);
 
   return 0;
 }
 
-int RunAll(const string &format,
-           const string &filename_graph,
-           const string &algorithm,
-           int niters,
-           double eta,
-           bool adapt_eta,
-           double residual_threshold,
-           bool convert_to_binary,
-           bool exact,
-           const string &filename_posteriors) {
-  int time_ddadmm_relax = 0;
-  int time_ddadmm = 0;
-  int time_cplex_relax = 0;
-  int time_cplex_integer = 0;
-  ifstream file_graph(filename_graph.c_str(), ios_base::in);
-  ofstream file_posteriors(filename_posteriors.c_str(), ios_base::out);
-  if (file_graph.is_open()) {
-    while (!file_graph.eof()) {
-      FactorGraph factor_graph;
-      timeval start, end;
-      if (format == "ad3") {
-        if (0 > LoadGraph(file_graph, &factor_graph)) continue;
-      } else if (format == "uai") {
-#if 0
-        cout << "UAI format not implemented yet." << endl;
-        assert(false);
-#else
-        if (convert_to_binary) {
-          FactorGraph factor_graph_original;
-          if (0 > LoadGraphUAI(file_graph, &factor_graph_original)) continue;
-          factor_graph_original.ConvertToBinaryFactorGraph(&factor_graph);
-        } else {
-          if (0 > LoadGraphUAI(file_graph, &factor_graph)) continue;
-          factor_graph.FixMultiVariablesWithoutFactors();
-        }
+// A factor graph of the input file, and the results of solving it.
+struct GraphJob {
+  FactorGraph factor_graph;
+  // Messages about the graph, printed when its results are written, so
+  // that the log follows the order of the input.
+  string log;
+  vector<double> posteriors;
+  vector<double> additional_posteriors;
+  double value;
+  // Time spent solving the graph (in milliseconds).
+  int time;
+  // Evidence of the multi-variables of the UAI model (see
+  // FactorGraphReader::GetEvidence), and log-potential of the factors it
+  // determines.
+  vector<int> evidence;
+  double evidence_log_potential;
+#ifdef LPSOLVER_CPLEX
+  vector<double> posteriors_cplex_relax;
+  vector<double> posteriors_cplex_integer;
+  vector<double> additional_posteriors_cplex_relax;
+  vector<double> additional_posteriors_cplex_integer;
+  int time_cplex_relax;
+  int time_cplex_integer;
 #endif
+};
+
+// Pipeline which processes the graphs of a file: a reader thread reads the
+// graphs ahead, a pool of workers solves them concurrently (each graph with
+// num_threads threads of its own), and the calling thread writes the
+// results in the order of the input. The number of graphs in flight (read
+// but not written yet) is bounded, so that memory does not grow with the
+// size of the file.
+struct GraphPipeline {
+  // Options for reading and solving the graphs.
+  string format;
+  bool convert_to_binary;
+  bool sparse_tables;
+  string algorithm;
+  int niters;
+  double eta;
+  bool adapt_eta;
+  double residual_threshold;
+  bool exact;
+  int branching_strategy;
+  int stepsize_rule;
+  bool decompose_components;
+  int num_threads;
+  int qp_solver;
+  bool uai_map;
+
+  ExampleFactorGraphReader *reader;
+
+  // State shared by the threads, guarded by mutex. Jobs are indexed by
+  // their position in the file.
+  pthread_mutex_t mutex;
+  pthread_cond_t changed;
+  deque<pair<int, GraphJob*> > pending;
+  map<int, GraphJob*> solved;
+  int num_read;
+  int num_in_flight;
+  int max_in_flight;
+  bool done_reading;
+  bool stop;
+};
+
+// Read the next graph of the file. Returns false at the end of the file.
+bool ReadGraphJob(GraphPipeline *pipeline, GraphJob *job) {
+  ExampleFactorGraphReader *reader = pipeline->reader;
+  FactorGraph &factor_graph = job->factor_graph;
+  ostringstream log;
+  reader->SetLog(&log);
+  bool read = false;
+  if (pipeline->format == "ad3") {
+    read = (0 <= reader->ReadGraph(&factor_graph));
+    if (read) {
+      log << "Read " << reader->GetNumVariables() << " variables and "
+          << reader->GetNumFactors() << " factors." << endl;
+    }
+  } else if (pipeline->format == "uai") {
+    if (pipeline->convert_to_binary) {
+      FactorGraph factor_graph_original;
+      read = (0 <= reader->ReadGraphUAI(&factor_graph_original,
+                                        pipeline->sparse_tables));
+      if (read) {
+        factor_graph_original.ConvertToBinaryFactorGraph(&factor_graph);
       }
-      cout << "Running " << niters << " iterations of "
-           << algorithm << " (eta = "
-           << eta << ")..." << endl;
-
-      gettimeofday(&start, NULL);
-      vector<double> posteriors;
-      vector<double> additional_posteriors;
-      double value;
-      if (algorithm == "ad3") {
-        factor_graph.SetEtaAD3(eta);
-        factor_graph.AdaptEtaAD3(adapt_eta);
-        factor_graph.SetMaxIterationsAD3(niters);
-        factor_graph.SetResidualThresholdAD3(residual_threshold);
-        if (exact) {
-          factor_graph.SolveExactMAPWithAD3(&posteriors, &additional_posteriors,
-                                         &value);
-        } else {
-          factor_graph.SolveLPMAPWithAD3(&posteriors, &additional_posteriors,
-                                         &value);
-        }
-      } else if (algorithm == "psdd") {
-        assert(!exact);
-        factor_graph.SetEtaPSDD(eta);
-        factor_graph.SetMaxIterationsPSDD(niters);
-        factor_graph.SolveLPMAPWithPSDD(&posteriors, &additional_posteriors, &value);
-      } else if (algorithm == "mplp") {
-        cout << "MPLP is not implemented yet.";
-        assert(false);
-      } else {
-        cout << "Unknown algorithm: " << algorithm << endl;
+    } else {
+      read = (0 <= reader->ReadGraphUAI(&factor_graph,
+                                        pipeline->sparse_tables));
+      if (read) factor_graph.FixMultiVariablesWithoutFactors();
+    }
+    if (read) {
+      job->evidence = reader->GetEvidence();
+      job->evidence_log_potential = reader->GetEvidenceLogPotential();
+      log << "Read " << reader->GetNumVariables() << " multi-variables and "
+          << reader->GetNumFactors() << " factors." << endl;
+      int num_observed = job->evidence.size() -
+        factor_graph.GetNumMultiVariables();
+      if (num_observed > 0) {
+        log << "Evidence on " << num_observed << " multi-variables." << endl;
       }
-      gettimeofday(&end, NULL);
-      time_ddadmm += diff_ms(end,start);
-
-#if 0
-      gettimeofday(&start, NULL);
-      vector<double> posteriors_relax;
-      factor_graph.ComputeLPMAPWithAD3(&posteriors_relax, &value);
-      gettimeofday(&end, NULL);
-      time_ddadmm_relax += diff_ms(end,start);
-#endif
+    }
+  } else {
+    // Graphs saved with the state of AD3 resume from it.
+    assert(pipeline->format == "binary");
+    read = (0 <= reader->ReadGraphBinary(&factor_graph, true));
+    if (read) {
+      log << "Read " << reader->GetNumVariables() << " variables and "
+          << reader->GetNumFactors() << " factors." << endl;
+    }
+  }
+  reader->SetLog(&cout);
+  job->log = log.str();
+  return read;
+}
 
-#ifdef LPSOLVER_CPLEX
-      gettimeofday(&start, NULL);
-      vector<double> posteriors_cplex_relax;
-      factor_graph.ComputeLPMAPWithCPLEX(&posteriors_cplex_relax,
-                                         &additional_posteriors_cplex_relax,
-                                         &value);
-      gettimeofday(&end, NULL);
-      time_cplex_relax += diff_ms(end,start);
-
-      gettimeofday(&start, NULL);
-      vector<double> posteriors_cplex_integer;
-      factor_graph.ComputeLPMAPWithCPLEX(&posteriors_cplex_integer,
-                                         &additional_posteriors_cplex_integer,
-                                         &value);
-      gettimeofday(&end, NULL);
-      time_cplex_integer += diff_ms(end,start);
-#endif
+// Solve a graph with the algorithm of the pipeline.
+void SolveGraphJob(const GraphPipeline &pipeline, GraphJob *job) {
+  FactorGraph &factor_graph = job->factor_graph;
+  const string &algorithm = pipeline.algorithm;
+  for (int i = 0; i < factor_graph.GetNumFactors(); ++i) {
+    Factor *factor = factor_graph.GetFactor(i);
+    if (factor->IsGeneric()) {
+      static_cast<GenericFactor*>(factor)->SetQPSolver(pipeline.qp_solver);
+    }
+  }
 
-      if (file_posteriors.is_open()) {
-        for (int i = 0; i < posteriors.size(); ++i) {
-          file_posteriors << posteriors[i];
-#ifdef LPSOLVER_CPLEX
-          file_posteriors << "\t" << posteriors_cplex_relax[i]
-                          << "\t" << posteriors_cplex_integer[i];
-#endif
-          file_posteriors << endl;
-        }
-        file_posteriors << endl;
-        for (int i = 0; i < additional_posteriors.size(); ++i) {
-          file_posteriors << additional_posteriors[i];
-#ifdef LPSOLVER_CPLEX
-          file_posteriors << "\t" << additional_posteriors_cplex_relax[i]
-                          << "\t" << additional_posteriors_cplex_integer[i];
-#endif
-          file_posteriors << endl;
-        }
-        file_posteriors << endl;
-      } else {
-        cout << "Error: Could not open " << filename_posteriors << " for writing." << endl;
-        return -1;
-      }
+  ostringstream log;
+  log << "Running " << pipeline.niters << " iterations of "
+      << algorithm << " (eta = "
+      << pipeline.eta << ")..." << endl;
+  job->log += log.str();
+
+  timeval start, end;
+  gettimeofday(&start, NULL);
+  vector<double> &posteriors = job->posteriors;
+  vector<double> &additional_posteriors = job->additional_posteriors;
+  double &value = job->value;
+  if (algorithm == "ad3") {
+    factor_graph.SetEtaAD3(pipeline.eta);
+    factor_graph.AdaptEtaAD3(pipeline.adapt_eta);
+    factor_graph.SetMaxIterationsAD3(pipeline.niters);
+    factor_graph.SetResidualThresholdAD3(pipeline.residual_threshold);
+    factor_graph.SetDecomposeComponentsAD3(pipeline.decompose_components);
+    factor_graph.SetNumThreads(pipeline.num_threads);
+    if (pipeline.exact) {
+      factor_graph.SetBranchingStrategyAD3(pipeline.branching_strategy);
+      factor_graph.SolveExactMAPWithAD3(&posteriors, &additional_posteriors,
+                                        &value);
+    } else {
+      factor_graph.SolveLPMAPWithAD3(&posteriors, &additional_posteriors,
+                                     &value);
     }
+  } else if (algorithm == "psdd") {
+    assert(!pipeline.exact);
+    factor_graph.SetEtaPSDD(pipeline.eta);
+    factor_graph.SetMaxIterationsPSDD(pipeline.niters);
+    factor_graph.SetStepsizeRulePSDD(pipeline.stepsize_rule);
+    factor_graph.SetNumThreads(pipeline.num_threads);
+    factor_graph.SolveLPMAPWithPSDD(&posteriors, &additional_posteriors, &value);
+  } else if (algorithm == "mplp") {
+    assert(!pipeline.exact);
+    factor_graph.SetMaxIterationsMPLP(pipeline.niters);
+    factor_graph.SolveLPMAPWithMPLP(&posteriors, &additional_posteriors, &value);
   } else {
-    cout << "Error: Could not open " << filename_graph << " for reading." << endl;
-    return -1;
+    job->log += "Unknown algorithm: " + algorithm + "\n";
   }
-  file_graph.clear();
-  file_graph.close();
-  file_posteriors.flush();
-  file_posteriors.clear();
-  file_posteriors.close();
+  gettimeofday(&end, NULL);
+  job->time = diff_ms(end,start);
 
-#if LPSOLVER_CPLEX
-  cout << "Elapsed times: " << endl;
-  cout << "AD3 relax: " << static_cast<double>(time_ddadmm_relax)/1000.0 
-       << " sec." << endl; 
-  cout << "AD3 integer: " << static_cast<double>(time_ddadmm)/1000.0 
-       << " sec." << endl; 
-  cout << "CPLEX relax: " << static_cast<double>(time_cplex_relax)/1000.0 
-       << " sec." << endl; 
-  cout << "CPLEX integer: " << static_cast<double>(time_cplex_integer)/1000.0 
-       << " sec." << endl; 
-#else
-  cout << "Elapsed time: " << static_cast<double>(time_ddadmm)/1000.0 
-       << " sec." << endl; 
+  if (pipeline.uai_map) {
+    // Bounds on the MAP value of the model, with the factors determined by
+    // the evidence.
+    double lower_bound;
+    ostringstream log;
+    log << "MAP time: " << static_cast<double>(job->time)/1000.0
+        << " sec, upper bound: "
+        << factor_graph.GetLastUpperBound() + job->evidence_log_potential;
+    if (factor_graph.EvaluateRoundedPosteriors(posteriors, &lower_bound)) {
+      log << ", lower bound: " << lower_bound + job->evidence_log_potential;
+    } else {
+      log << ", lower bound: none (infeasible assignment)";
+    }
+    log << endl;
+    job->log += log.str();
+  }
+
+#ifdef LPSOLVER_CPLEX
+  gettimeofday(&start, NULL);
+  factor_graph.ComputeLPMAPWithCPLEX(&job->posteriors_cplex_relax,
+                                     &job->additional_posteriors_cplex_relax,
+                                     &value);
+  gettimeofday(&end, NULL);
+  job->time_cplex_relax = diff_ms(end,start);
+
+  gettimeofday(&start, NULL);
+  factor_graph.ComputeLPMAPWithCPLEX(&job->posteriors_cplex_integer,
+                                     &job->additional_posteriors_cplex_integer,
+                                     &value);
+  gettimeofday(&end, NULL);
+  job->time_cplex_integer = diff_ms(end,start);
 #endif
-  return 0;
 }
 
-int LoadGraph(ifstream &file_graph, 
-              FactorGraph *factor_graph) {
-  string line;
-
-  // Read number of variables.
-  getline(file_graph, line);
-  //cout << line << endl;
-  if (file_graph.eof()) return -1;
-  TrimComments("#", &line);
-  int num_variables = atoi(line.c_str());
-
-  // Read number of factors.
-  getline(file_graph, line);
-  //cout << line << endl;
-  TrimComments("#", &line);
-  int num_factors = atoi(line.c_str());
-
-  // Read variable log-potentials.
-  vector<BinaryVariable*> variables(num_variables);
-  for (int i = 0; i < num_variables; ++i) {
-    getline(file_graph, line);
-    TrimComments("#", &line);
-    double log_potential = atof(line.c_str());
-    BinaryVariable* variable = factor_graph->CreateBinaryVariable();
-    variable->SetLogPotential(log_potential);
-    variables[i] = variable;
+// Read the graphs of the file, waiting while too many graphs are in flight.
+void *RunGraphReader(void *arg) {
+  GraphPipeline *pipeline = static_cast<GraphPipeline*>(arg);
+  for (int index = 0; ; ++index) {
+    pthread_mutex_lock(&pipeline->mutex);
+    while (!pipeline->stop &&
+           pipeline->num_in_flight >= pipeline->max_in_flight) {
+      pthread_cond_wait(&pipeline->changed, &pipeline->mutex);
+    }
+    bool stop = pipeline->stop;
+    pthread_mutex_unlock(&pipeline->mutex);
+    if (stop) break;
+
+    GraphJob *job = new GraphJob;
+    bool read = ReadGraphJob(pipeline, job);
+    pthread_mutex_lock(&pipeline->mutex);
+    if (read) {
+      pipeline->pending.push_back(make_pair(index, job));
+      ++pipeline->num_read;
+      ++pipeline->num_in_flight;
+    }
+    pthread_cond_broadcast(&pipeline->changed);
+    pthread_mutex_unlock(&pipeline->mutex);
+    if (!read) {
+      delete job;
+      break;
+    }
   }
+  pthread_mutex_lock(&pipeline->mutex);
+  pipeline->done_reading = true;
+  pthread_cond_broadcast(&pipeline->changed);
+  pthread_mutex_unlock(&pipeline->mutex);
+  return NULL;
+}
 
-  // Read factors.
-  int num_messages = 0;
-  int num_factor_log_potentials = 0;
-  for (int i = 0; i < num_factors; ++i) {
-    getline(file_graph, line);
-    TrimComments("#", &line);
-    vector<string> fields;
-    StringSplit(line, "\t ", &fields);
-
-    // Read linked variables.
-    int offset = 1;
-    int num_links = atoi(fields[1].c_str());
-    vector<BinaryVariable*> binary_variables(num_links);
-    vector<bool> negated(num_links, false);
-    ++offset;
-
-    if (fields[0] == "PAIR" && num_links != 2) {
-      cout << "Error: PAIR factor must be attached to 2 variables." << endl;
-      return -1;
+// Solve the graphs which were read, until there are no more.
+void *RunGraphWorker(void *arg) {
+  GraphPipeline *pipeline = static_cast<GraphPipeline*>(arg);
+  while (true) {
+    pthread_mutex_lock(&pipeline->mutex);
+    while (!pipeline->stop && pipeline->pending.empty() &&
+           !pipeline->done_reading) {
+      pthread_cond_wait(&pipeline->changed, &pipeline->mutex);
     }
-    for (int j = 0; j < num_links; ++j) {
-      int k = atoi(fields[offset+j].c_str());
-      if (k < 0) {
-        negated[j] = true;
-        k = -k;
-      }
-      --k;
-      binary_variables[j] = variables[k];
+    if (pipeline->stop || pipeline->pending.empty()) {
+      pthread_mutex_unlock(&pipeline->mutex);
+      break;
     }
+    pair<int, GraphJob*> item = pipeline->pending.front();
+    pipeline->pending.pop_front();
+    pthread_mutex_unlock(&pipeline->mutex);
 
-    // Read factor type.
-    Factor *factor;
-    if (fields[0] == "XOR") {
-      factor = factor_graph->CreateFactorXOR(binary_variables, negated);
-    } else if (fields[0] == "XOROUT") {
-      factor = factor_graph->CreateFactorXOROUT(binary_variables, negated);
-    } else if (fields[0] == "ATMOSTONE") {
-      factor = factor_graph->CreateFactorAtMostOne(binary_variables,
-                                                   negated);
-    } else if (fields[0] == "OR") {
-      factor = factor_graph->CreateFactorOR(binary_variables, negated);
-    } else if (fields[0] == "OROUT") {
-      factor = factor_graph->CreateFactorOROUT(binary_variables, negated);
-    } else if (fields[0] == "ANDOUT") {
-      factor = factor_graph->CreateFactorANDOUT(binary_variables, negated);
-    } else if (fields[0] == "BUDGET") {
-      // Read the budget value.
-      int budget = atoi(fields[offset+num_links].c_str());      
-      factor = factor_graph->CreateFactorBUDGET(binary_variables, negated, budget);      
-    } else if (fields[0] == "PAIR") {
-      // If it is a soft factor, read the factor log-potential.
-      double log_potential = atof(fields[offset+num_links].c_str());
-      //int r = num_variables + num_factor_log_potentials;
-      ++num_factor_log_potentials;
-      //static_cast<FactorPAIR*>(factor)->SetGlobalIndex(r);
-      //static_cast<FactorPAIR*>(factor)->SetFactorLogPotential(log_potential);
-      factor = factor_graph->CreateFactorPAIR(binary_variables, log_potential);
-    } else if (fields[0] == "DENSE") {
-      // Read the number of multi-variables.
-      int num_multi_variables = atoi(fields[offset+num_links].c_str());
-      // Read the number of states for each multi-variable.
-      vector<MultiVariable*> multi_variables(num_multi_variables);
-      int num_configurations = 1;
-      int total_states = 0;
-      for (int k = 0; k < num_multi_variables; ++k) {
-        int num_states = atoi(fields[offset+num_links+1+k].c_str());
-        num_configurations *= num_states;
-        vector<BinaryVariable*> states(binary_variables.begin() + total_states,
-                                       binary_variables.begin() + total_states +
-                                         num_states);
-        total_states += num_states;
-        multi_variables[k] = factor_graph->CreateMultiVariable(states);
-      }
+    SolveGraphJob(*pipeline, item.second);
 
-      // Read the additional log-potentials.
-      vector<double> additional_scores;
-      for (int index = 0; index < num_configurations; ++index) {
-        // Read the factor log-potential for this configuration.
-        double log_potential = atof(fields[offset+num_links+1+num_multi_variables+index].c_str());
-        additional_scores.push_back(log_potential);
-      }
+    pthread_mutex_lock(&pipeline->mutex);
+    pipeline->solved[item.first] = item.second;
+    pthread_cond_broadcast(&pipeline->changed);
+    pthread_mutex_unlock(&pipeline->mutex);
+  }
+  return NULL;
+}
 
-      // Create the factor and declare it.
-      factor = new FactorDense;
-      factor_graph->DeclareFactor(factor, binary_variables, true);
-      static_cast<FactorDense*>(factor)->Initialize(multi_variables);
-      factor->SetAdditionalLogPotentials(additional_scores);
-      num_factor_log_potentials += additional_scores.size();
-      cout << "Read dense factor." << endl;
-    } else if (fields[0] == "SEQUENCE" ||
-               fields[0] == "SEQUENCE_BUDGET") {
-      bool has_budget = false;
-      if (fields[0] == "SEQUENCE_BUDGET") has_budget = true;
-      // Read the sequence length.
-      int length = atoi(fields[offset+num_links].c_str());
-      // If budget, read the budget.
-      int budget = -1;
-      if (has_budget) {
-        ++offset; // TODO: Make sure this is fine.
-        budget = atoi(fields[offset+num_links].c_str());
-      }
+// Type of the values of a block in the binary posteriors file.
+enum {
+  POSTERIORS_VALUES_FLOAT64 = 0,
+  POSTERIORS_VALUES_FLOAT32,
+  POSTERIORS_VALUES_LABELS
+};
 
-      // Read the number of states for each position in the sequence.
-      vector<int> num_states(length);
-      int total_states = 0;
-      for (int k = 0; k < length; ++k) {
-        num_states[k] = atoi(fields[offset+num_links+1+k].c_str());
-        total_states += num_states[k];
-      }
+// Header of the block of each graph in the binary posteriors file. It is
+// followed by num_values values and num_additional_values values (the
+// variable and additional posteriors, or the MAP labels as int32 and no
+// additional values), each array padded to a multiple of 8 bytes.
+struct BinaryPosteriorsHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t value_type;
+  // Position of the graph in the input file.
+  uint64_t graph;
+  int64_t num_values;
+  int64_t num_additional_values;
+  // Value of the objective.
+  double value;
+};
 
-      // Read the additional log-potentials.
-      vector<double> additional_scores;
-      int index = 0;
-      for (int i = 0; i <= length; ++i) {
-        // If i == 0, the previous state is the start symbol.
-        int num_previous_states = (i > 0)? num_states[i - 1] : 1;
-        // If i == length-1, the previous state is the final symbol.
-        int num_current_states = (i < length)? num_states[i] : 1;
-        for (int j = 0; j < num_previous_states; ++j) {
-          for (int k = 0; k < num_current_states; ++k) {
-            double log_potential = atof(fields[offset+num_links+1+length+index].c_str());
-            additional_scores.push_back(log_potential);
-            ++index;
-          }
-        }
-      }
-      if (fields.size() != offset+num_links+1+length+index) {
-        cout << fields.size() << " "
-             << offset+num_links+1+length+index;
-        assert(false);
-      }
+static const char kBinaryPosteriorsMagic[8] = { 'A', 'D', '3', 'P',
+                                                'O', 'S', 'T', 'S' };
+static const uint32_t kBinaryPosteriorsVersion = 1;
 
-      // Create the factor and declare it.
-      if (has_budget) {
-        factor = new FactorSequenceBudget;
-        factor_graph->DeclareFactor(factor, binary_variables, true);
-        static_cast<FactorSequenceBudget*>(factor)->
-          Initialize(num_states, budget);
-        factor->SetAdditionalLogPotentials(additional_scores);
-        num_factor_log_potentials += additional_scores.size();
-        cout << "Read sequence budget factor." << endl;
-      } else {
-        factor = new FactorSequence;
-        factor_graph->DeclareFactor(factor, binary_variables, true);
-        static_cast<FactorSequence*>(factor)->Initialize(num_states);
-        factor->SetAdditionalLogPotentials(additional_scores);
-        num_factor_log_potentials += additional_scores.size();
-        cout << "Read sequence factor." << endl;
-      }        
-    } else if (fields[0] == "GENERAL_TREE" ||
-               fields[0] == "GENERAL_TREE_COUNTS") {
-      // Read the number of nodes in the tree.
-      int length = atoi(fields[offset+num_links].c_str());
-
-      // Read the number of states for each node in the tree.
-      vector<int> num_states(length);
-      int total_states = 0;
-      for (int k = 0; k < length; ++k) {
-        num_states[k] = atoi(fields[offset+num_links+1+k].c_str());
-        total_states += num_states[k];
-      }
+// Writer of the results of each graph: the posteriors of the variables and
+// the additional posteriors, or only the MAP label of each multi-variable,
+// as text (one value per line, with a blank line after each list) or as a
+// binary block (see BinaryPosteriorsHeader). The output is kept in a
+// buffer and written to the file in large chunks.
+class PosteriorsWriter {
+ public:
+  PosteriorsWriter() : format_(POSTERIORS_TEXT), map_labels_(false),
+                       num_graphs_(0) {}
 
-      // Read the parent node for each node in the tree.
-      vector<int> parents(length);
-      for (int k = 0; k < length; ++k) {
-        parents[k] = atoi(fields[offset+num_links+1+length+k].c_str());
-      }
+  // Open a file for writing. Returns false if it cannot be created.
+  bool Open(const string &filename, int format, bool map_labels);
 
-      // Read the additional log-potentials.
-      vector<double> additional_scores;
-      int index = 0;
-      for (int i = 1; i < length; ++i) {
-        int p = parents[i];
-        int num_previous_states = num_states[p];
-        int num_current_states = num_states[i];
-        for (int k = 0; k < num_previous_states; ++k) {
-          for (int j = 0; j < num_current_states; ++j) {
-            double log_potential = atof(fields[offset+num_links+1+length+length+index].c_str());
-            additional_scores.push_back(log_potential);
-            ++index;
-          }
-        }
-      }
-      if (fields.size() != offset+num_links+1+length+length+index) {
-        cout << fields.size() << " "
-             << offset+num_links+1+length+length+index << endl;
-        assert(false);
-      }
+  // Write the results of a graph. Returns 0 on success and -1 if the file
+  // cannot be written.
+  int Write(GraphJob *job);
 
-      // Create the factor and declare it.
-      if (fields[0] == "GENERAL_TREE") {
-        factor = new FactorGeneralTree;
-        factor_graph->DeclareFactor(factor, binary_variables, true);
-        static_cast<FactorGeneralTree*>(factor)->Initialize(parents, num_states);
-      } else {
-        factor = new FactorGeneralTreeCounts;
-        factor_graph->DeclareFactor(factor, binary_variables, true);
-        static_cast<FactorGeneralTreeCounts*>(factor)->Initialize(parents, num_states);
-      }
+  // Write what is left in the buffer and close the file. Returns 0 on
+  // success and -1 if the file cannot be written.
+  int Close();
 
-      factor->SetAdditionalLogPotentials(additional_scores);
-      num_factor_log_potentials += additional_scores.size();
-      if (fields[0] == "GENERAL_TREE") {
-        cout << "Read general tree factor." << endl;
-      } else {
-        cout << "Read general tree counts factor." << endl;
-      }
-    } else if (fields[0] == "ARBORESCENCE") {
-      // Read the sentence length.
-      int sentence_length = atoi(fields[offset+num_links].c_str());
-      // Read the arcs.
-      vector<Arc*> arcs(binary_variables.size());
-      for (int r = 0; r < binary_variables.size(); ++r) {
-        //cout << fields.size() << " " << offset+num_links+2*r+1 << endl;
-        int h = atoi(fields[offset+num_links+1+2*r].c_str());
-        int m = atoi(fields[offset+num_links+1+2*r+1].c_str());
-        Arc *arc = new Arc(h, m);
-        arcs[r] = arc;
-      }
-      factor = new FactorTree;
-      factor_graph->DeclareFactor(factor, binary_variables, true);
-      static_cast<FactorTree*>(factor)->Initialize(sentence_length, arcs);
-      for (int r = 0; r < arcs.size(); ++r) {
-        delete arcs[r];
-      }
-      cout << "Read tree factor." << endl;
-    } else if (fields[0] == "HEAD_AUTOMATON") {
-      // Read the length of the automaton.
-      int length = binary_variables.size() + 1;
-      vector<vector<int> > index_siblings(length, vector<int>(length+1, -1));
-      int total = 0;
-      vector<Sibling*> siblings;
-      vector<double> additional_scores;
-      for (int m = 0; m < length; ++m) {
-        for (int s = m+1; s <= length; ++s) {
-          // Create a fake sibling.
-          Sibling *sibling = new Sibling(0, m, s);
-          siblings.push_back(sibling);
-          // Read the sibling log-potential.
-          double log_potential = atof(fields[offset+num_links+total].c_str());
-          additional_scores.push_back(log_potential);
-          ++total;
-        }
-      }
-      factor = new FactorHeadAutomaton;
-      factor_graph->DeclareFactor(factor, binary_variables, true);
-      static_cast<FactorHeadAutomaton*>(factor)->Initialize(length, siblings);
-      for (int r = 0; r < siblings.size(); ++r) {
-        delete siblings[r];
-      }
-      factor->SetAdditionalLogPotentials(additional_scores);
-      num_factor_log_potentials += additional_scores.size();
-      cout << "Read head automaton factor." << endl;
-    } else if (fields[0] == "SEQUENCE_COMPRESSOR") {
-      // Read the length of the automaton.
-      int length = binary_variables.size();
-      vector<vector<int> > index_siblings(length, vector<int>(length+1, -1));
-      int total = 0;
-      vector<Sibling*> siblings;
-      vector<double> additional_scores;
-      for (int m = 0; m < length; ++m) {
-        for (int s = m+1; s <= length; ++s) {
-          // Create a fake sibling.
-          Sibling *sibling = new Sibling(0, m, s);
-          siblings.push_back(sibling);
-          // Read the sibling log-potential.
-          double log_potential = atof(fields[offset+num_links+total].c_str());
-          additional_scores.push_back(log_potential);
-          ++total;
-        }
-      }
-      factor = new FactorSequenceCompressor;
-      factor_graph->DeclareFactor(factor, binary_variables, true);
-      static_cast<FactorSequenceCompressor*>(factor)->Initialize(length, siblings);
-      for (int r = 0; r < siblings.size(); ++r) {
-        delete siblings[r];
-      }
-      factor->SetAdditionalLogPotentials(additional_scores);
-      num_factor_log_potentials += additional_scores.size();
-      cout << "Read sequence compressor factor." << endl;
-    } else if (fields[0] == "GRANDPARENT_HEAD_AUTOMATON") {
-      // Read the number of grandparents.
-      int num_grandparents = atoi(fields[offset+num_links].c_str());
-      // Read the length of the automaton.
-      int length = binary_variables.size() + 1 - num_grandparents;
-      vector<vector<int> > index_siblings(length, vector<int>(length+1, -1));
-      int total = 0;
-      vector<Grandparent*> grandparents;
-      vector<double> additional_scores;
-      for (int g = 0; g < num_grandparents; ++g) {
-        for (int m = 1; m < length; ++m) {
-          // Create a fake grandparent.
-          Grandparent *grandparent = new Grandparent(g, 0, m);
-          grandparents.push_back(grandparent);
-          // Read the sibling log-potential.
-          double log_potential = atof(fields[offset+num_links+1+total].c_str());
-          additional_scores.push_back(log_potential);
-          ++total;
-        }
-      }
-      vector<Sibling*> siblings;
-      for (int m = 0; m < length; ++m) {
-        for (int s = m+1; s <= length; ++s) {
-          // Create a fake sibling.
-          Sibling *sibling = new Sibling(0, m, s);
-          siblings.push_back(sibling);
-          // Read the sibling log-potential.
-          double log_potential = atof(fields[offset+num_links+1+total].c_str());
-          additional_scores.push_back(log_potential);
-          ++total;
-        }
-      }
-      factor = new FactorGrandparentHeadAutomaton;
-      factor_graph->DeclareFactor(factor, binary_variables, true);
-      static_cast<FactorGrandparentHeadAutomaton*>(factor)->
-        Initialize(length, num_grandparents, siblings, grandparents);
-      for (int r = 0; r < grandparents.size(); ++r) {
-        delete grandparents[r];
-      }
-      for (int r = 0; r < siblings.size(); ++r) {
-        delete siblings[r];
+ private:
+  // Append bytes or formatted values to the buffer.
+  void Append(const void *data, size_t size);
+  void AppendText(double value);
+  void AppendText(int value);
+  template <typename T>
+  void AppendBinary(const vector<T> &values);
+
+  // Write the buffer to the file if it holds at least min_size bytes.
+  bool Flush(size_t min_size);
+
+  ofstream file_;
+  int format_;
+  bool map_labels_;
+  uint64_t num_graphs_;
+  string buffer_;
+};
+
+// Size of the chunks written to the posteriors file.
+static const size_t kPosteriorsBufferSize = 1 << 20;
+
+// Label of each multi-variable of a graph: the state with the largest
+// posterior (the first one, in case of ties). Graphs without
+// multi-variables get a 0/1 label for each binary variable.
+void ComputeMAPLabels(FactorGraph *factor_graph,
+                      const vector<double> &posteriors,
+                      vector<int> *labels) {
+  int num_multi_variables = factor_graph->GetNumMultiVariables();
+  if (num_multi_variables == 0) {
+    labels->resize(posteriors.size());
+    for (int i = 0; i < posteriors.size(); ++i) {
+      (*labels)[i] = (posteriors[i] > 0.5)? 1 : 0;
+    }
+    return;
+  }
+  labels->resize(num_multi_variables);
+  for (int i = 0; i < num_multi_variables; ++i) {
+    MultiVariable *multi_variable = factor_graph->GetMultiVariable(i);
+    int best = 0;
+    for (int k = 1; k < multi_variable->GetNumStates(); ++k) {
+      if (posteriors[multi_variable->GetState(k)->GetId()] >
+          posteriors[multi_variable->GetState(best)->GetId()]) {
+        best = k;
       }
-      factor->SetAdditionalLogPotentials(additional_scores);
-      num_factor_log_potentials += additional_scores.size();
-      cout << "Read grandparent head automaton factor." << endl;
-    } else {
-      cout << "Unknown factor type: " << fields[0] << endl;
-      return -1;
     }
+    (*labels)[i] = best;
   }
+}
 
-  // Read blank line.
-  getline(file_graph, line);
-
-  cout << "Read " << num_variables << " variables and "
-       << num_factors << " factors." << endl;
+bool PosteriorsWriter::Open(const string &filename, int format,
+                            bool map_labels) {
+  format_ = format;
+  map_labels_ = map_labels;
+  num_graphs_ = 0;
+  buffer_.clear();
+  buffer_.reserve(2 * kPosteriorsBufferSize);
+  ios_base::openmode mode = ios_base::out;
+  if (format_ != POSTERIORS_TEXT) mode |= ios_base::binary;
+  file_.open(filename.c_str(), mode);
+  return file_.is_open();
+}
 
-  //ofstream file_out("test.fg", ios_base::out);
-  //factor_graph->Print(file_out);
-  //file_out.flush();
-  //file_out.clear();
-  //file_out.close();
+int PosteriorsWriter::Close() {
+  bool good = Flush(0);
+  file_.close();
+  return good? 0 : -1;
+}
 
-  //factor_graph->Initialize(variables, factors, num_messages);
+void PosteriorsWriter::Append(const void *data, size_t size) {
+  buffer_.append(static_cast<const char*>(data), size);
+}
 
-  return 0;
+void PosteriorsWriter::AppendText(double value) {
+  // Same as the default formatting of streams.
+  char text[32];
+  int length = snprintf(text, sizeof(text), "%g", value);
+  buffer_.append(text, length);
 }
 
-// This loads a graph in the format of PIC 2011.
-int LoadGraphUAI(ifstream &file_graph, 
-                 FactorGraph *factor_graph) {
-  string line = "";
-
-  // Read header.
-  while (line == "") {
-    getline(file_graph, line);
-    if (file_graph.eof()) return -1;
-    TrimComments("#", &line);
-    Trim("\t ", &line);
-  }
-  if (line != "MARKOV") {
-    cout << "Wrong header: " << line << endl;
-    return -1;
-  }
+void PosteriorsWriter::AppendText(int value) {
+  char text[16];
+  int length = snprintf(text, sizeof(text), "%d", value);
+  buffer_.append(text, length);
+}
 
-  int num_factor_log_potentials = 0;
+template <typename T>
+void PosteriorsWriter::AppendBinary(const vector<T> &values) {
+  static const char kPadding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  size_t size = values.size() * sizeof(T);
+  if (size > 0) Append(&values[0], size);
+  Append(kPadding, (8 - size % 8) % 8);
+}
 
-  // Read number of multi-variables.
-  getline(file_graph, line);
-  TrimComments("#", &line);
-  int num_multi_variables = atoi(line.c_str());
-  vector<MultiVariable*> multi_variables(num_multi_variables);
+bool PosteriorsWriter::Flush(size_t min_size) {
+  if (buffer_.size() < min_size) return true;
+  file_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+  return file_.good();
+}
 
-  // Read cardinality of each multi-variable.
-  getline(file_graph, line);
-  TrimComments("#", &line);
-  vector<string> fields;
-  StringSplit(line, "\t ", &fields);
-  assert(fields.size() == num_multi_variables);
-  for (int i = 0; i < num_multi_variables; ++i) {
-    int num_states = atoi(fields[i].c_str());
-    MultiVariable* multi_variable = 
-      factor_graph->CreateMultiVariable(num_states);
-    multi_variables[i] = multi_variable;
+int PosteriorsWriter::Write(GraphJob *job) {
+  const vector<double> &posteriors = job->posteriors;
+  const vector<double> &additional_posteriors = job->additional_posteriors;
+  vector<int> labels;
+  if (map_labels_) {
+    ComputeMAPLabels(&job->factor_graph, posteriors, &labels);
   }
 
-  // Read number of factors (includes unary factors).
-  getline(file_graph, line);
-  TrimComments("#", &line);
-  int num_factors = atoi(line.c_str());
-
-  // Read factors (just the structure).
-  vector<Factor*> factors(num_factors);
-  vector<MultiVariable*> unary_factors(num_factors);
-  for (int i = 0; i < num_factors; ++i) {
-    getline(file_graph, line);
-    TrimComments("#", &line);
-    fields.clear();
-    StringSplit(line, "\t ", &fields);
-
-    // Read linked multi-variables.
-    int num_links = atoi(fields[0].c_str());
-    int offset = 1;
-    assert(num_links == fields.size() - offset);
-    if (num_links == 1) { 
-      // Unary factor; in our formalism this is just a multi-variable.
-      int k = atoi(fields[offset].c_str());
-      unary_factors[i] = multi_variables[k];
+  if (format_ == POSTERIORS_TEXT) {
+    if (map_labels_) {
+      for (int i = 0; i < labels.size(); ++i) {
+        AppendText(labels[i]);
+        Append("\n", 1);
+      }
+      Append("\n", 1);
     } else {
-      vector<MultiVariable*> multi_variables_local(num_links);
-      for (int j = 0; j < num_links; ++j) {
-        int k = atoi(fields[offset + j].c_str());
-        multi_variables_local[j] = multi_variables[k];
+      for (int i = 0; i < posteriors.size(); ++i) {
+        AppendText(posteriors[i]);
+#ifdef LPSOLVER_CPLEX
+        Append("\t", 1);
+        AppendText(job->posteriors_cplex_relax[i]);
+        Append("\t", 1);
+        AppendText(job->posteriors_cplex_integer[i]);
+#endif
+        Append("\n", 1);
+        if (buffer_.size() >= kPosteriorsBufferSize) Flush(0);
+      }
+      Append("\n", 1);
+      for (int i = 0; i < additional_posteriors.size(); ++i) {
+        AppendText(additional_posteriors[i]);
+#ifdef LPSOLVER_CPLEX
+        Append("\t", 1);
+        AppendText(job->additional_posteriors_cplex_relax[i]);
+        Append("\t", 1);
+        AppendText(job->additional_posteriors_cplex_integer[i]);
+#endif
+        Append("\n", 1);
+        if (buffer_.size() >= kPosteriorsBufferSize) Flush(0);
+      }
+      Append("\n", 1);
+    }
+  } else {
+    BinaryPosteriorsHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kBinaryPosteriorsMagic, sizeof(header.magic));
+    header.version = kBinaryPosteriorsVersion;
+    header.graph = num_graphs_;
+    header.value = job->value;
+    if (map_labels_) {
+      header.value_type = POSTERIORS_VALUES_LABELS;
+      header.num_values = labels.size();
+      header.num_additional_values = 0;
+    } else {
+      header.value_type = (format_ == POSTERIORS_FLOAT32)?
+        POSTERIORS_VALUES_FLOAT32 : POSTERIORS_VALUES_FLOAT64;
+      header.num_values = posteriors.size();
+      header.num_additional_values = additional_posteriors.size();
+    }
+    Append(&header, sizeof(header));
+    if (map_labels_) {
+      vector<int32_t> values(labels.begin(), labels.end());
+      AppendBinary(values);
+    } else if (format_ == POSTERIORS_FLOAT32) {
+      vector<float> values(posteriors.begin(), posteriors.end());
+      AppendBinary(values);
+      values.assign(additional_posteriors.begin(),
+                    additional_posteriors.end());
+      AppendBinary(values);
+    } else {
+      AppendBinary(posteriors);
+      size_t size = additional_posteriors.size() * sizeof(double);
+      if (size < kPosteriorsBufferSize) {
+        AppendBinary(additional_posteriors);
+      } else {
+        // Large tables go straight to the file, without a copy.
+        if (!Flush(0)) return -1;
+        file_.write(reinterpret_cast<const char*>(&additional_posteriors[0]),
+                    size);
+        static const char kPadding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        Append(kPadding, (8 - size % 8) % 8);
       }
-      // For now, set an empty vector of additional log potentials.
-      vector<double> additional_log_potentials;
-      Factor *factor = 
-        factor_graph->CreateFactorDense(multi_variables_local,
-                                        additional_log_potentials);
-      factors[i] = factor;
     }
   }
+  ++num_graphs_;
+  return Flush(kPosteriorsBufferSize)? 0 : -1;
+}
 
-  // Read factors (the log-potentials).
-  // IMPORTANT: the scores in the UAI files are potentials (not log-potentials!)
-  for (int i = 0; i < num_factors; ++i) {
-    Factor *factor = factors[i];
-    line = "";
-    while (line == "") {
-      getline(file_graph, line);
-      TrimComments("#", &line);
-      Trim(" \t", &line);
+// Write the MAP assignment of a UAI model in the UAI result format: the
+// state of every multi-variable of the model, observed or not.
+void WriteUAIMAP(GraphJob *job, ofstream *file) {
+  vector<int> labels;
+  ComputeMAPLabels(&job->factor_graph, job->posteriors, &labels);
+  const vector<int> &evidence = job->evidence;
+  *file << "MAP" << endl;
+  *file << evidence.size();
+  int k = 0;
+  for (int i = 0; i < evidence.size(); ++i) {
+    if (evidence[i] >= 0) {
+      *file << " " << evidence[i];
+    } else {
+      *file << " " << labels[k];
+      ++k;
     }
-    int num_configurations = atoi(line.c_str());
-    if (factor == NULL) { 
-      // Unary factor; in our formalism this is just a multi-variable.
-      assert(unary_factors[i] != NULL);
-      MultiVariable *multi_variable = unary_factors[i];
-      int index = 0;
-      assert(num_configurations == multi_variable->GetNumStates());
-      while (index < num_configurations) {
-        getline(file_graph, line);
-        TrimComments("#", &line);
-        Trim(" \t", &line);
-        fields.clear();
-        StringSplit(line, "\t ", &fields);
-        for (int j = 0; j < fields.size(); ++j) {
-          double log_potential = LOG_STABLE(atof(fields[j].c_str()));
-          multi_variable->SetLogPotential(index, log_potential);
-          assert(index < num_configurations);
-          ++index;
-        }
+  }
+  *file << endl;
+}
+
+int RunAll(const string &format,
+           const string &filename_graph,
+           const string &algorithm,
+           int niters,
+           double eta,
+           bool adapt_eta,
+           double residual_threshold,
+           bool convert_to_binary,
+           bool exact,
+           int branching_strategy,
+           int stepsize_rule,
+           bool decompose_components,
+           int num_threads,
+           int num_graph_threads,
+           int qp_solver,
+           bool sparse_tables,
+           const string &filename_binary,
+           const string &filename_posteriors,
+           int posteriors_format,
+           bool map_labels,
+           const string &filename_evidence,
+           const string &filename_uai_map) {
+  int time_ddadmm = 0;
+  int time_cplex_relax = 0;
+  int time_cplex_integer = 0;
+  if (format != "ad3" && format != "uai" && format != "binary") {
+    cout << "Unknown format: " << format << endl;
+    return -1;
+  }
+  ExampleFactorGraphReader reader;
+  if (!reader.Open(filename_graph)) {
+    cout << "Error: Could not open " << filename_graph << " for reading." << endl;
+    return -1;
+  }
+  PosteriorsWriter file_posteriors;
+  if (!file_posteriors.Open(filename_posteriors, posteriors_format,
+                            map_labels)) {
+    cout << "Error: Could not open " << filename_posteriors << " for writing." << endl;
+    return -1;
+  }
+  FactorGraphWriter writer;
+  if (filename_binary != "" && !writer.Open(filename_binary)) {
+    cout << "Error: Could not open " << filename_binary << " for writing."
+         << endl;
+    return -1;
+  }
+  if (filename_evidence != "" &&
+      0 > reader.ReadEvidenceUAI(filename_evidence)) {
+    return -1;
+  }
+  ofstream file_uai_map;
+  if (filename_uai_map != "") {
+    file_uai_map.open(filename_uai_map.c_str(), ios_base::out);
+    if (!file_uai_map.is_open()) {
+      cout << "Error: Could not open " << filename_uai_map
+           << " for writing." << endl;
+      return -1;
+    }
+  }
+
+  GraphPipeline pipeline;
+  pipeline.format = format;
+  pipeline.convert_to_binary = convert_to_binary;
+  pipeline.sparse_tables = sparse_tables;
+  pipeline.algorithm = algorithm;
+  pipeline.niters = niters;
+  pipeline.eta = eta;
+  pipeline.adapt_eta = adapt_eta;
+  pipeline.residual_threshold = residual_threshold;
+  pipeline.exact = exact;
+  pipeline.branching_strategy = branching_strategy;
+  pipeline.stepsize_rule = stepsize_rule;
+  pipeline.decompose_components = decompose_components;
+  pipeline.num_threads = num_threads;
+  pipeline.qp_solver = qp_solver;
+  pipeline.uai_map = (filename_uai_map != "");
+  pipeline.reader = &reader;
+  pthread_mutex_init(&pipeline.mutex, NULL);
+  pthread_cond_init(&pipeline.changed, NULL);
+  pipeline.num_read = 0;
+  pipeline.num_in_flight = 0;
+  pipeline.max_in_flight = 4 * num_graph_threads;
+  pipeline.done_reading = false;
+  pipeline.stop = false;
+
+  timeval start, end;
+  gettimeofday(&start, NULL);
+  pthread_t reader_thread;
+  vector<pthread_t> worker_threads(num_graph_threads);
+  pthread_create(&reader_thread, NULL, RunGraphReader, &pipeline);
+  for (int k = 0; k < num_graph_threads; ++k) {
+    pthread_create(&worker_threads[k], NULL, RunGraphWorker, &pipeline);
+  }
+
+  // Write the results in the order of the input.
+  int status = 0;
+  pthread_mutex_lock(&pipeline.mutex);
+  for (int index = 0; ; ++index) {
+    while (pipeline.solved.find(index) == pipeline.solved.end() &&
+           !(pipeline.done_reading && index == pipeline.num_read)) {
+      pthread_cond_wait(&pipeline.changed, &pipeline.mutex);
+    }
+    if (pipeline.solved.find(index) == pipeline.solved.end()) break;
+    GraphJob *job = pipeline.solved[index];
+    pipeline.solved.erase(index);
+    pthread_mutex_unlock(&pipeline.mutex);
+
+    cout << job->log;
+    time_ddadmm += job->time;
+#ifdef LPSOLVER_CPLEX
+    time_cplex_relax += job->time_cplex_relax;
+    time_cplex_integer += job->time_cplex_integer;
+#endif
+    if (0 > file_posteriors.Write(job)) {
+      cout << "Error: Could not write the posteriors to "
+           << filename_posteriors << "." << endl;
+      status = -1;
+    }
+
+    if (filename_uai_map != "") {
+      WriteUAIMAP(job, &file_uai_map);
+      if (!file_uai_map.good()) {
+        cout << "Error: Could not write the MAP assignment to "
+             << filename_uai_map << "." << endl;
+        status = -1;
       }
-    } else {
-      int num_links = static_cast<FactorDense*>(factor)->
-        GetNumMultiVariables();
-      int index = 0;
-      assert(num_configurations == 
-             static_cast<FactorDense*>(factor)->GetNumConfigurations());
-
-      //int r = factor_graph->GetNumVariables() + num_factor_log_potentials;
-      num_factor_log_potentials += num_configurations;
-      //static_cast<FactorMultiDense*>(factor)->SetFirstGlobalIndex(r);
-      vector<double> additional_log_potentials(num_configurations);
-      while (index < num_configurations) {
-        getline(file_graph, line);
-        TrimComments("#", &line);
-        Trim(" \t", &line);
-        fields.clear();
-        StringSplit(line, "\t ", &fields);
-        for (int j = 0; j < fields.size(); ++j) {
-          double log_potential = LOG_STABLE(atof(fields[j].c_str()));
-          additional_log_potentials[index] = log_potential;
-          assert(index < num_configurations);
-          ++index;
-        }
+    }
+
+    if (filename_binary != "") {
+      // Save the graph, with the state of AD3 if it was run.
+      bool save_solver_state = (algorithm == "ad3" && !exact);
+      if (0 > writer.WriteGraphBinary(&job->factor_graph,
+                                      save_solver_state)) {
+        cout << "Error: Could not write the factor graph to "
+             << filename_binary << "." << endl;
+        status = -1;
       }
-      factor->SetAdditionalLogPotentials(additional_log_potentials);
     }
+    delete job;
+
+    pthread_mutex_lock(&pipeline.mutex);
+    --pipeline.num_in_flight;
+    if (status < 0) {
+      pipeline.stop = true;
+      pthread_cond_broadcast(&pipeline.changed);
+      break;
+    }
+    pthread_cond_broadcast(&pipeline.changed);
   }
+  pthread_mutex_unlock(&pipeline.mutex);
 
-  cout << "Read " << num_multi_variables << " multi-variables and "
-       << num_factors << " factors." << endl;
+  pthread_join(reader_thread, NULL);
+  for (int k = 0; k < num_graph_threads; ++k) {
+    pthread_join(worker_threads[k], NULL);
+  }
+  gettimeofday(&end, NULL);
+  // Graphs left after an error.
+  for (int k = 0; k < pipeline.pending.size(); ++k) {
+    delete pipeline.pending[k].second;
+  }
+  for (map<int, GraphJob*>::iterator it = pipeline.solved.begin();
+       it != pipeline.solved.end(); ++it) {
+    delete it->second;
+  }
+  pthread_cond_destroy(&pipeline.changed);
+  pthread_mutex_destroy(&pipeline.mutex);
+  reader.Close();
+  writer.Close();
+  if (filename_uai_map != "") file_uai_map.close();
+  if (0 > file_posteriors.Close() && status == 0) {
+    cout << "Error: Could not write the posteriors to "
+         << filename_posteriors << "." << endl;
+    status = -1;
+  }
+  if (status < 0) return status;
 
+#if LPSOLVER_CPLEX
+  cout << "Elapsed times: " << endl;
+  cout << "AD3 integer: " << static_cast<double>(time_ddadmm)/1000.0 
+       << " sec." << endl; 
+  cout << "CPLEX relax: " << static_cast<double>(time_cplex_relax)/1000.0 
+       << " sec." << endl; 
+  cout << "CPLEX integer: " << static_cast<double>(time_cplex_integer)/1000.0 
+       << " sec." << endl; 
+#else
+  cout << "Elapsed time: " << static_cast<double>(time_ddadmm)/1000.0 
+       << " sec." << endl; 
+#endif
+  if (num_graph_threads > 1) {
+    // The elapsed time is the sum over the graphs; with several graphs
+    // solved at once, the wall-clock time is shorter.
+    cout << "Wall-clock time: "
+         << static_cast<double>(diff_ms(end,start))/1000.0 << " sec." << endl;
+  }
   return 0;
 }
@@ -213,6 +213,14 @@ class FactorSequence : public GenericFactor {
     return true;
   }
 
+  // Hash a configuration.
+  bool HashConfiguration(const Configuration &configuration,
+                         unsigned int *hash) {
+    const vector<int> *sequence = static_cast<const vector<int>*>(configuration);
+    *hash = HashValues(*sequence, 0);
+    return true;
+  }
+
   // Delete configuration.
   void DeleteConfiguration(
     Configuration configuration) {
@@ -226,6 +234,12 @@ class FactorSequence : public GenericFactor {
     return static_cast<Configuration>(sequence);
   }
 
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *sequence =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*sequence));
+  }
+
  public:
   // num_states contains the number of states at each position
   // in the sequence. The start and stop positions are not considered here.
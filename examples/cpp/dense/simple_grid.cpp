@@ -83,6 +83,9 @@ int main(int argc, char **argv) {
       ++t;
     }
   }
+  // All the edges share the same table.
+  AD3::SharedLogPotentials *edge_log_potentials =
+    factor_graph.CreateSharedLogPotentials(additional_log_potentials);
 
   // Create a factor for each edge in the grid.
   for (int i = 0; i < grid_size; ++i) {
@@ -94,7 +97,7 @@ int main(int argc, char **argv) {
         multi_variables_local[0] = multi_variables[i][j-1];
         multi_variables_local[1] = multi_variables[i][j];
         factor_graph.CreateFactorDense(multi_variables_local,
-                                       additional_log_potentials);
+                                       edge_log_potentials);
       }
 
       // Vertical edge.
@@ -102,7 +105,7 @@ int main(int argc, char **argv) {
         multi_variables_local[0] = multi_variables[i-1][j];
         multi_variables_local[1] = multi_variables[i][j];
         factor_graph.CreateFactorDense(multi_variables_local,
-                                       additional_log_potentials);
+                                       edge_log_potentials);
       }
     }
   }
@@ -218,6 +218,14 @@ class FactorGrandparentHeadAutomaton : public GenericFactor {
     return true;    
   }
 
+  // Hash a configuration.
+  bool HashConfiguration(const Configuration &configuration,
+                         unsigned int *hash) {
+    const vector<int> *values = static_cast<const vector<int>*>(configuration);
+    *hash = HashValues(*values, 0);
+    return true;
+  }
+
   // Delete configuration.
   void DeleteConfiguration(
     Configuration configuration) {
@@ -232,6 +240,15 @@ class FactorGrandparentHeadAutomaton : public GenericFactor {
     return static_cast<Configuration>(grandparent_modifiers); 
   }
 
+  // Maximize appends the grandparent and the modifiers to the configuration.
+  bool MaximizeOverwritesConfiguration() { return false; }
+
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *grandparent_modifiers =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*grandparent_modifiers));
+  }
+
  public:
   // length is relative to the head position. 
   // E.g. for a right automaton with h=3 and instance_length=10,
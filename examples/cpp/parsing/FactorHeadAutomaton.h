@@ -179,6 +179,14 @@ class FactorHeadAutomaton : public GenericFactor {
     return true;    
   }
 
+  // Hash a configuration.
+  bool HashConfiguration(const Configuration &configuration,
+                         unsigned int *hash) {
+    const vector<int> *values = static_cast<const vector<int>*>(configuration);
+    *hash = HashValues(*values, 0);
+    return true;
+  }
+
   // Delete configuration.
   void DeleteConfiguration(
     Configuration configuration) {
@@ -191,6 +199,15 @@ class FactorHeadAutomaton : public GenericFactor {
     return static_cast<Configuration>(modifiers); 
   }
 
+  // Maximize appends the modifiers to the configuration.
+  bool MaximizeOverwritesConfiguration() { return false; }
+
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *modifiers =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*modifiers));
+  }
+
  public:
   // length is relative to the head position. 
   // E.g. for a right automaton with h=3 and instance_length=10,
@@ -65,6 +65,8 @@ int FactorTree::RunCLE(const vector<double>& scores,
     assert(r >= 0);
     *value += scores[r];
   }
+
+  return 0;
 }
 
 void FactorTree::RunChuLiuEdmondsIteration(vector<bool> *disabled,
@@ -113,6 +113,14 @@ class FactorTree : public GenericFactor {
     return true;
   }
 
+  // Hash a configuration (the root, at position 0, is not compared).
+  bool HashConfiguration(const Configuration &configuration,
+                         unsigned int *hash) {
+    const vector<int> *heads = static_cast<const vector<int>*>(configuration);
+    *hash = HashValues(*heads, 1);
+    return true;
+  }
+
   // Delete configuration.
   void DeleteConfiguration(
     Configuration configuration) {
@@ -126,6 +134,12 @@ class FactorTree : public GenericFactor {
     return static_cast<Configuration>(heads);
   }
 
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *heads =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*heads));
+  }
+
  public:
   void Initialize(int length, const vector<Arc*> &arcs) {
     length_ = length;
@@ -188,6 +188,15 @@ class FactorBinaryTree : public FactorGeneralTree {
     return static_cast<Configuration>(selected_nodes);
   }
 
+  // Maximize appends the selected nodes to the configuration.
+  bool MaximizeOverwritesConfiguration() { return false; }
+
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *selected_nodes =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*selected_nodes));
+  }
+
  public:
   // parents contains the parent index of each node.
   // The root must be at position 0, and its parent is -1.
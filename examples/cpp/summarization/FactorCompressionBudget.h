@@ -339,6 +339,15 @@ class FactorCompressionBudget : public GenericFactor {
     return static_cast<Configuration>(selected_nodes);
   }
 
+  // Maximize appends the selected nodes to the configuration.
+  bool MaximizeOverwritesConfiguration() { return false; }
+
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *selected_nodes =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*selected_nodes));
+  }
+
  public:
   // num_states contains the number of states at each position
   // in the sequence. 
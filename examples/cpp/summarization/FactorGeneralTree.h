@@ -311,6 +311,12 @@ class FactorGeneralTree : public GenericFactor {
     return static_cast<Configuration>(sequence); 
   }
 
+  virtual Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *sequence =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*sequence));
+  }
+
  public:
   // parents contains the parent index of each node.
   // The root must be at position 0, and its parent is -1.
@@ -120,6 +120,8 @@ class FactorSequenceBudget : public GenericFactor {
           int best = -1;
           for (int l = 0; l < num_states_[i]; ++l) {
             if (l == 0 && b == 0) continue;
+            // Bins past the end cannot be reached at position i.
+            if (b >= values[i][l].size()) continue;
             if (i > 0 && path[i][l][b] < 0) continue;
             double val = values[i][l][b] + 
               GetEdgeScore(i+1, l, k, variable_log_potentials,
@@ -148,6 +150,7 @@ class FactorSequenceBudget : public GenericFactor {
     for (int b = 0; b < num_bins; ++b) {
       for (int l = 0; l < num_states_[length - 1]; ++l) {
         if (l == 0 && b == 0) continue;
+        if (b >= values[length-1][l].size()) continue;
         if (length > 1 && path[length-1][l][b] < 0) continue;
         double val = values[length-1][l][b] + 
           GetEdgeScore(length, l, 0, variable_log_potentials,
@@ -266,6 +269,12 @@ class FactorSequenceBudget : public GenericFactor {
     return static_cast<Configuration>(sequence); 
   }
 
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *sequence =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*sequence));
+  }
+
  public:
   // num_states contains the number of states at each position
   // in the sequence. The start and stop positions are not considered here.
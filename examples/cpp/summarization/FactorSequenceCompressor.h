@@ -219,6 +219,15 @@ class FactorSequenceCompressor : public GenericFactor {
     return static_cast<Configuration>(modifiers);
   }
 
+  // Maximize appends the modifiers to the configuration.
+  bool MaximizeOverwritesConfiguration() { return false; }
+
+  Configuration CopyConfiguration(const Configuration &configuration) {
+    const vector<int> *modifiers =
+      static_cast<const vector<int>*>(configuration);
+    return static_cast<Configuration>(new vector<int>(*modifiers));
+  }
+
  public:
   // length is relative to the head position.
   // E.g. for a right automaton with h=3 and instance_length=10,
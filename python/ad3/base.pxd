@@ -1,5 +1,6 @@
 from libcpp.vector cimport vector
 from libcpp cimport bool
+from libcpp.string cimport string
 
 
 # get the classes from the c++ headers
@@ -12,6 +13,9 @@ cdef extern from "../ad3/Factor.h" namespace "AD3":
         int GetId()
         int Degree()
 
+    cdef cppclass SharedLogPotentials:
+        vector[double] GetValues()
+
     cdef cppclass Factor:
         Factor()
         vector[double] GetAdditionalLogPotentials()
@@ -40,6 +44,7 @@ cdef extern from "../ad3/GenericFactor.h" namespace "AD3":
         void GetCorrespondence(vector[double]*, vector[double]*)
         void SetQPMaxIter(int)
         void SetClearCache(bool)
+        void SetQPSolver(int)
 
 
 cdef extern from "../ad3/MultiVariable.h" namespace "AD3":
@@ -56,9 +61,15 @@ cdef extern from "../ad3/FactorGraph.h" namespace "AD3":
         void SetVerbosity(int verbosity)
         void SetEtaPSDD(double eta)
         void SetMaxIterationsPSDD(int max_iterations)
+        void SetStepsizeRulePSDD(int rule)
         int SolveLPMAPWithPSDD(vector[double]* posteriors,
                                vector[double]* additional_posteriors,
                                double* value)
+        void SetMaxIterationsMPLP(int max_iterations)
+        void SetDualThresholdMPLP(double threshold)
+        int SolveLPMAPWithMPLP(vector[double]* posteriors,
+                               vector[double]* additional_posteriors,
+                               double* value)
         void SetEtaAD3(double eta)
         void AdaptEtaAD3(bool adapt)
         void SetMaxIterationsAD3(int max_iterations)
@@ -75,11 +86,30 @@ cdef extern from "../ad3/FactorGraph.h" namespace "AD3":
         vector[double] GetLocalPrimalVariables()
         vector[double] GetGlobalPrimalVariables()
 
+        void ReserveVariables(int num_variables)
+        void ReserveMultiVariables(int num_multi_variables)
+        void ReserveFactors(int num_factors)
+        int GetNumVariables()
+        int GetNumMultiVariables()
+        int GetNumFactors()
+        BinaryVariable *GetBinaryVariable(int i)
+        MultiVariable *GetMultiVariable(int i)
+
         BinaryVariable *CreateBinaryVariable()
         MultiVariable *CreateMultiVariable(int num_states)
         Factor *CreateFactorDense(vector[MultiVariable*] multi_variables,
                                   vector[double] additional_log_potentials,
                                   bool owned_by_graph)
+        Factor *CreateFactorDense(
+            vector[MultiVariable*] multi_variables,
+            SharedLogPotentials *additional_log_potentials,
+            bool owned_by_graph)
+        SharedLogPotentials *CreateSharedLogPotentials(
+            vector[double] additional_log_potentials)
+        Factor *CreateFactorSparse(vector[MultiVariable*] multi_variables,
+                                   vector[int] configurations,
+                                   vector[double] additional_log_potentials,
+                                   bool owned_by_graph)
         Factor *CreateFactorXOR(vector[BinaryVariable*] variables,
                                 vector[bool] negated,
                                 bool owned_by_graph)
@@ -118,6 +148,24 @@ cdef extern from "../ad3/FactorGraph.h" namespace "AD3":
                            bool owned_by_graph)
 
 
+cdef extern from "../ad3/FactorGraphReader.h" namespace "AD3":
+    cdef cppclass FactorGraphReader:
+        FactorGraphReader()
+        bool Open(string filename)
+        void Close()
+        int ReadGraph(FactorGraph *factor_graph)
+        int ReadGraphUAI(FactorGraph *factor_graph, bool sparse_tables)
+        int ReadGraphBinary(FactorGraph *factor_graph, bool load_solver_state)
+
+
+cdef extern from "../ad3/FactorGraphWriter.h" namespace "AD3":
+    cdef cppclass FactorGraphWriter:
+        FactorGraphWriter()
+        bool Open(string filename)
+        void Close()
+        int WriteGraphBinary(FactorGraph *factor_graph, bool save_solver_state)
+
+
 # and the fundamental extension types
 
 cdef class PBinaryVariable:
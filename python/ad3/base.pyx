@@ -134,7 +134,8 @@ cdef class PFactor:
 
 
 cdef class PGenericFactor(PFactor):
-    """Factor which uses the active set algorithm to solve its QP."""
+    """Factor which uses the active set algorithm (by default) to solve its
+    QP."""
 
     cdef _cast_configuration(self, Configuration cfg):
         """Cast a configuration to a python object.
@@ -143,3 +144,11 @@ cdef class PGenericFactor(PFactor):
         This can be overridden in custom factors."""
 
         return (<vector[int]*> cfg)[0]
+
+    def set_qp_solver(self, solver):
+        """Set the algorithm for the QP of this factor: 'active_set'
+        (default) or 'frank_wolfe'."""
+        solvers = {'active_set': 0, 'frank_wolfe': 1}
+        if solver not in solvers:
+            raise ValueError("Unknown QP solver: {}".format(solver))
+        (<GenericFactor*> self.thisptr).SetQPSolver(solvers[solver])
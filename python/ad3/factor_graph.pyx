@@ -6,10 +6,15 @@ from cpython cimport Py_INCREF
 from cython.view cimport array as cvarray
 from cython.view cimport array_cwrapper
 
+import numpy as np
+
 from base cimport Factor
+from base cimport SharedLogPotentials
 from base cimport BinaryVariable
 from base cimport MultiVariable
 from base cimport FactorGraph
+from base cimport FactorGraphReader
+from base cimport FactorGraphWriter
 from base cimport PBinaryVariable, PMultiVariable, PFactor
 
 
@@ -49,6 +54,40 @@ cdef int _validate_negated(list p_negated, vector[bool]& negated,
     return 0
 
 
+cdef int _validate_indices(const Py_ssize_t[:, :] indices,
+                           Py_ssize_t n) except -1:
+    cdef Py_ssize_t i, k
+    for i in range(indices.shape[0]):
+        for k in range(indices.shape[1]):
+            if not 0 <= indices[i, k] < n:
+                raise ValueError("Variable index out of range.")
+    return 0
+
+
+_LOGIC_FACTOR_TYPES = {'XOR': 0, 'XOROUT': 1, 'ATMOSTONE': 2, 'OR': 3,
+                       'OROUT': 4, 'ANDOUT': 5, 'IMPLY': 6}
+
+
+cdef Factor* _create_factor_logic(FactorGraph *graph, int factor_type,
+                                  vector[BinaryVariable*]& variables,
+                                  vector[bool]& negated,
+                                  bool owned_by_graph):
+    if factor_type == 0:
+        return graph.CreateFactorXOR(variables, negated, owned_by_graph)
+    elif factor_type == 1:
+        return graph.CreateFactorXOROUT(variables, negated, owned_by_graph)
+    elif factor_type == 2:
+        return graph.CreateFactorAtMostOne(variables, negated, owned_by_graph)
+    elif factor_type == 3:
+        return graph.CreateFactorOR(variables, negated, owned_by_graph)
+    elif factor_type == 4:
+        return graph.CreateFactorOROUT(variables, negated, owned_by_graph)
+    elif factor_type == 5:
+        return graph.CreateFactorANDOUT(variables, negated, owned_by_graph)
+    else:
+        return graph.CreateFactorIMPLY(variables, negated, owned_by_graph)
+
+
 cdef class PFactorGraph:
     """Factor graph instance.
 
@@ -144,27 +183,14 @@ cdef class PFactorGraph:
         _binary_vars_to_vector(p_variables, variables)
         _validate_negated(negated, negated_, variables.size())
 
-        cdef Factor* f
-
-        if factor_type == 'XOR':
-            f = self.thisptr.CreateFactorXOR(variables, negated_, owned_by_graph)
-        elif factor_type == 'XOROUT':
-            f = self.thisptr.CreateFactorXOROUT(variables, negated_, owned_by_graph)
-        elif factor_type == 'ATMOSTONE':
-            f = self.thisptr.CreateFactorAtMostOne(variables, negated_,
-                                               owned_by_graph)
-        elif factor_type == 'OR':
-            f = self.thisptr.CreateFactorOR(variables, negated_, owned_by_graph)
-        elif factor_type == 'OROUT':
-            f = self.thisptr.CreateFactorOROUT(variables, negated_, owned_by_graph)
-        elif factor_type == 'ANDOUT':
-            f = self.thisptr.CreateFactorANDOUT(variables, negated_, owned_by_graph)
-        elif factor_type == 'IMPLY':
-            f = self.thisptr.CreateFactorIMPLY(variables, negated_, owned_by_graph)
-        else:
+        if factor_type not in _LOGIC_FACTOR_TYPES:
             raise NotImplementedError(
                 'Unknown factor type: {}'.format(factor_type))
 
+        cdef Factor* f = _create_factor_logic(
+            self.thisptr, _LOGIC_FACTOR_TYPES[factor_type], variables,
+            negated_, owned_by_graph)
+
         cdef PFactor pf = PFactor(allocate=False)
         pf.thisptr = f
         return pf
@@ -306,6 +332,297 @@ cdef class PFactorGraph:
                                        additional_log_potentials,
                                        owned_by_graph)
 
+    def create_factor_sparse(self, list p_multi_variables,
+                             list configurations,
+                             vector[double] additional_log_potentials,
+                             bool owned_by_graph=True):
+        """Creates and binds a sparse factor to several multi-variables.
+
+        Only the listed joint configurations are allowed; all the others
+        are impossible. Useful when most of the table of a dense factor
+        would be ``-inf``.
+
+        p_multi_variables : list of PMultiVariable objects,
+            The bound multi-valued variables that the factor applies to.
+
+        configurations : list of tuples of ints,
+            The allowed joint configurations; each one has one state per
+            variable in ``p_multi_variables``.
+
+        additional_log_potentials : list of doubles,
+            Log-potentials for each allowed configuration, in the same order.
+
+        owned_by_graph : bool, default: True
+            If False, the factor does not get deleted when the factor graph
+            gets garbage collected.
+        """
+        cdef vector[MultiVariable*] multi_variables
+        _multi_vars_to_vector(p_multi_variables, multi_variables)
+
+        if not configurations:
+            raise ValueError("At least one configuration must be allowed.")
+
+        cdef vector[int] states
+        cdef int n_states
+        for configuration in configurations:
+            if len(configuration) != multi_variables.size():
+                raise ValueError("Each configuration must have one state per "
+                                 "variable.")
+            for k, state in enumerate(configuration):
+                n_states = multi_variables[k].GetNumStates()
+                if not 0 <= state < n_states:
+                    raise ValueError("State out of range.")
+                states.push_back(state)
+
+        if additional_log_potentials.size() != len(configurations):
+            raise ValueError("Must provide one log-potential per allowed "
+                             "configuration.")
+
+        self.thisptr.CreateFactorSparse(multi_variables,
+                                        states,
+                                        additional_log_potentials,
+                                        owned_by_graph)
+
+    def create_binary_variables(self, log_potentials):
+        """Creates a binary variable for each log-potential.
+
+        Parameters
+        ----------
+
+        log_potentials : array, shape (n_variables,)
+            The log-potential of each variable.
+
+        Returns
+        -------
+
+        first : int
+            The index of the first created variable. The variables get the
+            consecutive indices ``first, ..., first + n_variables - 1``, used
+            by ``create_factors_pair`` and ``create_factors_logic``, and their
+            posteriors are in that order.
+        """
+        cdef const double[:] log_potentials_ = np.asarray(log_potentials,
+                                                          dtype=np.double)
+        cdef Py_ssize_t n = log_potentials_.shape[0]
+        cdef int first = self.thisptr.GetNumVariables()
+        cdef Py_ssize_t i
+
+        self.thisptr.ReserveVariables(first + n)
+        for i in range(n):
+            self.thisptr.CreateBinaryVariable().SetLogPotential(
+                log_potentials_[i])
+        return first
+
+    def create_multi_variables(self, unaries):
+        """Creates a multi-valued variable for each row of unary potentials.
+
+        Parameters
+        ----------
+
+        unaries : array, shape (n_variables, n_states)
+            The log-potential of each state of each variable.
+
+        Returns
+        -------
+
+        first : int
+            The index of the first created multi-variable. The variables get
+            the consecutive indices ``first, ..., first + n_variables - 1``,
+            used by ``create_factors_dense``, and their states are created
+            (and their posteriors returned) in that order.
+        """
+        cdef const double[:, :] unaries_ = np.asarray(unaries,
+                                                      dtype=np.double)
+        cdef Py_ssize_t n = unaries_.shape[0]
+        cdef Py_ssize_t n_states = unaries_.shape[1]
+        cdef int first = self.thisptr.GetNumMultiVariables()
+        cdef MultiVariable *mv
+        cdef Py_ssize_t i, k
+
+        if n_states < 1:
+            raise ValueError("Multi-variables must have at least one state.")
+
+        self.thisptr.ReserveMultiVariables(first + n)
+        self.thisptr.ReserveVariables(self.thisptr.GetNumVariables() +
+                                      n * n_states)
+        for i in range(n):
+            mv = self.thisptr.CreateMultiVariable(n_states)
+            for k in range(n_states):
+                mv.SetLogPotential(k, unaries_[i, k])
+        return first
+
+    def create_factors_dense(self, edges, additional_log_potentials):
+        """Creates and binds a dense factor to each row of multi-variables.
+
+        Parameters
+        ----------
+
+        edges : array of ints, shape (n_factors, n_bound)
+            The indices (as returned by ``create_multi_variables``) of the
+            multi-variables bound to each factor; usually two per factor.
+            The variables in a given column must have the same number of
+            states.
+
+        additional_log_potentials : array
+            Either one table per factor, of shape ``(n_factors, n_states_1,
+            ..., n_states_n_bound)``, or a single table of shape
+            ``(n_states_1, ..., n_states_n_bound)``, shared by all the
+            factors (and stored once).
+
+        Notes
+        -----
+
+        The factors are owned by the graph. They are declared in the order of
+        ``edges``, which is also the order of their additional posteriors.
+        """
+        cdef const Py_ssize_t[:, :] edges_ = np.asarray(edges, dtype=np.intp)
+        cdef Py_ssize_t n_factors = edges_.shape[0]
+        cdef Py_ssize_t n_bound = edges_.shape[1]
+        if n_bound < 1:
+            raise ValueError("Dense factors require at least one variable.")
+        _validate_indices(edges_, self.thisptr.GetNumMultiVariables())
+
+        tables = np.asarray(additional_log_potentials, dtype=np.double)
+        cdef bool shared = tables.ndim == n_bound
+        if not shared and tables.ndim != n_bound + 1:
+            raise ValueError("Expected one table per factor, or a single "
+                             "shared table.")
+        if not shared and tables.shape[0] != n_factors:
+            raise ValueError("Must provide one table per factor.")
+        shape = tables.shape if shared else tables.shape[1:]
+
+        cdef Py_ssize_t i, k
+        for i in range(n_factors):
+            for k in range(n_bound):
+                if (self.thisptr.GetMultiVariable(edges_[i, k]).GetNumStates()
+                        != shape[k]):
+                    raise ValueError("The shape of the tables does not match "
+                                     "the number of states of the variables.")
+
+        cdef Py_ssize_t n_configurations = int(np.prod(shape))
+        cdef const double[:, :] tables_ = tables.reshape(
+            (1 if shared else n_factors, n_configurations))
+        cdef vector[double] values
+        values.resize(n_configurations)
+        cdef SharedLogPotentials *shared_values = NULL
+        if shared:
+            for k in range(n_configurations):
+                values[k] = tables_[0, k]
+            shared_values = self.thisptr.CreateSharedLogPotentials(values)
+
+        cdef vector[MultiVariable*] multi_variables
+        multi_variables.resize(n_bound)
+        self.thisptr.ReserveFactors(self.thisptr.GetNumFactors() + n_factors)
+        for i in range(n_factors):
+            for k in range(n_bound):
+                multi_variables[k] = self.thisptr.GetMultiVariable(
+                    edges_[i, k])
+            if shared:
+                self.thisptr.CreateFactorDense(multi_variables, shared_values,
+                                               True)
+            else:
+                for k in range(n_configurations):
+                    values[k] = tables_[i, k]
+                self.thisptr.CreateFactorDense(multi_variables, values, True)
+
+    def create_factors_pair(self, edges, edge_log_potentials):
+        """Creates a pair factor between each pair of binary variables.
+
+        Parameters
+        ----------
+
+        edges : array of ints, shape (n_factors, 2)
+            The indices (as returned by ``create_binary_variables``) of the
+            two binary variables bound to each factor.
+
+        edge_log_potentials : float or array, shape (n_factors,)
+            The score for both variables of each factor being turned on
+            simultaneously (see ``create_factor_pair``).
+
+        Notes
+        -----
+
+        The factors are owned by the graph, and declared in the order of
+        ``edges``.
+        """
+        cdef const Py_ssize_t[:, :] edges_ = np.asarray(edges, dtype=np.intp)
+        cdef Py_ssize_t n_factors = edges_.shape[0]
+        if edges_.shape[1] != 2:
+            raise ValueError("Pair factors require exactly two binary "
+                             "variables.")
+        _validate_indices(edges_, self.thisptr.GetNumVariables())
+        cdef const double[:] potentials_ = np.broadcast_to(
+            np.asarray(edge_log_potentials, dtype=np.double), (n_factors,))
+
+        cdef vector[BinaryVariable*] variables
+        variables.resize(2)
+        cdef Py_ssize_t i
+        self.thisptr.ReserveFactors(self.thisptr.GetNumFactors() + n_factors)
+        for i in range(n_factors):
+            variables[0] = self.thisptr.GetBinaryVariable(edges_[i, 0])
+            variables[1] = self.thisptr.GetBinaryVariable(edges_[i, 1])
+            self.thisptr.CreateFactorPAIR(variables, potentials_[i], True)
+
+    def create_factors_logic(self, str factor_type, variables, negated=None):
+        """Creates a logic factor of the same type for each row of variables.
+
+        Parameters
+        ----------
+
+        factor_type : string
+            The type of the factors (see ``create_factor_logic``).
+
+        variables : array of ints, shape (n_factors, degree)
+            The indices (as returned by ``create_binary_variables``) of the
+            binary variables bound to each factor. For some factors the order
+            is meaningful.
+
+        negated : array of bool, shape (n_factors, degree), optional
+            Whether the output of each variable should be flipped before
+            applying the factor. By default no variables are flipped.
+
+        Notes
+        -----
+
+        The factors are owned by the graph, and declared in the order of
+        ``variables``.
+        """
+        if factor_type not in _LOGIC_FACTOR_TYPES:
+            raise NotImplementedError(
+                'Unknown factor type: {}'.format(factor_type))
+        cdef int factor_type_ = _LOGIC_FACTOR_TYPES[factor_type]
+
+        cdef const Py_ssize_t[:, :] variables_ = np.asarray(variables,
+                                                            dtype=np.intp)
+        cdef Py_ssize_t n_factors = variables_.shape[0]
+        cdef Py_ssize_t degree = variables_.shape[1]
+        _validate_indices(variables_, self.thisptr.GetNumVariables())
+
+        cdef const unsigned char[:, :] negated_flags
+        cdef bool has_negated = negated is not None
+        if has_negated:
+            negated = np.asarray(negated, dtype=np.bool_)
+            if negated.shape != (n_factors, degree):
+                raise ValueError("Expected one negated flag per variable, "
+                                 "or none at all.")
+            negated_flags = negated.view(np.uint8)
+
+        cdef vector[BinaryVariable*] factor_variables
+        cdef vector[bool] negated_
+        factor_variables.resize(degree)
+        if has_negated:
+            negated_.resize(degree)
+        cdef Py_ssize_t i, k
+        self.thisptr.ReserveFactors(self.thisptr.GetNumFactors() + n_factors)
+        for i in range(n_factors):
+            for k in range(degree):
+                factor_variables[k] = self.thisptr.GetBinaryVariable(
+                    variables_[i, k])
+                if has_negated:
+                    negated_[k] = negated_flags[i, k]
+            _create_factor_logic(self.thisptr, factor_type_,
+                                 factor_variables, negated_, True)
+
     def declare_factor(self, PFactor p_factor not None,
                        list p_variables, bool owned_by_graph=False):
         """Bind a separately-created factor to variables in the graph.
@@ -334,6 +651,69 @@ cdef class PFactorGraph:
 
         self.thisptr.DeclareFactor(factor, variables, owned_by_graph)
 
+    def read(self, filename, format='ad3', sparse_tables=False):
+        """Read the variables and factors of a graph from a file.
+
+        Parameters
+        ----------
+
+        filename : str
+            Path of the file.
+
+        format : str, default: 'ad3'
+            Format of the file: 'ad3' (.fg files, with binary variables and
+            the built-in factor types), 'uai' (multi-variables and dense
+            factors) or 'binary' (written by `write`). If a graph in the
+            binary format was saved with the state of AD3, the next call to
+            `solve_lp_map_ad3` (or `solve`) starts from it.
+
+        sparse_tables : bool, default: False
+            For the UAI format, create factors whose tables have at least
+            half of the entries equal to zero as sparse factors.
+        """
+        if format not in ('ad3', 'uai', 'binary'):
+            raise ValueError("Unknown format: {}".format(format))
+        cdef FactorGraphReader reader
+        if not reader.Open(filename.encode('utf8')):
+            raise IOError("Could not open file: {}".format(filename))
+        cdef int status
+        if format == 'uai':
+            status = reader.ReadGraphUAI(self.thisptr, sparse_tables)
+        elif format == 'binary':
+            status = reader.ReadGraphBinary(self.thisptr, True)
+        else:
+            status = reader.ReadGraph(self.thisptr)
+        reader.Close()
+        if status < 0:
+            raise ValueError("Could not read a factor graph from file: "
+                             "{}".format(filename))
+
+    def write(self, filename, solver_state=False):
+        """Write the graph to a file in the binary format.
+
+        Only the built-in factor types (logic, budget, knapsack, pair, dense
+        and sparse) can be written. The graph is read back with
+        `read(filename, format='binary')`.
+
+        Parameters
+        ----------
+
+        filename : str
+            Path of the file.
+
+        solver_state : bool, default: False
+            Also write the dual and primal variables and eta from the last
+            run of AD3, if any.
+        """
+        cdef FactorGraphWriter writer
+        if not writer.Open(filename.encode('utf8')):
+            raise IOError("Could not open file: {}".format(filename))
+        cdef int status = writer.WriteGraphBinary(self.thisptr, solver_state)
+        writer.Close()
+        if status < 0:
+            raise ValueError("Could not write the factor graph to file: "
+                             "{}".format(filename))
+
     def fix_multi_variables_without_factors(self):
         """Add one-of-K constraint to unbound multi-variables.
 
@@ -349,6 +729,14 @@ cdef class PFactorGraph:
     def set_max_iterations_psdd(self, int max_iterations):
         self.thisptr.SetMaxIterationsPSDD(max_iterations)
 
+    def set_stepsize_rule_psdd(self, rule):
+        """Set the stepsize rule of PSDD: 'sqrt' (default), 'adaptive'
+        or 'polyak'."""
+        rules = {'sqrt': 0, 'adaptive': 1, 'polyak': 2}
+        if rule not in rules:
+            raise ValueError("Unknown stepsize rule: {}".format(rule))
+        self.thisptr.SetStepsizeRulePSDD(rules[rule])
+
     def solve_lp_map_psdd(self):
         cdef vector[double] posteriors
         cdef vector[double] additional_posteriors
@@ -358,6 +746,22 @@ cdef class PFactorGraph:
 
         return value, posteriors, additional_posteriors
 
+    def set_max_iterations_mplp(self, int max_iterations):
+        self.thisptr.SetMaxIterationsMPLP(max_iterations)
+
+    def set_dual_threshold_mplp(self, double threshold):
+        self.thisptr.SetDualThresholdMPLP(threshold)
+
+    def solve_lp_map_mplp(self):
+        cdef vector[double] posteriors
+        cdef vector[double] additional_posteriors
+        cdef double value
+        cdef int solver_status
+        solver_status = self.thisptr.SolveLPMAPWithMPLP(&posteriors,
+                                                        &additional_posteriors,
+                                                        &value)
+        return value, posteriors, additional_posteriors, solver_status
+
     def set_eta_ad3(self, double eta):
         self.thisptr.SetEtaAD3(eta)
 
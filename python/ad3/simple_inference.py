@@ -1,4 +1,3 @@
-import itertools
 import numpy as np
 
 from . import factor_graph as fg
@@ -8,26 +7,20 @@ def simple_grid(unaries, pairwise, verbose=1):
     height, width, n_states = unaries.shape
 
     graph = fg.PFactorGraph()
-
-    multi_variables = []
-    for i in range(height):
-        multi_variables.append([])
-        for j in range(width):
-            new_variable = graph.create_multi_variable(n_states)
-            for state in range(n_states):
-                new_variable.set_log_potential(state, unaries[i, j, state])
-            multi_variables[i].append(new_variable)
-
-    for i, j in itertools.product(range(height), range(width)):
-        if j > 0:
-            # horizontal edge
-            edge_variables = [multi_variables[i][j - 1], multi_variables[i][j]]
-            graph.create_factor_dense(edge_variables, pairwise.ravel())
-
-        if i > 0:
-            # vertical edge
-            edge_variables = [multi_variables[i - 1][j], multi_variables[i][j]]
-            graph.create_factor_dense(edge_variables, pairwise.ravel())
+    graph.create_multi_variables(unaries.reshape(-1, n_states))
+
+    # for each node in turn, the edge with its left neighbour (horizontal)
+    # and with its upper neighbour (vertical), if any
+    index = np.arange(height * width).reshape(height, width)
+    edges = np.stack([
+        np.stack([np.roll(index, 1, axis=1), index], axis=-1),
+        np.stack([np.roll(index, 1, axis=0), index], axis=-1)], axis=2)
+    has_edge = np.stack(np.broadcast_arrays(np.arange(width) > 0,
+                                            np.arange(height)[:, None] > 0),
+                        axis=-1)
+    # all the edges share the same table
+    graph.create_factors_dense(edges[has_edge],
+                               pairwise.reshape(n_states, n_states))
 
     value, marginals, edge_marginals, status = graph.solve(verbose=verbose)
     marginals = np.array(marginals).reshape(unaries.shape)
@@ -119,17 +112,8 @@ def _general_graph(unaries, edges, edge_weights, verbose=1, n_iterations=1000,
     factor_graph = fg.PFactorGraph()
     n_states = unaries.shape[-1]
 
-    multi_variables = []
-    for u in unaries:
-        new_variable = factor_graph.create_multi_variable(n_states)
-        for state, cost in enumerate(u):
-            new_variable.set_log_potential(state, cost)
-        multi_variables.append(new_variable)
-
-    for i, e in enumerate(edges):
-            edge_variables = [multi_variables[e[0]], multi_variables[e[1]]]
-            factor_graph.create_factor_dense(edge_variables,
-                                             edge_weights[i].ravel())
+    factor_graph.create_multi_variables(unaries)
+    factor_graph.create_factors_dense(edges, edge_weights)
 
     value, marginals, edge_marginals, solver_status = factor_graph.solve(
         eta=eta,
@@ -186,14 +170,9 @@ def _general_graph_multitype(l_unaries, l_edges, l_edge_weights, verbose=1,
     a_variable_startindex_by_type = np.cumsum([0]+list(l_n_nodes))
 
     factor_graph = fg.PFactorGraph()
-    multi_variables = []
 
-    for n_states, unaries in zip(l_n_states, l_unaries):
-        for u in unaries:
-            new_variable = factor_graph.create_multi_variable(n_states)
-            for state, cost in enumerate(u):
-                new_variable.set_log_potential(state, cost)
-            multi_variables.append(new_variable)
+    for unaries in l_unaries:
+        factor_graph.create_multi_variables(unaries)
 
     i_typ_typ = 0
     for typ_i, n_states_i in enumerate(l_n_states):
@@ -205,11 +184,10 @@ def _general_graph_multitype(l_unaries, l_edges, l_edge_weights, verbose=1,
             edge_weights = l_edge_weights[i_typ_typ]
             i_typ_typ += 1
 
-            for i, e in enumerate(edges):
-                edge_variables = [multi_variables[var_start_i+e[0]],
-                                  multi_variables[var_start_j+e[1]]]
-                factor_graph.create_factor_dense(edge_variables,
-                                                 edge_weights[i].ravel())
+            if len(edges):
+                factor_graph.create_factors_dense(
+                    np.asarray(edges) + [var_start_i, var_start_j],
+                    edge_weights)
 
     value, marginals, edge_marginals, solver_status = factor_graph.solve(
         eta=eta,
@@ -1,4 +1,5 @@
 import numpy as np
+import pytest
 from ad3 import factor_graph as fg
 
 
@@ -20,3 +21,191 @@ def test_primal_dual_vars():
     assert len(g.get_dual_variables()) == 4
     assert len(g.get_local_primal_variables()) == 4
     assert len(g.get_global_primal_variables()) == 2
+
+
+def test_read(tmp_path):
+    filename = str(tmp_path / 'example.fg')
+    with open(filename, 'w') as f:
+        f.write("3\n2\n0.75\n1.25\n-0.5\nOR 3 1 2 3\nPAIR 2 1 2 -1.05\n")
+
+    g = fg.PFactorGraph()
+    g.read(filename)
+    val, post, _, status = g.solve()
+
+    h = fg.PFactorGraph()
+    variables = [h.create_binary_variable() for _ in range(3)]
+    for var, log_potential in zip(variables, [0.75, 1.25, -0.5]):
+        var.set_log_potential(log_potential)
+    h.create_factor_logic('OR', variables)
+    h.create_factor_pair(variables[:2], -1.05)
+    expected_val, expected_post, _, _ = h.solve()
+
+    assert status == 'integral'
+    assert abs(val - expected_val) < 1e-8
+    assert np.allclose(post, expected_post)
+
+
+def test_read_uai(tmp_path):
+    unary = np.array([1.0, 2.0])
+    table = np.array([0.5, 1.0, 2.0, 3.0, 0.25, 1.5])
+    filename = str(tmp_path / 'example.uai')
+    with open(filename, 'w') as f:
+        f.write("MARKOV\n2\n2 3\n2\n1 0\n2 0 1\n\n2\n")
+        f.write(" ".join(str(x) for x in unary) + "\n\n6\n")
+        f.write(" ".join(str(x) for x in table) + "\n")
+
+    g = fg.PFactorGraph()
+    g.read(filename, format='uai')
+    val, post, _, _ = g.solve()
+
+    h = fg.PFactorGraph()
+    a = h.create_multi_variable(2)
+    b = h.create_multi_variable(3)
+    a.set_log_potentials(np.log(unary))
+    b.set_log_potentials(np.zeros(3))
+    h.create_factor_dense([a, b], np.log(table))
+    expected_val, expected_post, _, _ = h.solve()
+
+    assert abs(val - expected_val) < 1e-8
+    assert np.allclose(post, expected_post)
+
+
+def test_read_errors(tmp_path):
+    g = fg.PFactorGraph()
+    with pytest.raises(IOError):
+        g.read(str(tmp_path / 'missing.fg'))
+    with pytest.raises(ValueError):
+        g.read(str(tmp_path / 'missing.fg'), format='xml')
+
+    # 2^32 + 3 does not fit in an int, and must not wrap around to 3.
+    filename = str(tmp_path / 'overflow.fg')
+    with open(filename, 'w') as f:
+        f.write("4294967299\n0\n0.75\n1.25\n-0.5\n")
+    with pytest.raises(ValueError):
+        g.read(filename)
+
+
+def test_write_binary(tmp_path):
+    rng = np.random.RandomState(0)
+    g = fg.PFactorGraph()
+    a = g.create_multi_variable(3)
+    b = g.create_multi_variable(2)
+    c = g.create_multi_variable(3)
+    for var in (a, b, c):
+        var.set_log_potentials(rng.randn(len(var)))
+    g.create_factor_dense([a, b], rng.randn(6))
+    g.create_factor_sparse([b, c], [(0, 1), (1, 2), (1, 0)], rng.randn(3))
+    x = g.create_binary_variable()
+    x.set_log_potential(0.5)
+    g.create_factor_logic('XOR', [x, a.get_state(0)], [True, False])
+    g.create_factor_budget([a.get_state(1), c.get_state(2), x], 1)
+    g.create_factor_knapsack([a.get_state(2), x], costs=[0.5, 0.75],
+                             budget=1.0)
+    val, post, add_post, _ = g.solve()
+
+    filename = str(tmp_path / 'graph.bin')
+    g.write(filename)
+    h = fg.PFactorGraph()
+    h.read(filename, format='binary')
+    h_val, h_post, h_add_post, _ = h.solve()
+    assert abs(val - h_val) < 1e-8
+    assert np.allclose(post, h_post)
+    assert np.allclose(add_post, h_add_post)
+
+    # Saving the state of AD3 lets a new run start from it.
+    g.write(filename, solver_state=True)
+    h = fg.PFactorGraph()
+    h.read(filename, format='binary')
+    h_val, h_post, _, _ = h.solve(max_iter=5, ensure_multi_variables=False)
+    assert abs(val - h_val) < 1e-6
+    assert np.allclose(post, h_post, atol=1e-4)
+
+
+def test_write_binary_unsupported(tmp_path):
+    from ad3.extensions import PFactorSequence
+
+    g = fg.PFactorGraph()
+    variables = [g.create_multi_variable(2) for _ in range(2)]
+    factor = PFactorSequence()
+    g.declare_factor(factor, [var.get_state(i) for var in variables
+                              for i in range(2)])
+    factor.initialize([2, 2])
+    with pytest.raises(ValueError):
+        g.write(str(tmp_path / 'graph.bin'))
+
+
+def test_create_factors_dense():
+    rng = np.random.RandomState(0)
+    unaries = rng.randn(5, 3)
+    edges = np.array([[0, 1], [1, 2], [2, 3], [3, 4], [0, 4]])
+    tables = rng.randn(5, 3, 3)
+
+    h = fg.PFactorGraph()
+    variables = [h.create_multi_variable(3) for _ in range(5)]
+    for var, unary in zip(variables, unaries):
+        var.set_log_potentials(unary)
+    for (i, j), table in zip(edges, tables):
+        h.create_factor_dense([variables[i], variables[j]], table.ravel())
+    expected = h.solve()
+
+    g = fg.PFactorGraph()
+    assert g.create_multi_variables(unaries) == 0
+    g.create_factors_dense(edges, tables)
+    val, post, additional_post, status = g.solve()
+
+    assert status == expected[3]
+    assert abs(val - expected[0]) < 1e-8
+    assert np.allclose(post, expected[1])
+    assert np.allclose(additional_post, expected[2])
+
+    # a single table, shared by all the factors
+    g = fg.PFactorGraph()
+    g.create_multi_variables(unaries)
+    g.create_factors_dense(edges, np.broadcast_to(tables[0], (5, 3, 3)))
+    expected_val = g.solve()[0]
+
+    g = fg.PFactorGraph()
+    g.create_multi_variables(unaries)
+    g.create_factors_dense(edges, tables[0])
+    assert abs(g.solve()[0] - expected_val) < 1e-8
+
+    with pytest.raises(ValueError):
+        g.create_factors_dense([[0, 5]], tables[0])
+    with pytest.raises(ValueError):
+        g.create_factors_dense(edges, tables[:4])
+    with pytest.raises(ValueError):
+        g.create_factors_dense(edges, np.zeros((3, 2)))
+
+
+def test_create_factors_binary():
+    log_potentials = [0.75, 1.25, -0.5, 0.25]
+
+    h = fg.PFactorGraph()
+    variables = [h.create_binary_variable() for _ in range(4)]
+    for var, log_potential in zip(variables, log_potentials):
+        var.set_log_potential(log_potential)
+    h.create_factor_logic('OR', variables[:3], [False, True, False])
+    h.create_factor_logic('OR', variables[1:], [True, False, False])
+    h.create_factor_pair(variables[:2], -1.05)
+    h.create_factor_pair(variables[2:], 0.5)
+    expected = h.solve()
+
+    g = fg.PFactorGraph()
+    assert g.create_binary_variables(log_potentials) == 0
+    g.create_factors_logic('OR', [[0, 1, 2], [1, 2, 3]],
+                           [[False, True, False], [True, False, False]])
+    g.create_factors_pair([[0, 1], [2, 3]], [-1.05, 0.5])
+    val, post, _, status = g.solve()
+
+    assert status == expected[3]
+    assert abs(val - expected[0]) < 1e-8
+    assert np.allclose(post, expected[1])
+
+    with pytest.raises(NotImplementedError):
+        g.create_factors_logic('NAND', [[0, 1]])
+    with pytest.raises(ValueError):
+        g.create_factors_logic('OR', [[0, 4]])
+    with pytest.raises(ValueError):
+        g.create_factors_logic('OR', [[0, 1]], [[True]])
+    with pytest.raises(ValueError):
+        g.create_factors_pair([[0, 1, 2]], 1.0)
@@ -28,3 +28,33 @@ def test_sequence_dense():
     expected = [0, 1, 1, 1, 1]
     obtained = np.array(marginals).reshape(5, -1).argmax(axis=1)
     assert_array_equal(expected, obtained)
+
+
+def test_sequence_frank_wolfe():
+    from ad3.extensions import PFactorSequence
+
+    n_states = 3
+    n_positions = 5
+    rng = np.random.RandomState(0)
+    unaries = rng.randn(n_positions, n_states)
+    transitions = rng.randn(2 * n_states + (n_positions - 1) * n_states ** 2)
+
+    results = []
+    for solver in ('active_set', 'frank_wolfe'):
+        graph = fg.PFactorGraph()
+        variables = [graph.create_multi_variable(n_states)
+                     for _ in range(n_positions)]
+        for var, unary in zip(variables, unaries):
+            var.set_log_potentials(unary)
+        factor = PFactorSequence()
+        factor.set_qp_solver(solver)
+        graph.declare_factor(factor, [var.get_state(i) for var in variables
+                                      for i in range(n_states)])
+        factor.initialize([n_states] * n_positions)
+        factor.set_additional_log_potentials(transitions)
+        value, marginals, _, _ = graph.solve_lp_map_ad3()
+        results.append((value, marginals))
+
+    assert np.abs(results[0][0] - results[1][0]) < 1e-6
+    assert np.abs(np.array(results[0][1]) -
+                  np.array(results[1][1])).max() < 1e-6
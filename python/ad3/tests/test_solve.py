@@ -33,3 +33,111 @@ def test_solve():
                                                         branch_and_bound=True)
     assert status_lowtol_bb == 'integral'
     assert (val_lowtol_bb - val) ** 2 < 1e-8
+
+
+def test_solve_exact_fixed_leaf():
+    # An odd cycle where each pair of variables must have exactly one of
+    # them on: at least one through an OR factor, at most one through a
+    # budget factor. Budget factors do not propagate evidence, so branching
+    # ends up with every variable fixed and a relaxation which is not
+    # integral; such nodes must be scored as leaves.
+    graph = fg.PFactorGraph()
+    variables = [graph.create_binary_variable() for _ in range(3)]
+    for k, var in enumerate(variables):
+        var.set_log_potential(0.1 * k)
+    for i, j in [(0, 1), (1, 2), (0, 2)]:
+        graph.create_factor_logic('OR', [variables[i], variables[j]])
+        graph.create_factor_budget([variables[i], variables[j]], 1)
+
+    _, _, _, status = graph.solve(branch_and_bound=True)
+    assert status == 'infeasible'
+
+
+def test_solve_mplp():
+    rng = np.random.RandomState(0)
+    graph = fg.PFactorGraph()
+
+    variables = [graph.create_multi_variable(3) for _ in range(5)]
+    for var in variables:
+        var.set_log_potentials(rng.randn(3))
+    for a, b in zip(variables[:-1], variables[1:]):
+        graph.create_factor_dense([a, b], rng.randn(3 * 3))
+
+    val, posteriors, additional_posteriors, status = graph.solve_lp_map_ad3()
+    assert status == 0
+
+    val_mplp, posteriors_mplp, additional_posteriors_mplp, status_mplp = \
+        graph.solve_lp_map_mplp()
+    assert status_mplp == 0
+    assert (val_mplp - val) ** 2 < 1e-8
+    assert np.allclose(posteriors_mplp, posteriors)
+    assert np.allclose(additional_posteriors_mplp, additional_posteriors)
+
+
+def test_solve_sparse():
+    rng = np.random.RandomState(0)
+    unaries = rng.randn(3, 4)
+    tables = rng.randn(3, 4 * 4)
+    allowed = rng.rand(3, 4 * 4) < 0.3
+    allowed[:, ::5] = True  # keep the diagonal, so the graph is feasible
+    edges = [(0, 1), (1, 2), (0, 2)]
+
+    results = []
+    for sparse in (False, True):
+        graph = fg.PFactorGraph()
+        variables = [graph.create_multi_variable(4) for _ in range(3)]
+        for var, unary in zip(variables, unaries):
+            var.set_log_potentials(unary)
+        for (i, j), table, mask in zip(edges, tables, allowed):
+            if sparse:
+                configurations = [(k // 4, k % 4) for k in np.flatnonzero(mask)]
+                graph.create_factor_sparse([variables[i], variables[j]],
+                                           configurations, table[mask])
+            else:
+                graph.create_factor_dense([variables[i], variables[j]],
+                                          np.where(mask, table, -1000))
+        results.append(graph.solve_lp_map_ad3())
+
+    (val, posteriors, _, _), (val_sparse, posteriors_sparse, _, _) = results
+    assert (val_sparse - val) ** 2 < 1e-8
+    assert np.allclose(posteriors_sparse, posteriors, atol=1e-6)
+
+
+def test_solve_exact_sparse():
+    # Hard sparse factors on a loopy graph: branch-and-bound must find the
+    # same assignment as brute force, propagating the fixed states through
+    # the allowed configurations.
+    rng = np.random.RandomState(9)
+    num_states = 3
+    unaries = rng.randn(4, num_states)
+    edges = [(0, 1), (1, 2), (2, 3), (0, 3), (0, 2)]
+    tables = rng.randn(len(edges), num_states * num_states)
+    allowed = rng.rand(len(edges), num_states * num_states) < 0.4
+    allowed[:, ::num_states + 1] = True  # keep the diagonal (feasible)
+
+    graph = fg.PFactorGraph()
+    variables = [graph.create_multi_variable(num_states) for _ in range(4)]
+    for var, unary in zip(variables, unaries):
+        var.set_log_potentials(unary)
+    for (i, j), table, mask in zip(edges, tables, allowed):
+        configurations = [(k // num_states, k % num_states)
+                          for k in np.flatnonzero(mask)]
+        graph.create_factor_sparse([variables[i], variables[j]],
+                                   configurations, table[mask])
+    val, posteriors, _, status = graph.solve(branch_and_bound=True)
+    assert status == 'integral'
+
+    best_val, best_states = None, None
+    for states in np.ndindex(*([num_states] * 4)):
+        score = sum(unaries[i, s] for i, s in enumerate(states))
+        for (i, j), table, mask in zip(edges, tables, allowed):
+            k = states[i] * num_states + states[j]
+            if not mask[k]:
+                break
+            score += table[k]
+        else:
+            if best_val is None or score > best_val:
+                best_val, best_states = score, states
+    assert (val - best_val) ** 2 < 1e-8
+    states = np.argmax(np.reshape(posteriors, (4, num_states)), axis=1)
+    assert tuple(states) == best_states
@@ -2,6 +2,7 @@ import sys
 from setuptools import setup
 from setuptools.command.bdist_egg import bdist_egg
 from setuptools.extension import Extension
+from Cython.Build import cythonize
 
 
 AD3_COMPILE_ARGS = [
@@ -10,9 +11,18 @@ AD3_COMPILE_ARGS = [
     '-c',
     '-fmessage-length=0'
 ]
+AD3_LINK_ARGS = []
+
+# Independent subproblems are solved in parallel with OpenMP, when the
+# compiler supports it.
+if sys.platform.startswith('linux'):
+    AD3_COMPILE_ARGS.append('-fopenmp')
+    AD3_LINK_ARGS.append('-fopenmp')
 
 libad3 = ('ad3', {
     'sources': ['ad3/FactorGraph.cpp',
+                'ad3/FactorGraphReader.cpp',
+                'ad3/FactorGraphWriter.cpp',
                 'ad3/GenericFactor.cpp',
                 'ad3/Factor.cpp',
                 'ad3/Utils.cpp',
@@ -60,18 +70,25 @@ setup(name='ad3',
       libraries=[libad3],
       cmdclass=cmdclass,
       include_package_data=True,
-      ext_modules=[
+      ext_modules=cythonize([
           Extension("ad3.factor_graph",
-                    ["python/ad3/factor_graph.cpp"],
+                    ["python/ad3/factor_graph.pyx"],
                     include_dirs=[".", "ad3"],
-                    language="c++"),
+                    language="c++",
+                    extra_link_args=AD3_LINK_ARGS),
           Extension("ad3.base",
-                    ["python/ad3/base.cpp"],
+                    ["python/ad3/base.pyx"],
                     include_dirs=[".", "ad3"],
-                    language="c++"),
+                    language="c++",
+                    extra_link_args=AD3_LINK_ARGS),
           Extension("ad3.extensions",
-                    ["python/ad3/extensions.cpp"],
+                    ["python/ad3/extensions.pyx"],
                     include_dirs=[".", "ad3"],
                     language="c++",
-                    extra_compile_args=AD3_COMPILE_ARGS),
-          ])
+                    extra_compile_args=AD3_COMPILE_ARGS,
+                    extra_link_args=AD3_LINK_ARGS),
+          ],
+          # The bindings are generated at build time, so that they always
+          # match the .pyx/.pxd sources.
+          include_path=["python/ad3"],
+          compiler_directives={'language_level': 2}))